@@ -92,6 +92,9 @@ void SWE::MySWESolver_ADERDG::eigenvalues(const double* const Q,const int d,doub
 
 	if(Q[0]<DG::epsilon){
 		eigs.h() = DG::epsilon;
+		eigs.hu() = 0.0;
+		eigs.hv() = 0.0;
+		eigs.b() = 0.0;
 	}
 	else{
 		eigs.h() = u_n + c;
@@ -101,6 +104,25 @@ void SWE::MySWESolver_ADERDG::eigenvalues(const double* const Q,const int d,doub
 	}
 }
 
+void SWE::MySWESolver_ADERDG::eigenvalues_vect(const double* const* const Q,const int d,double* const* const lambda,const int s) {
+	const double* const h   = Q[0];
+	const double* const hun = Q[d + 1];
+
+	#pragma omp simd
+	for (int i = 0; i < s; i++) {
+		const bool dry = h[i] < DG::epsilon;
+		// keep sqrt and division finite on dry nodes, their result is discarded
+		const double hi = dry ? DG::epsilon : h[i];
+		const double c = std::sqrt(DG::grav*hi);
+		const double u_n = hun[i] / hi;
+
+		lambda[0][i] = dry ? DG::epsilon : u_n + c;
+		lambda[1][i] = dry ? 0.0 : u_n - c;
+		lambda[2][i] = dry ? 0.0 : u_n;
+		lambda[3][i] = 0.0;
+	}
+}
+
 void SWE::MySWESolver_ADERDG::flux(const double* const Q,double** const F) {
 	// Dimensions                        = 2
 	// Number of variables + parameters  = 4 + 0
@@ -127,6 +149,29 @@ void SWE::MySWESolver_ADERDG::flux(const double* const Q,double** const F) {
 	g[3] = 0.0;
 }
 
+void SWE::MySWESolver_ADERDG::flux_vect(const double* const* const Q,double* const* const* const F,const int s) {
+	const double* const h  = Q[0];
+	const double* const hu = Q[1];
+	const double* const hv = Q[2];
+	double* const* const f = F[0];
+	double* const* const g = F[1];
+
+	#pragma omp simd
+	for (int i = 0; i < s; i++) {
+		const double ih = 1./h[i];
+
+		f[0][i] = hu[i];
+		f[1][i] = hu[i] * hu[i] * ih;
+		f[2][i] = hu[i] * hv[i] * ih;
+		f[3][i] = 0.0;
+
+		g[0][i] = hv[i];
+		g[1][i] = hu[i] * hv[i] * ih;
+		g[2][i] = hv[i] * hv[i] * ih;
+		g[3][i] = 0.0;
+	}
+}
+
 
 void  SWE::MySWESolver_ADERDG::nonConservativeProduct(const double* const Q,const double* const gradQ,double* const BgradQ) {
 	idx2 idx_gradQ(DIMENSIONS,NumberOfVariables);
@@ -137,6 +182,18 @@ void  SWE::MySWESolver_ADERDG::nonConservativeProduct(const double* const Q,cons
 	BgradQ[3] = 0.0;
 }
 
+void SWE::MySWESolver_ADERDG::nonConservativeProduct_vect(const double* const* const Q,const double* const* const* const gradQ,double* const* const BgradQ,const int s) {
+	const double* const h = Q[0];
+
+	#pragma omp simd
+	for (int i = 0; i < s; i++) {
+		BgradQ[0][i] = 0.0;
+		BgradQ[1][i] = DG::grav*h[i]*(gradQ[0][3][i] + gradQ[0][0][i]);
+		BgradQ[2][i] = DG::grav*h[i]*(gradQ[1][3][i] + gradQ[1][0][i]);
+		BgradQ[3][i] = 0.0;
+	}
+}
+
 
 bool SWE::MySWESolver_ADERDG::isPhysicallyAdmissible(
 		const double* const solution,
@@ -149,6 +206,21 @@ bool SWE::MySWESolver_ADERDG::isPhysicallyAdmissible(
 	return false;
 }
 
+bool SWE::MySWESolver_ADERDG::isInert(
+		const double* const luh,
+		const tarch::la::Vector<DIMENSIONS,double>& cellCentre,
+		const tarch::la::Vector<DIMENSIONS,double>& cellSize) {
+	constexpr int numberOfData = NumberOfVariables+NumberOfParameters;
+	constexpr int basisSize    = Order+1;
+
+	for (int node = 0; node < basisSize*basisSize; node++) {
+		if ( luh[node*numberOfData] >= DG::epsilon ) {
+			return false;
+		}
+	}
+	return true;
+}
+
 
 void SWE::MySWESolver_ADERDG::riemannSolver(double* const FL,double* const FR,const double* const QL,const double* const QR,const double* gradQL, const double* gradQR, const double dt,const int direction,bool isBoundaryFace, int faceIndex) {
 	constexpr int numberOfVariables  = NumberOfVariables;
@@ -149,8 +149,23 @@ class SWE::MySWESolver_ADERDG : public SWE::AbstractMySWESolver_ADERDG {
      **/
     bool isPhysicallyAdmissible(const double* const solution,const double* const observablesMin,const double* const observablesMax,const bool wasTroubledInPreviousTimeStep,const tarch::la::Vector<DIMENSIONS,double>& center,	const tarch::la::Vector<DIMENSIONS,double>& dx,	const double t) const;
 
+    /**
+     * A cell is inert if it is dry at all nodes, i.e. h < epsilon.
+     */
+    bool isInert(const double* const luh,const tarch::la::Vector<DIMENSIONS,double>& cellCentre,const tarch::la::Vector<DIMENSIONS,double>& cellSize) final override;
+
     void nonConservativeProduct(const double* const Q,const double* const gradQ,double* const BgradQ) final override;
 
+    /**
+     * Batched (structure of arrays) versions of flux, nonConservativeProduct
+     * and eigenvalues for \p s nodes, used by the generic kernels when
+     * vectorise_terms is set: Q[data][node], F[dim][var][node],
+     * gradQ[dim][var][node], BgradQ[var][node], lambda[var][node].
+     */
+    void flux_vect(const double* const* const Q,double* const* const* const F,const int s);
+    void nonConservativeProduct_vect(const double* const* const Q,const double* const* const* const gradQ,double* const* const BgradQ,const int s);
+    void eigenvalues_vect(const double* const* const Q,const int d,double* const* const lambda,const int s);
+
     void riemannSolver(double* const FL,double* const FR,const double* const QL,const double* const QR,const double* gradQL, const double* gradQR, const double dt,const int direction,bool isBoundaryFace, int faceIndex);
     //void riemannSolver(double* const FL,double* const FR,const double* const QL,const double* const QR,const double* gradQL, const double* gradQR, const double t,const double dt,const int direction, bool isBoundaryFace, int faceIndex) ;
 /* pointSource() function not included, as requested in the specification file */
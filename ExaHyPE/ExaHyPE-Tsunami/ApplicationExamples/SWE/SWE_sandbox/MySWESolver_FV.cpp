@@ -3,6 +3,7 @@
 #include "InitialData.h"
 
 #include "kernels/KernelUtils.h"
+#include "kernels/finitevolumes/riemannsolvers/c/riemannsolvers.h"
 
 using namespace kernels;
 
@@ -12,6 +13,18 @@ double epsilon = 1.0e-2;
 double grav = 9.81*1.0e-3;
 InitialData* initialData;
 
+namespace {
+/**
+ * Desingularised 1/h (times h, as in u = hu * this): sqrt(2) h / sqrt(h^4 + max(h,eps)^4).
+ */
+inline double desingularisedInverseDepth(const double h) {
+  const double h2 = h * h;
+  const double hMax = std::max(h, epsilon);
+  const double hMax2 = hMax * hMax;
+  return std::sqrt(2.0) * h / std::sqrt(h2 * h2 + hMax2 * hMax2);
+}
+}
+
 
 void SWE::MySWESolver_FV::init(const std::vector<std::string>& cmdlineargs,const exahype::parser::ParserView& constants) {
        initialData = new InitialData(14,"data.yaml");
@@ -38,7 +51,7 @@ void SWE::MySWESolver_FV::eigenvalues(const double* const Q, const int dIndex, d
   Variables eigs(lambda);
 
   const double c = std::sqrt(grav * vars.h());
-  double u_n = Q[dIndex + 1] * vars.h() * std::sqrt(2)/std::sqrt(std::pow(vars.h(), 4) + std::pow(std::max(vars.h(), epsilon), 4));
+  double u_n = Q[dIndex + 1] * desingularisedInverseDepth(vars.h());
 
   eigs.h() = u_n + c;
   eigs.hu() = u_n - c;
@@ -95,8 +108,9 @@ void SWE::MySWESolver_FV::flux(const double* const Q,double** const F) {
   double* f = F[0];
   double* g = F[1];
 
-  double u_n = vars.hu() * vars.h() *std::sqrt(2)/std::sqrt(std::pow(vars.h(), 4) + std::pow(std::max(vars.h(), epsilon), 4));
-  double v_n = vars.hv() * vars.h() *std::sqrt(2)/std::sqrt(std::pow(vars.h(), 4) + std::pow(std::max(vars.h(), epsilon), 4));
+  const double ih = desingularisedInverseDepth(vars.h());
+  double u_n = vars.hu() * ih;
+  double v_n = vars.hv() * ih;
 
   f[0] = vars.h() * u_n;
   f[1] = vars.h() * u_n * u_n; // 0.5 * muq::grav * vars.h() * vars.h();
@@ -109,56 +123,36 @@ void SWE::MySWESolver_FV::flux(const double* const Q,double** const F) {
   g[3] = 0.0;
  
 }
-double SWE::MySWESolver_FV::riemannSolver(double* const fL, double* const fR, const double* const qL, const double* const qR, const double* QL, const double* QR, const double* cellSize, int direction){
-    double LL[NumberOfVariables] = {0.0};
-    double LR[NumberOfVariables] = {0.0};
+double SWE::MySWESolver_FV::getGravity() const {
+    return grav;
+}
 
-    eigenvalues(qL, direction, LL);
-    eigenvalues(qR, direction, LR);
+double SWE::MySWESolver_FV::getDryTolerance() const {
+    return epsilon;
+}
 
-    double smax = 0.0;
-    for (int i = 0; i < NumberOfVariables; i++) {
-        const double abs_sL_i = std::abs(LL[i]);
-        smax = std::max( abs_sL_i, smax );
-    }
-    for (int i = 0; i < NumberOfVariables; i++) {
-        const double abs_sR_i = std::abs(LR[i]);
-        smax = std::max( abs_sR_i, smax );
+bool SWE::MySWESolver_FV::isInert(const double* const luh,const tarch::la::Vector<DIMENSIONS,double>& cellCentre,const tarch::la::Vector<DIMENSIONS,double>& cellSize) {
+  constexpr int numberOfData = NumberOfVariables+NumberOfParameters;
+  constexpr int patchBegin   = GhostLayerWidth;
+  constexpr int patchEnd     = patchBegin+PatchSize;
+
+  idx3 idx_luh(PatchSize+2*GhostLayerWidth,PatchSize+2*GhostLayerWidth,numberOfData);
+  for (int j = patchBegin; j < patchEnd; j++) {
+    for (int k = patchBegin; k < patchEnd; k++) {
+      if ( luh[idx_luh(j,k,0)] >= epsilon ) {
+        return false;
+      }
     }
+  }
+  return true;
+}
 
-    double FL2[DIMENSIONS][NumberOfVariables] = {0.0};
-    double FR2[DIMENSIONS][NumberOfVariables] = {0.0};
-    double* FL[DIMENSIONS]={FL2[0], FL2[1]};
-    double* FR[DIMENSIONS]={FR2[0], FR2[1]};
-    flux(qL, FL);
-    flux(qR, FR);
-
-    double flux[NumberOfVariables] = {0.0};
-
-    flux[0] = 0.5 * (FL[direction][0] + FR[direction][0]) - 0.5 * smax * (qR[0] + qR[3] - qL[0] - qL[3]);
-    flux[1] = 0.5 * (FL[direction][1] + FR[direction][1]) - 0.5 * smax * (qR[1] - qL[1]);
-    flux[2] = 0.5 * (FL[direction][2] + FR[direction][2]) - 0.5 * smax * (qR[2] - qL[2]);
-    flux[3] = 0.0;
-
-    if (FL[direction][3] != 0.0 || FR[direction][3] != 0.0)
-	    std::cout << FL[direction][3] << ", " <<  FR[direction][3] << std::endl;
-
-    double hRoe = 0.5*(qL[0] + qR[0]);
-
-    double bm = std::max(qL[3], qR[3]);
-    double Delta = std::max(qR[0]+qR[3] - bm, 0.0) - std::max(qL[0]+qL[3] - bm, 0.0);
-
-    double djump[NumberOfVariables] = {0.0};
-
-    djump[direction + 1] = 0.5*grav*hRoe*Delta;
-
-    flux[0] = 0.5 * (FL[direction][0] + FR[direction][0]) - 0.5*smax*Delta;
-    for (int i = 0; i < NumberOfVariables; i++){
-        fL[i] = flux[i] + djump[i];
-        fR[i] = flux[i] - djump[i];
-    }
+double SWE::MySWESolver_FV::riemannSolver(double* const fL, double* const fR, const double* const qL, const double* const qR, const double* QL, const double* QR, const double* cellSize, int direction){
+    return kernels::finitevolumes::riemannsolvers::c::hydrostaticRusanov(*this, fL, fR, qL, qR, direction);
+}
 
-    return smax;
+double SWE::MySWESolver_FV::riemannSolver_vect(double* const* const fL, double* const* const fR, const double* const* const qL, const double* const* const qR, const double* const cellSize, const int direction, const int s){
+    return kernels::finitevolumes::riemannsolvers::c::hydrostaticRusanov_vect(*this, fL, fR, qL, qR, direction, s);
 }
 
 void SWE::MySWESolver_FV::nonConservativeProduct(const double* const Q,const double* const gradQ,double* const BgradQ) {
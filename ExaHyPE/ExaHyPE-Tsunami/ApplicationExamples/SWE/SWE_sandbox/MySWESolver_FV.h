@@ -85,9 +85,33 @@ class SWE::MySWESolver_FV : public SWE::AbstractMySWESolver_FV {
      */
     void flux(const double* const Q,double** const F) override;
 
+    /**
+     * Gravitational acceleration and dry tolerance, used by the
+     * hydrostatic reconstruction Riemann solver of the swe scheme.
+     */
+    double getGravity() const;
+    double getDryTolerance() const;
+
+    /**
+     * Rusanov flux with hydrostatic reconstruction, see
+     * kernels::finitevolumes::riemannsolvers::c::hydrostaticRusanov.
+     * Used by the godunov scheme; the swe scheme calls the kernel directly.
+     */
     double riemannSolver(double* const fL, double* const fR, const double* const qL, const double* const qR, const double* QL, const double* QR, const double* cellSize, int direction) override;
+
+    /**
+     * riemannSolver for a row of \p s faces in structure of arrays form
+     * (qL[data][face], fL[var][face]), used by the godunov scheme when
+     * vectorise_terms is set. Returns the largest wave speed of the row.
+     */
+    double riemannSolver_vect(double* const* const fL, double* const* const fR, const double* const* const qL, const double* const* const qR, const double* const cellSize, const int direction, const int s);
     void nonConservativeProduct(const double* const Q,const double* const gradQ,double* const BgradQ) override;
 
+    /**
+     * A patch is inert if all its interior cells are dry, i.e. h < epsilon.
+     */
+    bool isInert(const double* const luh,const tarch::la::Vector<DIMENSIONS,double>& cellCentre,const tarch::la::Vector<DIMENSIONS,double>& cellSize) final override;
+
     /* algebraicSource() function not included, as requested by the specification file */
 
     /* nonConservativeProduct() function is not included, as requested in the specification file */
@@ -23,6 +23,7 @@
 #include "exahype/parser/Parser.h"
 #include "exahype/Vertex.h"
 #include "exahype/runners/Runner.h"
+#include "exahype/tests/Benchmarks.h"
 
 #include "kernels/KernelCalls.h"
 
@@ -55,6 +56,7 @@ int exahype::main(int argc, char** argv) {
   bool showHelp    = firstarg == "-h" || firstarg == "--help";
   bool showVersion = firstarg == "-v" || firstarg == "--version";
   bool runTests    = firstarg == "-t" || firstarg == "--tests";
+  bool runBenchmarks = firstarg == "-b" || firstarg == "--benchmarks";
   bool runPingPong = firstarg == "-p" || firstarg == "--pingpong";
   bool showCompiledSpecfile = firstarg == "--show-specfile";
   bool runCompiledSpecfile  = firstarg == "--built-in-specfile";
@@ -146,6 +148,22 @@ int exahype::main(int argc, char** argv) {
     }
   }
 
+  if (runBenchmarks) {
+    //
+    //   Run kernel micro-benchmarks
+    // ===============================
+    // Timing loops are kept out of the unit tests so that --tests stays fast.
+    //
+    if (exahype::tests::runBenchmarks() != 0) {
+      logError("main()", "benchmarked kernels failed their sanity checks. Quit.");
+      return -2;
+    }
+    else {
+      logInfo("main()", "all benchmarks completed.");
+      return EXIT_SUCCESS;
+    }
+  }
+
   //
   //   Parse specification file
   // =====================================
@@ -259,7 +277,7 @@ int exahype::main(int argc, char** argv) {
 #endif
 
 void exahype::help(const std::string& programname) {
-  std::cout << "Usage: " << programname << " [-hvt] <YourApplication.exahype>\n";
+  std::cout << "Usage: " << programname << " [-hvtb] <YourApplication.exahype>\n";
   std::cout << "\n";
   std::cout << "   where YourApplication.exahype is an ExaHyPE specification file.\n";
   std::cout << "   Note that you should have compiled ExaHyPE with this file as there\n";
@@ -270,6 +288,7 @@ void exahype::help(const std::string& programname) {
   std::cout << "    --help     | -h      Show this help message\n";
   std::cout << "    --version  | -v      Show version and other hard coded information\n";
   std::cout << "    --tests    | -t      Run the unit tests\n";
+  std::cout << "    --benchmarks | -b    Run the kernel micro-benchmarks\n";
   std::cout << "    --pingpong | -p      Run only a simple MPI Ping Pong test\n";
   std::cout << "    --show-specfile      Show the specification file the binary was built with\n";
   std::cout << "    --built-in-specfile  Run with the spec. file the binary was built with\n";
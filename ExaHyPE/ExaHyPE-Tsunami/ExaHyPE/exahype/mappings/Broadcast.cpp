@@ -23,6 +23,9 @@
 
 #include "exahype/mappings/RefinementStatusSpreading.h"
 
+exahype::mappings::Broadcast::CellSnapshotOperation exahype::mappings::Broadcast::CellSnapshot =
+    exahype::mappings::Broadcast::CellSnapshotOperation::None;
+
 peano::CommunicationSpecification exahype::mappings::Broadcast::communicationSpecification() const {
   return peano::CommunicationSpecification(
         peano::CommunicationSpecification::ExchangeMasterWorkerData::MaskOutMasterWorkerDataAndStateExchange,
@@ -32,7 +35,8 @@ peano::CommunicationSpecification exahype::mappings::Broadcast::communicationSpe
 peano::MappingSpecification
 exahype::mappings::Broadcast::enterCellSpecification(int level) const {
   return peano::MappingSpecification(
-      peano::MappingSpecification::Nop,
+      CellSnapshot==CellSnapshotOperation::None ?
+          peano::MappingSpecification::Nop : peano::MappingSpecification::WholeTree,
       peano::MappingSpecification::Serial,false);
 }
 
@@ -320,7 +324,21 @@ void exahype::mappings::Broadcast::enterCell(
     const peano::grid::VertexEnumerator& coarseGridVerticesEnumerator,
     exahype::Cell& coarseGridCell,
     const tarch::la::Vector<DIMENSIONS, int>& fineGridPositionOfCell) {
-  // do nothing
+  if (
+      CellSnapshot!=CellSnapshotOperation::None &&
+      fineGridCell.isInitialised()
+  ) {
+    solvers::Solver::CellInfo cellInfo = fineGridCell.createCellInfo();
+
+    for (unsigned int solverNumber=0; solverNumber < exahype::solvers::RegisteredSolvers.size(); solverNumber++) {
+      auto* solver = exahype::solvers::RegisteredSolvers[solverNumber];
+      if ( CellSnapshot==CellSnapshotOperation::Store ) {
+        solver->storeSnapshot(solverNumber,cellInfo);
+      } else {
+        solver->restoreFromSnapshot(solverNumber,cellInfo);
+      }
+    }
+  }
 }
 
 void exahype::mappings::Broadcast::leaveCell(
@@ -48,15 +48,33 @@ class exahype::mappings::Broadcast {
 
 public:
 
+  /**
+   * Operation performed by enterCell(...) on the cells of all registered solvers.
+   */
+  enum class CellSnapshotOperation { None, Store, Restore };
+
+  /**
+   * Set by exahype::runners::Runner::runCompressionBenchmark(...) to store or
+   * restore the solvers' snapshots (Solver::storeSnapshot(...),
+   * Solver::restoreFromSnapshot(...)) in the next iteration.
+   *
+   * \note Must be initialised with None!
+   */
+  static CellSnapshotOperation CellSnapshot;
+
   /**
    * We perform a reduction to synchronise the ranks.
    */
   peano::CommunicationSpecification communicationSpecification() const;
 
   /**
-   * Nop.
+   * Nop if CellSnapshot is None. Otherwise, serial traversal of the whole tree.
    */
   peano::MappingSpecification enterCellSpecification(int level) const;
+
+  /**
+   * Nop.
+   */
   peano::MappingSpecification touchVertexFirstTimeSpecification(int level) const;
   peano::MappingSpecification touchVertexLastTimeSpecification(int level) const;
   peano::MappingSpecification leaveCellSpecification(int level) const;
@@ -319,7 +337,8 @@ public:
       const tarch::la::Vector<DIMENSIONS, int>& fineGridPositionOfVertex);
 
   /**
-   * Nop.
+   * Stores or restores the snapshots of the cell descriptions of all
+   * registered solvers if CellSnapshot is not None.
    */
   void enterCell(
       exahype::Cell& fineGridCell, exahype::Vertex* const fineGridVertices,
@@ -40,6 +40,11 @@ class Plot;
  *
  * We run through all the cells and evaluate per cell whether this plotter
  * setup is hot. See the plotters' plotDataFromSolver().
+ *
+ * @note This mapping is not part of any adapter. The time stepping does not
+ * require an extra traversal for plotting: The patches are plotted by the
+ * Prediction mapping (separate algorithmic steps) and by the FusedTimeStep
+ * mapping right before the cell's solution is read by the predictor anyway.
  */
 class exahype::mappings::Plot {
  private:
@@ -204,6 +204,9 @@ exahype::parser::Parser::Parser() {
   _identifier2TimeStepping.insert(
       std::pair<std::string, exahype::solvers::Solver::TimeStepping>(
           "globalfixed", exahype::solvers::Solver::TimeStepping::GlobalFixed));
+  _identifier2TimeStepping.insert(
+      std::pair<std::string, exahype::solvers::Solver::TimeStepping>(
+          "local", exahype::solvers::Solver::TimeStepping::Local));
 }
 
 exahype::parser::Parser::~Parser() {
@@ -743,6 +746,20 @@ double exahype::parser::Parser::getFuseAlgorithmicStepsDiffusionFactor() const {
   return result;
 }
 
+int exahype::parser::Parser::getLocalTimeSteppingLevels() const {
+  const int default_value = 2;
+  int result = getIntFromPath("/optimisation/local_time_stepping_levels", default_value, isOptional);
+  logDebug("getLocalTimeSteppingLevels()", "found local_time_stepping_levels " << result);
+  if(result < 1 || result > 16) {
+    logError("getLocalTimeSteppingLevels()",
+              "'local_time_stepping_levels': Value must be greater than zero "
+              "and smaller than or equal to 16. It is: "
+                  << result);
+    invalidate();
+  }
+  return result;
+}
+
 bool exahype::parser::Parser::getSpawnPredictionAsBackgroundThread() const {
   return getBoolFromPath("/optimisation/spawn_predictor_as_background_thread", true, isOptional);
 }
@@ -1108,6 +1125,10 @@ std::string exahype::parser::Parser::getProfilerIdentifier() const {
   return getStringFromPath("/profiling/profiler", "NoOpProfiler", isOptional);
 }
 
+std::string exahype::parser::Parser::getProfilingOutputFilename() const {
+  return getStringFromPath("/profiling/profiling_output", "", isOptional);
+}
+
 
 bool exahype::parser::Parser::getProfileEmptyAdapter() const {
   std::string option = getStringFromPath("/profiling/profiling_target", "whole_code", isOptional);
@@ -1184,6 +1205,30 @@ int exahype::parser::Parser::getMeasureCellProcessingTimesIterations() const {
   return result;
 }
 
+std::vector<double> exahype::parser::Parser::getCompressionBenchmarkThresholds() const {
+  std::vector<double> result;
+  const std::string path = "/profiling/compression_benchmark";
+  while ( hasPath(path+"/"+std::to_string(result.size())) ) {
+    const double threshold = getDoubleFromPath(path+"/"+std::to_string(result.size()));
+    if ( threshold < 0.0 ) {
+      logError("getCompressionBenchmarkThresholds(...)","'compression_benchmark' thresholds must not be negative.");
+      invalidate();
+    }
+    result.push_back(threshold);
+  }
+  return result;
+}
+
+int exahype::parser::Parser::getCompressionBenchmarkTimeSteps() const {
+  const int result = getIntFromPath("/profiling/compression_benchmark_time_steps", 10, isOptional);
+
+  if ( result <  1 ) {
+    logError("getCompressionBenchmarkTimeSteps(...)","'compression_benchmark_time_steps' must be greater than 0.");
+    invalidate();
+  }
+  return result;
+}
+
 std::string exahype::parser::Parser::getMetricsIdentifierList() const {
   return getStringFromPath("/profiling/metrics", "{}", isOptional);
 }
@@ -1316,6 +1361,20 @@ int exahype::parser::Parser::getMinBackgroundJobsInARush() {
   return getIntFromPath("/shared_memory/min_background_jobs_in_one_rush",1,isOptional);
 }
 
+bool exahype::parser::Parser::getCostAwareJobScheduling() const {
+  return getBoolFromPath("/shared_memory/cost_aware_job_scheduling",false,isOptional);
+}
+
+double exahype::parser::Parser::getJobGrainTime() const {
+  const double result = getDoubleFromPath("/shared_memory/job_grain_time",2e-4,isOptional);
+
+  if ( result < 0.0 ) {
+    logError("getJobGrainTime(...)","'job_grain_time' must not be negative.");
+    invalidate();
+  }
+  return result;
+}
+
 bool exahype::parser::Parser::useManualPinning() {
   return getBoolFromPath("/shared_memory/manual_pinning",false,isOptional);
 }
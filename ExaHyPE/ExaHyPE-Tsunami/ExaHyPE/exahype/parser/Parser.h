@@ -381,6 +381,14 @@ class exahype::parser::Parser {
    */
   double getFuseAlgorithmicStepsDiffusionFactor() const;
 
+  /**
+   * @return The maximum level k of the local time stepping, i.e. cells
+   * may advance with up to 2^k times the solver's time step size.
+   *
+   * @note is only used if a solver uses the 'local' time stepping.
+   */
+  int getLocalTimeSteppingLevels() const;
+
   /**
    * @return if the predictor and the first and intermediate fused time steps should be
    * spawned as background thread.
@@ -641,6 +649,19 @@ class exahype::parser::Parser {
    */
   int getMeasureCellProcessingTimesIterations() const;
 
+  /**
+   * @return the heap data compression thresholds ("double_compression") the
+   * compression benchmark should run, or an empty vector if no benchmark is requested.
+   */
+  std::vector<double> getCompressionBenchmarkThresholds() const;
+
+  /**
+   * @return number of time steps to run per compression benchmark threshold.
+   *
+   * @see getCompressionBenchmarkThresholds()
+   */
+  int getCompressionBenchmarkTimeSteps() const;
+
   /**
    * @TODO This function should be renamed to createParserViewForSolver, as we also
    * now also create ParserViews for plotters.
@@ -684,6 +705,17 @@ class exahype::parser::Parser {
    */
   int getMaxBackgroundJobsInARush();
 
+  /**
+   * @return if the solvers should batch cheap jobs and raise the priority of expensive ones
+   * based on the measured cell processing times (default: false).
+   */
+  bool getCostAwareJobScheduling() const;
+
+  /**
+   * @return the estimated time (sec) a job should take at least if the cost-aware job scheduling is used (default: 2e-4).
+   */
+  double getJobGrainTime() const;
+
   bool useManualPinning();
 
   /**
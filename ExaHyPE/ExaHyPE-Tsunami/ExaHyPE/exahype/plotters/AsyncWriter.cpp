@@ -0,0 +1,108 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "AsyncWriter.h"
+
+#include <chrono>
+#include <cstdlib>
+
+tarch::logging::Log exahype::plotters::AsyncWriter::_log("exahype::plotters::AsyncWriter");
+
+exahype::plotters::AsyncWriter::AsyncWriter(int maxQueueLength)
+  : _maxQueueLength(maxQueueLength > 0 ? maxQueueLength : 0),
+    _hasFailed(false) {
+  if (isAsynchronous()) {
+    _thread = std::thread(&AsyncWriter::run, this);
+  }
+}
+
+exahype::plotters::AsyncWriter::~AsyncWriter() {
+  if (isAsynchronous()) {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _terminate = true;
+    }
+    _jobSubmitted.notify_one();
+    _thread.join();
+  }
+}
+
+bool exahype::plotters::AsyncWriter::isAsynchronous() const {
+  return _maxQueueLength > 0;
+}
+
+void exahype::plotters::AsyncWriter::reportFailure(const std::string& message) {
+  logError("reportFailure(...)", message);
+  _hasFailed = true;
+}
+
+bool exahype::plotters::AsyncWriter::hasFailed() const {
+  return _hasFailed;
+}
+
+void exahype::plotters::AsyncWriter::exitIfAJobHasFailed() {
+  if (hasFailed()) {
+    logError("exitIfAJobHasFailed()", "a plot job has failed (see above)");
+    exit(-1);
+  }
+}
+
+void exahype::plotters::AsyncWriter::submit(Job&& job) {
+  exitIfAJobHasFailed();
+  if (!isAsynchronous()) {
+    job();
+    exitIfAJobHasFailed();
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (static_cast<int>(_queue.size()) >= _maxQueueLength) {
+    const auto waitingSince = std::chrono::steady_clock::now();
+    _jobFinished.wait(lock, [this] { return static_cast<int>(_queue.size()) < _maxQueueLength; });
+    logInfo("submit(...)", "waited " <<
+        std::chrono::duration<double>(std::chrono::steady_clock::now()-waitingSince).count() <<
+        "s for the plot writer; the file system cannot keep up with the plotting interval");
+  }
+  _queue.push_back(std::move(job));
+  lock.unlock();
+  _jobSubmitted.notify_one();
+}
+
+void exahype::plotters::AsyncWriter::waitUntilAllJobsHaveBeenProcessed() {
+  if (isAsynchronous()) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _jobFinished.wait(lock, [this] { return _queue.empty() && !_isWriting; });
+  }
+  exitIfAJobHasFailed();
+}
+
+void exahype::plotters::AsyncWriter::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _jobSubmitted.wait(lock, [this] { return _terminate || !_queue.empty(); });
+    if (_queue.empty()) { // terminate and all jobs done
+      break;
+    }
+
+    Job job = std::move(_queue.front());
+    _queue.pop_front();
+    _isWriting = true;
+    lock.unlock();
+
+    job();
+
+    lock.lock();
+    _isWriting = false;
+    _jobFinished.notify_all();
+  }
+}
@@ -0,0 +1,123 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_PLOTTERS_ASYNC_WRITER_H_
+#define _EXAHYPE_PLOTTERS_ASYNC_WRITER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "tarch/logging/Log.h"
+
+namespace exahype {
+  namespace plotters {
+    class AsyncWriter;
+  }
+}
+
+/**
+ * Background writer for plotter output.
+ *
+ * A plotter snapshots the data it wants to write into a job which
+ * owns all its data and submits it here. The jobs are run one after the
+ * other, in the order of their submission, by a dedicated thread. This thread
+ * is not part of the shared memory runtime, so the file I/O overlaps with the
+ * time stepping instead of competing for the workers.
+ *
+ * The queue is bounded: submit(...) blocks while the given number of jobs
+ * are waiting, i.e. the simulation is throttled to the speed of the file
+ * system instead of piling up snapshots in memory.
+ *
+ * A queue length of zero disables the thread; jobs are then run
+ * directly by submit(...).
+ *
+ * Jobs must not terminate the program as they might run on the writer
+ * thread. A job signals an error via reportFailure(...) instead; the
+ * error is then raised on the calling thread by the next submit(...) or
+ * waitUntilAllJobsHaveBeenProcessed().
+ */
+class exahype::plotters::AsyncWriter {
+  public:
+    typedef std::function<void()> Job;
+
+  private:
+    static tarch::logging::Log _log;
+
+    const int               _maxQueueLength;
+
+    std::mutex              _mutex;
+    std::condition_variable _jobSubmitted;
+    std::condition_variable _jobFinished;
+    std::deque<Job>         _queue;
+    bool                    _isWriting   = false;
+    bool                    _terminate   = false;
+
+    std::atomic<bool>       _hasFailed;
+
+    std::thread             _thread;
+
+    void run();
+
+    /**
+     * Logs an error and exits if a job has reported a failure.
+     */
+    void exitIfAJobHasFailed();
+
+  public:
+    /**
+     * @param maxQueueLength number of snapshots which may wait for
+     *                       the writer thread.
+     */
+    explicit AsyncWriter(int maxQueueLength);
+
+    /**
+     * Flushes all pending jobs.
+     */
+    ~AsyncWriter();
+
+    AsyncWriter(const AsyncWriter& other) = delete;
+    AsyncWriter& operator=(const AsyncWriter& other) = delete;
+
+    /**
+     * Enqueue a job. Blocks as long as the queue is full.
+     * Exits if a previously submitted job has reported a failure.
+     */
+    void submit(Job&& job);
+
+    /**
+     * Block until all submitted jobs have been processed.
+     * Exits if one of the jobs has reported a failure.
+     */
+    void waitUntilAllJobsHaveBeenProcessed();
+
+    /**
+     * Called by a job if it failed to write its data. Logs the error.
+     * Thread-safe.
+     */
+    void reportFailure(const std::string& message);
+
+    /**
+     * @return if a job has reported a failure, i.e. if the next submit(...)
+     *         or waitUntilAllJobsHaveBeenProcessed() exits.
+     */
+    bool hasFailed() const;
+
+    bool isAsynchronous() const;
+};
+
+#endif
@@ -0,0 +1,345 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/plotters/LimitingADERDG2Reductions.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include "tarch/multicore/Lock.h"
+#include "tarch/parallel/Node.h"
+
+#include "peano/utils/Loop.h"
+
+#include "kernels/GaussLegendreBasis.h"
+
+#include "exahype/solvers/LimitingADERDGSolver.h"
+
+tarch::logging::Log exahype::plotters::LimitingADERDG2Reductions::_log("exahype::plotters::LimitingADERDG2Reductions");
+
+std::string exahype::plotters::LimitingADERDG2Reductions::getIdentifier() {
+  return "reductions::binary";
+}
+
+exahype::plotters::LimitingADERDG2Reductions::LimitingADERDG2Reductions(
+    exahype::plotters::Plotter::UserOnTheFlyPostProcessing* postProcessing,
+    const int ghostLayerWidth):
+  Device(postProcessing),
+  _ghostLayerWidth(ghostLayerWidth) {
+}
+
+exahype::plotters::LimitingADERDG2Reductions::~LimitingADERDG2Reductions() {
+  if (_out.is_open()) {
+    _out.close();
+  }
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::init(
+    const std::string& filename,
+    int orderPlusOne,
+    int unknowns,
+    int writtenUnknowns,
+    exahype::parser::ParserView plotterParameters) {
+  _filename        = filename;
+  _order           = orderPlusOne-1;
+  _solverUnknowns  = unknowns;
+  _writtenUnknowns = writtenUnknowns;
+
+  _plotPatchesConcurrently = false;
+  if (plotterParameters.hasKey("concurrent")) {
+    _plotPatchesConcurrently = plotterParameters.getValueAsBoolOrDefault("concurrent",false);
+  }
+
+  for (int t=0; plotterParameters.hasKey("transects/"+std::to_string(t)); t++) {
+    const std::string prefix = "transects/"+std::to_string(t);
+    Transect transect;
+    for (int d=0; d<DIMENSIONS; d++) {
+      const std::string coordinate = "/"+std::to_string(d);
+      if (
+          !plotterParameters.isValueValidDouble(prefix+"/from"+coordinate) ||
+          !plotterParameters.isValueValidDouble(prefix+"/to"+coordinate)
+      ) {
+        logError("init(...)", "transect " << t << " requires " << DIMENSIONS << " coordinates for 'from' and 'to'. Have " << plotterParameters.dump());
+        std::abort();
+      }
+      transect.from(d) = plotterParameters.getValueAsDouble(prefix+"/from"+coordinate);
+      transect.to(d)   = plotterParameters.getValueAsDouble(prefix+"/to"+coordinate);
+    }
+    transect.samples = plotterParameters.getValueAsIntOrDefault(prefix+"/samples",100);
+    if (transect.samples < 1) {
+      logError("init(...)", "transect " << t << " requires a positive number of samples. Have " << transect.samples);
+      std::abort();
+    }
+    addTransect(transect);
+  }
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::addTransect(const Transect& transect) {
+  for (int sample=0; sample<transect.samples; sample++) {
+    const double s = (transect.samples > 1) ? static_cast<double>(sample)/(transect.samples-1) : 0.0;
+    _samplePoints.push_back(transect.from + s * (transect.to - transect.from));
+  }
+  _transects.push_back(transect);
+  _samples.resize(_samplePoints.size() * _writtenUnknowns);
+  logInfo("addTransect(...)", "sample along transect from " << transect.from << " to " << transect.to << " at " << transect.samples << " points");
+}
+
+bool exahype::plotters::LimitingADERDG2Reductions::canPlotPatchesConcurrently() const {
+  return _plotPatchesConcurrently;
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::resetPartialReductions(PartialReductions& reductions) const {
+  reductions.min.assign(_writtenUnknowns, std::numeric_limits<double>::infinity());
+  reductions.max.assign(_writtenUnknowns, -std::numeric_limits<double>::infinity());
+  reductions.squares.assign(_writtenUnknowns, 0.0);
+  reductions.volume = 0.0;
+}
+
+exahype::plotters::LimitingADERDG2Reductions::PartialReductions&
+exahype::plotters::LimitingADERDG2Reductions::getPartialReductions() {
+  tarch::multicore::Lock lock(_partialReductionsSemaphore);
+  PartialReductions& reductions = _partialReductions[std::this_thread::get_id()];
+  lock.free();
+
+  if ( reductions.interpoland.empty() ) { // first use by this thread
+    reductions.interpoland.resize(_solverUnknowns);
+    reductions.value.resize(_writtenUnknowns);
+    resetPartialReductions(reductions);
+  }
+  return reductions;
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::writeSample(const int sample,const double* value) {
+  tarch::multicore::Lock lock(_partialReductionsSemaphore);
+  std::copy_n(value, _writtenUnknowns, _samples.data() + sample*_writtenUnknowns);
+  lock.free();
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::addValue(
+    PartialReductions& reductions,
+    const double* value,
+    const double weight) const {
+  for (int i=0; i<_writtenUnknowns; i++) {
+    reductions.min[i]      = std::min(reductions.min[i],value[i]);
+    reductions.max[i]      = std::max(reductions.max[i],value[i]);
+    reductions.squares[i] += weight * value[i] * value[i];
+  }
+  reductions.volume += weight;
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::startPlotting( double time ) {
+  _postProcessing->startPlotting( time );
+
+  // In the very first time step, the time stamp is infinity
+  _time = (time==std::numeric_limits<double>::infinity()) ? 0.0 : time;
+
+  tarch::multicore::Lock lock(_partialReductionsSemaphore);
+  for (auto& entry : _partialReductions) {
+    resetPartialReductions(entry.second);
+  }
+  std::fill(_samples.begin(), _samples.end(), std::numeric_limits<double>::quiet_NaN());
+  lock.free();
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::openOutputStream() {
+  if (!_out.is_open()) {
+    std::ostringstream outputFilename;
+    outputFilename << _filename
+                 #ifdef Parallel
+                 << "-rank-" << tarch::parallel::Node::getInstance().getRank()
+                 #endif
+                 << ".reductions";
+    _out.open( outputFilename.str(), std::ios::binary | std::ios::trunc );
+
+    if (!_out) {
+      logError("openOutputStream(...)", "Could not open file '" << outputFilename.str() << "': " << strerror(errno));
+      exit(-2);
+    }
+
+    const char magic[8] = {'E','X','A','R','E','D','0','1'};
+    const int32_t writtenUnknowns = _writtenUnknowns;
+    const int32_t dimensions      = DIMENSIONS;
+    const int32_t transects       = static_cast<int32_t>(_transects.size());
+    _out.write(magic, sizeof(magic));
+    _out.write(reinterpret_cast<const char*>(&writtenUnknowns), sizeof(int32_t));
+    _out.write(reinterpret_cast<const char*>(&dimensions),      sizeof(int32_t));
+    _out.write(reinterpret_cast<const char*>(&transects),       sizeof(int32_t));
+    for (const Transect& transect : _transects) {
+      const int32_t samples = transect.samples;
+      _out.write(reinterpret_cast<const char*>(transect.from.data()), DIMENSIONS*sizeof(double));
+      _out.write(reinterpret_cast<const char*>(transect.to.data()),   DIMENSIONS*sizeof(double));
+      _out.write(reinterpret_cast<const char*>(&samples), sizeof(int32_t));
+    }
+  }
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::finishPlotting() {
+  _postProcessing->finishPlotting();
+
+  PartialReductions reductions;
+  resetPartialReductions(reductions);
+  tarch::multicore::Lock lock(_partialReductionsSemaphore);
+  for (const auto& entry : _partialReductions) {
+    for (int i=0; i<_writtenUnknowns; i++) {
+      reductions.min[i]      = std::min(reductions.min[i],entry.second.min[i]);
+      reductions.max[i]      = std::max(reductions.max[i],entry.second.max[i]);
+      reductions.squares[i] += entry.second.squares[i];
+    }
+    reductions.volume += entry.second.volume;
+  }
+  const std::vector<double> samples(_samples);
+  lock.free();
+
+  openOutputStream();
+
+  _out.write(reinterpret_cast<const char*>(&_time), sizeof(double));
+  _out.write(reinterpret_cast<const char*>(&reductions.volume), sizeof(double));
+  for (int i=0; i<_writtenUnknowns; i++) {
+    const double l2 = std::sqrt(reductions.squares[i]);
+    _out.write(reinterpret_cast<const char*>(&reductions.min[i]), sizeof(double));
+    _out.write(reinterpret_cast<const char*>(&reductions.max[i]), sizeof(double));
+    _out.write(reinterpret_cast<const char*>(&l2), sizeof(double));
+  }
+  _out.write(reinterpret_cast<const char*>(samples.data()), samples.size()*sizeof(double));
+  _out.flush();
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::plotPatch(const int solverNumber,solvers::Solver::CellInfo& cellInfo) {
+  auto* limitingADERDGSolver = static_cast<solvers::LimitingADERDGSolver*>( solvers::RegisteredSolvers[solverNumber] );
+  assertion(limitingADERDGSolver->getType()==solvers::Solver::Type::LimitingADERDG);
+
+  const int element = cellInfo.indexOfADERDGCellDescription(solverNumber);
+  auto& solverPatch = cellInfo._ADERDGCellDescriptions[element];
+
+  if ( solverPatch.getType()==exahype::solvers::ADERDGSolver::CellDescription::Type::Leaf ) {
+    PartialReductions& reductions = getPartialReductions();
+
+    // ignore limiter status on coarser mesh levels
+    const int refinementStatus =
+        (solverPatch.getLevel()<limitingADERDGSolver->getMaximumAdaptiveMeshLevel()) ?
+            0 : solverPatch.getRefinementStatus();
+
+    if ( refinementStatus < limitingADERDGSolver->getSolver()->getMinRefinementStatusForTroubledCell()-1 ) {
+      reduceADERDGPatch(
+          reductions,
+          solverPatch.getOffset(),solverPatch.getSize(),
+          static_cast<double*>(solverPatch.getSolution()),
+          solverPatch.getTimeStamp());
+    } else {
+      auto& limiterPatch = limitingADERDGSolver->getLimiterPatch(solverPatch,cellInfo);
+      reduceFiniteVolumesPatch(
+          reductions,
+          solverPatch.getOffset(),solverPatch.getSize(),
+          static_cast<double*>(limiterPatch.getSolution()),
+          limitingADERDGSolver->getLimiter()->getNodesPerCoordinateAxis(),
+          solverPatch.getTimeStamp());
+    }
+  }
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::reduceADERDGPatch(
+    PartialReductions& reductions,
+    const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
+    const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
+    const double* const u,
+    const double timeStamp) {
+  double* interpoland = reductions.interpoland.data();
+  double* value       = reductions.value.data();
+
+  // quadrature
+  dfor(i,_order+1) {
+    tarch::la::Vector<DIMENSIONS, double> x;
+    double weight = 1.0;
+    for (int d=0; d<DIMENSIONS; d++) {
+      x(d)    = offsetOfPatch(d) + kernels::legendre::nodes[_order][i(d)] * sizeOfPatch(d);
+      weight *= kernels::legendre::weights[_order][i(d)] * sizeOfPatch(d);
+    }
+    std::copy_n(u + peano::utils::dLinearisedWithoutLookup(i,_order+1)*_solverUnknowns, _solverUnknowns, interpoland);
+
+    _postProcessing->mapQuantities(offsetOfPatch,sizeOfPatch,x,i,interpoland,value,timeStamp);
+    addValue(reductions,value,weight);
+  }
+
+  // transects
+  for (unsigned int sample=0; sample<_samplePoints.size(); sample++) {
+    const tarch::la::Vector<DIMENSIONS, double>& x = _samplePoints[sample];
+    if (
+        tarch::la::allSmallerEquals(offsetOfPatch,x) &&
+        tarch::la::allGreater(offsetOfPatch+sizeOfPatch,x)
+    ) {
+      for (int unknown=0; unknown < _solverUnknowns; unknown++) {
+        interpoland[unknown] = kernels::legendre::interpolate(
+            offsetOfPatch.data(),sizeOfPatch.data(),x.data(),
+            _solverUnknowns,unknown,_order,u);
+      }
+      _postProcessing->mapQuantities(
+          offsetOfPatch,sizeOfPatch,x,tarch::la::Vector<DIMENSIONS, int>(0),
+          interpoland,value,timeStamp);
+      writeSample(sample,value);
+    }
+  }
+}
+
+void exahype::plotters::LimitingADERDG2Reductions::reduceFiniteVolumesPatch(
+    PartialReductions& reductions,
+    const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
+    const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
+    const double* const u,
+    const int numberOfCellsPerAxis,
+    const double timeStamp) {
+  double* sourceValue = reductions.interpoland.data();
+  double* value       = reductions.value.data();
+
+  const tarch::la::Vector<DIMENSIONS, double> cellSize = sizeOfPatch / static_cast<double>(numberOfCellsPerAxis);
+  double cellVolume = 1.0;
+  for (int d=0; d<DIMENSIONS; d++) {
+    cellVolume *= cellSize(d);
+  }
+
+  // !!! Be aware of the "2*_ghostLayerWidth" !!!
+  dfor(i,numberOfCellsPerAxis) {
+    const int cellIndex = peano::utils::dLinearisedWithoutLookup(i+_ghostLayerWidth,numberOfCellsPerAxis+2*_ghostLayerWidth);
+    std::copy_n(u + cellIndex*_solverUnknowns, _solverUnknowns, sourceValue);
+
+    tarch::la::Vector<DIMENSIONS, double> x;
+    for (int d=0; d<DIMENSIONS; d++) {
+      x(d) = offsetOfPatch(d) + (i(d)+0.5) * cellSize(d);
+    }
+    _postProcessing->mapQuantities(offsetOfPatch,sizeOfPatch,x,i,sourceValue,value,timeStamp);
+    addValue(reductions,value,cellVolume);
+  }
+
+  // transects
+  for (unsigned int sample=0; sample<_samplePoints.size(); sample++) {
+    const tarch::la::Vector<DIMENSIONS, double>& x = _samplePoints[sample];
+    if (
+        tarch::la::allSmallerEquals(offsetOfPatch,x) &&
+        tarch::la::allGreater(offsetOfPatch+sizeOfPatch,x)
+    ) {
+      tarch::la::Vector<DIMENSIONS, int> i;
+      for (int d=0; d<DIMENSIONS; d++) {
+        i(d) = std::min(numberOfCellsPerAxis-1,static_cast<int>((x(d)-offsetOfPatch(d))/cellSize(d)));
+      }
+      const int cellIndex = peano::utils::dLinearisedWithoutLookup(i+_ghostLayerWidth,numberOfCellsPerAxis+2*_ghostLayerWidth);
+      std::copy_n(u + cellIndex*_solverUnknowns, _solverUnknowns, sourceValue);
+
+      _postProcessing->mapQuantities(offsetOfPatch,sizeOfPatch,x,i,sourceValue,value,timeStamp);
+      writeSample(sample,value);
+    }
+  }
+}
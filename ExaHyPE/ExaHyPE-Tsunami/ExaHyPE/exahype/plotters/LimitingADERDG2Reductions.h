@@ -0,0 +1,171 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_PLOTTERS_LIMITING_ADERDG_2_REDUCTIONS_H_
+#define _EXAHYPE_PLOTTERS_LIMITING_ADERDG_2_REDUCTIONS_H_
+
+#include "exahype/plotters/Plotter.h"
+
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "tarch/multicore/BooleanSemaphore.h"
+
+namespace exahype {
+  namespace plotters {
+    class LimitingADERDG2Reductions;
+  }
+  namespace tests {
+    namespace plotters {
+      class LimitingADERDG2ReductionsTest;
+    }
+  }
+}
+
+/**
+ * Reduces the written quantities on the fly instead of dumping the whole
+ * field.
+ *
+ * Per snapshot, the plotter computes the minimum, the maximum and the L2 norm
+ * of every written quantity over all leaf cells and samples the quantities
+ * along user-defined line transects. The ADER-DG solution is reduced via the
+ * Gauss-Legendre quadrature and evaluated exactly on the transects, the finite
+ * volumes solution of troubled cells is reduced and sampled cell-wise.
+ *
+ * The transects are specified in the plotter parameters, e.g.
+ * <pre>
+ * "parameters": {
+ *   "transects": [ { "from": [0.0,5.0], "to": [10.0,5.0], "samples": 200 } ]
+ * }
+ * </pre>
+ *
+ * If the plotter parameter "concurrent" is set to true (default false), the
+ * patches are reduced concurrently into per-thread partial results. The
+ * user's mapQuantities(...) must then be thread-safe. The partial results
+ * and the transect samples are reset and collected by startPlotting(...)
+ * and finishPlotting() under the same semaphore the plotting threads use.
+ *
+ * <h2>File format</h2>
+ * All values are written in the native byte order to filename.reductions
+ * (one file per rank in MPI builds, the reductions are not merged across ranks):
+ * <pre>
+ * header:   char[8] "EXARED01", int32 writtenUnknowns, int32 dimensions,
+ *           int32 transects, per transect: dimensions doubles from,
+ *           dimensions doubles to, int32 samples
+ * snapshot: double time, double volume,
+ *           per written unknown: double min, double max, double l2,
+ *           per transect sample: writtenUnknowns doubles (NaN if the sample
+ *           lies outside of this rank's leaf cells)
+ * </pre>
+ * Samples lying exactly on the upper boundary of the domain are not found.
+ */
+class exahype::plotters::LimitingADERDG2Reductions
+    : public exahype::plotters::Plotter::Device {
+ private:
+  friend class exahype::tests::plotters::LimitingADERDG2ReductionsTest;
+
+  static tarch::logging::Log _log;
+
+  struct Transect {
+    tarch::la::Vector<DIMENSIONS,double> from;
+    tarch::la::Vector<DIMENSIONS,double> to;
+    int                                  samples;
+  };
+
+  /**
+   * Reductions over the patches a thread has processed since startPlotting(...).
+   */
+  struct PartialReductions {
+    std::vector<double> min;
+    std::vector<double> max;
+    std::vector<double> squares; // integral of the squared quantity
+    double              volume = 0.0;
+
+    // scratch data
+    std::vector<double> interpoland;
+    std::vector<double> value;
+  };
+
+  std::string          _filename;
+  int                  _order           = -1;
+  int                  _solverUnknowns  = -1;
+  int                  _writtenUnknowns = -1;
+  const int            _ghostLayerWidth = -1;
+  double               _time            = 0.0;
+  bool                 _plotPatchesConcurrently = false;
+
+  std::ofstream        _out;
+
+  std::vector<Transect>                      _transects;
+  std::vector<tarch::la::Vector<DIMENSIONS,double>> _samplePoints;
+
+  /**
+   * Written quantities per sample point. Every sample is written by the
+   * single leaf cell containing it, so threads never write the same entry.
+   */
+  std::vector<double>  _samples;
+
+  /**
+   * Guards the map of partial reductions and the samples.
+   */
+  tarch::multicore::BooleanSemaphore                    _partialReductionsSemaphore;
+  std::unordered_map<std::thread::id,PartialReductions> _partialReductions;
+
+  PartialReductions& getPartialReductions();
+
+  void addTransect(const Transect& transect);
+
+  void writeSample(const int sample,const double* value);
+
+  void resetPartialReductions(PartialReductions& reductions) const;
+
+  void addValue(PartialReductions& reductions,const double* value,const double weight) const;
+
+  void openOutputStream();
+
+  void reduceADERDGPatch(
+      PartialReductions& reductions,
+      const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
+      const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
+      const double* const u,
+      const double timeStamp);
+
+  void reduceFiniteVolumesPatch(
+      PartialReductions& reductions,
+      const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
+      const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
+      const double* const u,
+      const int numberOfCellsPerAxis,
+      const double timeStamp);
+
+ public:
+  LimitingADERDG2Reductions(
+      exahype::plotters::Plotter::UserOnTheFlyPostProcessing* postProcessing,
+      const int ghostLayerWidth);
+  virtual ~LimitingADERDG2Reductions();
+
+  virtual void init(const std::string& filename, int orderPlusOne, int unknowns, int writtenUnknowns, exahype::parser::ParserView plotterParameters);
+
+  static std::string getIdentifier();
+
+  void plotPatch(const int solverNumber,solvers::Solver::CellInfo& cellInfo) override;
+
+  bool canPlotPatchesConcurrently() const override;
+
+  virtual void startPlotting( double time );
+  virtual void finishPlotting();
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "exahype/plotters/VTK/ADERDG2LobattoVTK.h"
 #include "exahype/plotters/VTK/ADERDG2LegendreDivergenceVTK.h"
 #include "exahype/plotters/ADERDG2ProbeAscii.h"
+#include "exahype/plotters/LimitingADERDG2Reductions.h"
 
 #include "exahype/plotters/CSV/ADERDG2LegendreCSV.h"
 #include "exahype/plotters/CSV/Patch2CSV.h"
@@ -259,11 +260,22 @@ exahype::plotters::Plotter::Plotter(
             postProcessing,static_cast<exahype::solvers::LimitingADERDGSolver*>(
                 solvers::RegisteredSolvers[_solver])->getLimiter()->getGhostLayerWidth());
       }
+      if (equalsIgnoreCase(_type, LimitingADERDG2CartesianCellsCompressed::getIdentifier())) {
+        _device = new LimitingADERDG2CartesianCellsCompressed(
+            postProcessing,static_cast<exahype::solvers::LimitingADERDGSolver*>(
+                solvers::RegisteredSolvers[_solver])->getLimiter()->getGhostLayerWidth());
+      }
       if(equalsIgnoreCase(_type, LimitingADERDG2Tecplot::getIdentifier())) {
         _device = new LimitingADERDG2Tecplot(postProcessing,
 	        static_cast<exahype::solvers::LimitingADERDGSolver*>(
                   solvers::RegisteredSolvers[_solver])->getLimiter()->getGhostLayerWidth());
       }
+      // reductions and transects instead of the full field
+      if (equalsIgnoreCase(_type, LimitingADERDG2Reductions::getIdentifier())) {
+        _device = new LimitingADERDG2Reductions(
+            postProcessing,static_cast<exahype::solvers::LimitingADERDGSolver*>(
+                solvers::RegisteredSolvers[_solver])->getLimiter()->getGhostLayerWidth());
+      }
       // plot only the FV subcells
 	  if (equalsIgnoreCase(_type, LimitingADERDGSubcells2CartesianCellsVTKAscii::getIdentifier())) {
 		  _device = new LimitingADERDGSubcells2CartesianCellsVTKAscii(
@@ -677,6 +689,10 @@ void exahype::plotters::Plotter::plotPatch(
   }
 }
 
+bool exahype::plotters::Plotter::canPlotPatchesConcurrently() const {
+  return _device!=nullptr && _device->canPlotPatchesConcurrently();
+}
+
 void exahype::plotters::Plotter::finishedPlotting() {
   assertion(isActive());
   if (_repeat > 0.0) {
@@ -698,9 +714,16 @@ void exahype::plotters::plotPatchIfAPlotterIsActive(
   if ( cellInfo.foundCellDescriptionForSolver(solverNumber) ) {
     for (auto* plotter : exahype::plotters::RegisteredPlotters) {
       if (plotter->plotDataFromSolver(solverNumber)) {
-        tarch::multicore::Lock lock(exahype::plotters::SemaphoreForPlotting);
-        plotter->plotPatch(solverNumber,cellInfo);
-        lock.free();
+        profilers::ScopedTag profilingScope(
+            solvers::RegisteredSolvers[solverNumber]->getProfiler(),
+            solvers::Solver::ProfilingPhase::Plotter);
+        if ( plotter->canPlotPatchesConcurrently() ) {
+          plotter->plotPatch(solverNumber,cellInfo);
+        } else {
+          tarch::multicore::Lock lock(exahype::plotters::SemaphoreForPlotting);
+          plotter->plotPatch(solverNumber,cellInfo);
+          lock.free();
+        }
       }
     }
   }
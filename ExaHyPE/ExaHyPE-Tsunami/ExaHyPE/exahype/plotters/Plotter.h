@@ -235,6 +235,12 @@ public:
      */
     virtual void plotPatch(const int solverNumber,solvers::Solver::CellInfo& cellInfo) = 0;
 
+    /**
+     * @return if plotPatch(...) may be called by multiple threads at once.
+     * Otherwise, calls are serialised via SemaphoreForPlotting.
+     */
+    virtual bool canPlotPatchesConcurrently() const { return false; }
+
     virtual void startPlotting( double time ) = 0;
     virtual void finishPlotting() = 0;
   };
@@ -326,6 +332,11 @@ public:
 
   void plotPatch(const int solverNumber,solvers::Solver::CellInfo& cellInfo);
 
+  /**
+   * @return if the device's plotPatch(...) may be called by multiple threads at once.
+   */
+  bool canPlotPatchesConcurrently() const;
+
   std::string getFileName() const;
 
   /**
@@ -21,6 +21,8 @@
 #include "kernels/GaussLegendreBasis.h"
 #include "peano/utils/Loop.h"
 
+#include "tarch/multicore/Lock.h"
+
 
 #include "tarch/plotter/griddata/unstructured/vtk/VTKTextFileWriter.h"
 #include "tarch/plotter/griddata/unstructured/vtk/VTKBinaryFileWriter.h"
@@ -29,6 +31,8 @@
 
 #include "exahype/solvers/LimitingADERDGSolver.h"
 
+#include "exahype/plotters/compressed/CompressedSnapshotWriter.h"
+
 
 // VTK subclasses
 std::string exahype::plotters::LimitingADERDG2CartesianVerticesVTKAscii::getIdentifier() {
@@ -104,6 +108,15 @@ exahype::plotters::LimitingADERDG2CartesianCellsVTUBinary::LimitingADERDG2Cartes
     LimitingADERDG2CartesianVTK(postProcessing,ghostLayerWidth,PlotterType::BinaryVTU,true) {
 }
 
+std::string exahype::plotters::LimitingADERDG2CartesianCellsCompressed::getIdentifier() {
+ return "compressed::Cartesian::cells::limited";
+}
+exahype::plotters::LimitingADERDG2CartesianCellsCompressed::LimitingADERDG2CartesianCellsCompressed(
+    exahype::plotters::Plotter::UserOnTheFlyPostProcessing* postProcessing,
+    const int ghostLayerWidth):
+    LimitingADERDG2CartesianVTK(postProcessing,ghostLayerWidth,PlotterType::Compressed,true) {
+}
+
 tarch::logging::Log exahype::plotters::LimitingADERDG2CartesianVTK::_log("exahype::plotters::LimitingADERDG2CartesianVTK");
 
 exahype::plotters::LimitingADERDG2CartesianVTK::LimitingADERDG2CartesianVTK(
@@ -138,16 +151,13 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::init(
   _order             = orderPlusOne-1;
   _solverUnknowns    = unknowns;
   _plotterParameters = plotterParameters;
-  _patchWriter       = nullptr;
   _writtenUnknowns   = writtenUnknowns;
 
   _slicer = Slicer::bestFromSelectionQuery(plotterParameters);
 
   unsigned int nodes = (DIMENSIONS == 3 ? _order  : 0 ) + 1;
   nodes *= (_order + 1) * (_order + 1);
-  _tempSolution.resize(_solverUnknowns * nodes);
   _tempGradient.resize(DIMENSIONS * _solverUnknowns * nodes);
-  assertion(_tempSolution.size()== _solverUnknowns * nodes);
   assertion(_tempGradient.size()==DIMENSIONS * _solverUnknowns * nodes);
 
   _resolution = 0;
@@ -156,6 +166,31 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::init(
   }
   logInfo("init", "Plotting with resolution "<<_resolution);
 
+  _plotPatchesConcurrently = false;
+  if (_plotterParameters.hasKey("concurrent")) {
+    _plotPatchesConcurrently = _plotterParameters.getValueAsBoolOrDefault("concurrent",false);
+  }
+  logInfo("init", "Plotting patches concurrently: "<<(_plotPatchesConcurrently ? "yes" : "no"));
+
+  int asyncQueueLength = 2;
+  if (_plotterParameters.hasKey("asyncQueueLength")) {
+    asyncQueueLength = _plotterParameters.getValueAsIntOrDefault("asyncQueueLength",asyncQueueLength);
+  }
+  _asyncWriter.reset(new exahype::plotters::AsyncWriter(asyncQueueLength));
+  logInfo("init", "Writing snapshots "<<(_asyncWriter->isAsynchronous() ? "asynchronously" : "synchronously"));
+
+  if (_plotterType==PlotterType::Compressed) {
+    const double errorBound = _plotterParameters.getValueAsDoubleOrDefault("errorBound",1e-4);
+    _errorBounds.assign(_writtenUnknowns,errorBound);
+    for (int unknown=0; unknown<_writtenUnknowns; unknown++) {
+      const std::string key = "errorBounds/"+std::to_string(unknown);
+      if (_plotterParameters.hasKey(key)) {
+        _errorBounds[unknown] = _plotterParameters.getValueAsDouble(key);
+      }
+      logInfo("init", "Compress written unknown "<<unknown<<" with absolute error bound "<<_errorBounds[unknown]);
+    }
+  }
+
   if(_slicer) {
     logInfo("init", "Plotting selection "<<_slicer->toString()<<" to Files "<<filename);
   }
@@ -165,65 +200,6 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::init(
 void exahype::plotters::LimitingADERDG2CartesianVTK::startPlotting( double time ) {
   _fileCounter++;
 
-  assertion( _patchWriter==nullptr );
-
-  if (_writtenUnknowns>0) {
-    switch (_plotterType) {
-    case PlotterType::BinaryVTK:
-      _patchWriter =
-          new tarch::plotter::griddata::blockstructured::PatchWriterUnstructured(
-              new tarch::plotter::griddata::unstructured::vtk::VTKBinaryFileWriter());
-      break;
-    case PlotterType::ASCIIVTK:
-      _patchWriter =
-          new tarch::plotter::griddata::blockstructured::PatchWriterUnstructured(
-              new tarch::plotter::griddata::unstructured::vtk::VTKTextFileWriter());
-      break;
-    case PlotterType::BinaryVTU:
-      _patchWriter =
-          new tarch::plotter::griddata::blockstructured::PatchWriterUnstructured(
-              new tarch::plotter::griddata::unstructured::vtk::VTUBinaryFileWriter());
-      break;
-    case PlotterType::ASCIIVTU:
-      _patchWriter =
-          new tarch::plotter::griddata::blockstructured::PatchWriterUnstructured(
-              new tarch::plotter::griddata::unstructured::vtk::VTUTextFileWriter());
-      break;
-    }
-
-    _gridWriter                  = _patchWriter->createSinglePatchWriter();
-    if ( true || _plotCells) {
-      _cellDataWriter            = _patchWriter->createCellDataWriter("Q", _writtenUnknowns);
-      _vertexDataWriter          = nullptr;
-
-      _cellRefinementStatusWriter           = _patchWriter->createCellDataWriter("RefinementStatus", 1);
-      _vertexRefinementStatusWriter         = nullptr;
-      _cellPreviousRefinementStatusWriter   = _patchWriter->createCellDataWriter("PreviousRefinementStatus", 1);
-      _vertexPreviousRefinementStatusWriter = nullptr;
-
-      _timeStampVertexDataWriter   = nullptr;
-    }
-    else {
-      _cellDataWriter            = _patchWriter->createCellDataWriter("Q", _writtenUnknowns);
-      _vertexDataWriter          = _patchWriter->createVertexDataWriter("Q", _writtenUnknowns);
-
-      _cellRefinementStatusWriter   = nullptr;
-      _vertexRefinementStatusWriter = _patchWriter->createVertexDataWriter("RefinementStatus", 1);
-
-      _cellPreviousRefinementStatusWriter   = nullptr;
-      _vertexPreviousRefinementStatusWriter = _patchWriter->createVertexDataWriter("PreviousRefinementStatus", 1);
-
-      _timeStampVertexDataWriter = _patchWriter->createVertexDataWriter("time", 1);
-      assertion( _timeStampVertexDataWriter!=nullptr );
-    }
-
-    _timeStampCellDataWriter   = _patchWriter->createCellDataWriter("time", 1);
-    assertion( _timeStampCellDataWriter!=nullptr );
-
-    assertion( _patchWriter!=nullptr );
-    assertion( _gridWriter!=nullptr );
-  }
-
   _postProcessing->startPlotting( time );
 
   _time = time;
@@ -234,199 +210,215 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::finishPlotting() {
   _postProcessing->finishPlotting();
 
   if (_writtenUnknowns>0) {
-    assertion( _patchWriter!=nullptr );
-    assertion( _gridWriter!=nullptr );
-
-    _gridWriter->close();
-    if (_timeStampVertexDataWriter!=nullptr)           _timeStampVertexDataWriter->close();
-    if (_timeStampCellDataWriter!=nullptr)             _timeStampCellDataWriter->close();
-    if (_vertexDataWriter!=nullptr)                    _vertexDataWriter->close();
-    if (_cellDataWriter!=nullptr)                      _cellDataWriter->close();
-    if (_cellRefinementStatusWriter!=nullptr)           _cellRefinementStatusWriter->close();
-    if (_vertexRefinementStatusWriter!=nullptr)         _vertexRefinementStatusWriter->close();
-    if (_cellPreviousRefinementStatusWriter!=nullptr)   _cellPreviousRefinementStatusWriter->close();
-    if (_vertexPreviousRefinementStatusWriter!=nullptr) _vertexPreviousRefinementStatusWriter->close();
-
-    std::ostringstream snapshotFileName;
-    snapshotFileName << _filename << "-" << _fileCounter;
-
-    switch (_plotterType) {
-      case PlotterType::BinaryVTK:
-        break;
-      case PlotterType::ASCIIVTK:
-        break;
-      case PlotterType::BinaryVTU:
-        _timeSeriesWriter.addSnapshot( snapshotFileName.str(), _time);
-        _timeSeriesWriter.writeFile(_filename);
-        break;
-      case PlotterType::ASCIIVTU:
-        _timeSeriesWriter.addSnapshot( snapshotFileName.str(), _time);
-        _timeSeriesWriter.writeFile(_filename);
-        break;
+    // the job owns the data, the buffers are refilled while it is written
+    std::shared_ptr<std::vector<PatchBuffer>> buffers(new std::vector<PatchBuffer>());
+    buffers->reserve(_patchBuffers.size());
+    for (auto& entry : _patchBuffers) {
+      buffers->push_back(std::move(entry.second));
+      entry.second = PatchBuffer();
     }
 
-    const bool hasBeenSuccessful =
-      _patchWriter->writeToFile(snapshotFileName.str());
-    if (!hasBeenSuccessful) {
-      exit(-1);
-    }
+    const int    fileCounter = _fileCounter;
+    const double time        = _time;
+    _asyncWriter->submit( [this,buffers,fileCounter,time] () -> void {
+      writeSnapshot(*buffers,fileCounter,time);
+    });
   }
-
-  if (_vertexDataWriter!=nullptr)                  delete _vertexDataWriter;
-  if (_cellDataWriter!=nullptr)                    delete _cellDataWriter;
-  if (_timeStampVertexDataWriter!=nullptr)         delete _timeStampVertexDataWriter;
-  if (_timeStampCellDataWriter!=nullptr)           delete _timeStampCellDataWriter;
-  if (_cellRefinementStatusWriter!=nullptr)           delete _cellRefinementStatusWriter;
-  if (_vertexRefinementStatusWriter!=nullptr)         delete _vertexRefinementStatusWriter;
-  if (_cellPreviousRefinementStatusWriter!=nullptr)   delete _cellPreviousRefinementStatusWriter;
-  if (_vertexPreviousRefinementStatusWriter!=nullptr) delete _vertexPreviousRefinementStatusWriter;
-  if (_gridWriter!=nullptr)                        delete _gridWriter;
-  if (_patchWriter!=nullptr)                       delete _patchWriter;
-
-  _vertexDataWriter                  = nullptr;
-  _cellDataWriter                    = nullptr;
-  _patchWriter                       = nullptr;
-  _timeStampVertexDataWriter         = nullptr;
-  _timeStampCellDataWriter           = nullptr;
-  _cellRefinementStatusWriter           = nullptr;
-  _vertexRefinementStatusWriter         = nullptr;
-  _cellPreviousRefinementStatusWriter   = nullptr;
-  _vertexPreviousRefinementStatusWriter = nullptr;
-  _gridWriter                        = nullptr;
 }
 
 
-
 exahype::plotters::LimitingADERDG2CartesianVTK::~LimitingADERDG2CartesianVTK() {
+  if (_asyncWriter) {
+    _asyncWriter->waitUntilAllJobsHaveBeenProcessed(); // exits if a snapshot could not be written
+    _asyncWriter.reset();
+  }
 }
 
 
-void exahype::plotters::LimitingADERDG2CartesianVTK::writeTimeStampDataToADERDGPatch( double timeStamp, int vertexOrCellIndex ) {
-  if ( _plotCells && _writtenUnknowns > 0 ) {
-    dfor(i,_order) {
-      _timeStampCellDataWriter->plotCell(vertexOrCellIndex, timeStamp);
-      vertexOrCellIndex++;
-    }
-  } else if ( _writtenUnknowns>0) {
-    dfor(i,_order+1) {
-      _timeStampVertexDataWriter->plotVertex(vertexOrCellIndex, timeStamp);
-      vertexOrCellIndex++;
-    }
+bool exahype::plotters::LimitingADERDG2CartesianVTK::canPlotPatchesConcurrently() const {
+  return _plotPatchesConcurrently;
+}
+
+
+exahype::plotters::LimitingADERDG2CartesianVTK::PatchBuffer&
+exahype::plotters::LimitingADERDG2CartesianVTK::getPatchBuffer() {
+  tarch::multicore::Lock lock(_patchBuffersSemaphore);
+  PatchBuffer& buffer = _patchBuffers[std::this_thread::get_id()];
+  lock.free();
+
+  if ( buffer.interpoland.empty() ) { // first use by this thread
+    unsigned int nodes = (DIMENSIONS == 3 ? _order  : 0 ) + 1;
+    nodes *= (_order + 1) * (_order + 1);
+    buffer.interpoland.resize(_solverUnknowns);
+    buffer.value.resize(_writtenUnknowns);
+    buffer.tempSolution.resize(_solverUnknowns * nodes);
   }
+  return buffer;
 }
 
 
-void exahype::plotters::LimitingADERDG2CartesianVTK::plotVertexData(
-  int firstVertexIndex,
-  const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
-  const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
-  double* u,
-  double timeStamp,
-  const int RefinementStatusAsInt,
-  const int previousRefinementStatusAsInt
-) {
-  assertion( _vertexDataWriter!=nullptr || _writtenUnknowns==0 );
-
-  double* interpoland = new double[_solverUnknowns];
-  double* value       = _writtenUnknowns==0 ? nullptr : new double[_writtenUnknowns];
-
-  dfor(i,_order+1) {
-    for (int unknown=0; unknown < _solverUnknowns; unknown++) {
-      interpoland[unknown] = 0.0;
-      dfor(ii,_order+1) { // Gauss-Legendre node indices
-        int iGauss = peano::utils::dLinearisedWithoutLookup(ii,_order + 1);
-        interpoland[unknown] += kernels::legendre::equidistantGridProjector[_order][ii(1)][i(1)] *
-                 kernels::legendre::equidistantGridProjector[_order][ii(0)][i(0)] *
-                 #if DIMENSIONS==3
-                 kernels::legendre::equidistantGridProjector[_order][ii(2)][i(2)] *
-                 #endif
-                 u[iGauss * _solverUnknowns + unknown];
-        assertion3(interpoland[unknown] == interpoland[unknown], offsetOfPatch, sizeOfPatch, iGauss);
-      }
-      if ( !std::isfinite(interpoland[unknown]) ) {
-        logError("plotVertexData(...)","plotted value not finite.");
-        std::abort();
+void exahype::plotters::LimitingADERDG2CartesianVTK::addPatchToBuffer(
+    PatchBuffer& buffer,
+    const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
+    const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
+    const int cellsPerAxis,
+    const double timeStamp,
+    const int RefinementStatusAsInt,
+    const int previousRefinementStatusAsInt) {
+  buffer.offsets.push_back(offsetOfPatch);
+  buffer.sizes.push_back(sizeOfPatch);
+  buffer.cellsPerAxis.push_back(cellsPerAxis);
+  buffer.timeStamps.push_back(timeStamp);
+  buffer.refinementStatus.push_back(RefinementStatusAsInt);
+  buffer.previousRefinementStatus.push_back(previousRefinementStatusAsInt);
+}
+
+
+void exahype::plotters::LimitingADERDG2CartesianVTK::writeSnapshot(
+    const std::vector<PatchBuffer>& buffers,
+    const int fileCounter,
+    const double time) {
+  if (_plotterType==PlotterType::Compressed) {
+    writeCompressedSnapshot(buffers,fileCounter,time);
+    return;
+  }
+
+  tarch::plotter::griddata::blockstructured::PatchWriterUnstructured* patchWriter = nullptr;
+  switch (_plotterType) {
+  case PlotterType::BinaryVTK:
+    patchWriter =
+        new tarch::plotter::griddata::blockstructured::PatchWriterUnstructured(
+            new tarch::plotter::griddata::unstructured::vtk::VTKBinaryFileWriter());
+    break;
+  case PlotterType::ASCIIVTK:
+    patchWriter =
+        new tarch::plotter::griddata::blockstructured::PatchWriterUnstructured(
+            new tarch::plotter::griddata::unstructured::vtk::VTKTextFileWriter());
+    break;
+  case PlotterType::BinaryVTU:
+    patchWriter =
+        new tarch::plotter::griddata::blockstructured::PatchWriterUnstructured(
+            new tarch::plotter::griddata::unstructured::vtk::VTUBinaryFileWriter());
+    break;
+  case PlotterType::ASCIIVTU:
+    patchWriter =
+        new tarch::plotter::griddata::blockstructured::PatchWriterUnstructured(
+            new tarch::plotter::griddata::unstructured::vtk::VTUTextFileWriter());
+    break;
+  case PlotterType::Compressed:
+    break;
+  }
+  assertion( patchWriter!=nullptr );
+
+  auto* gridWriter                         = patchWriter->createSinglePatchWriter();
+  auto* cellDataWriter                     = patchWriter->createCellDataWriter("Q", _writtenUnknowns);
+  auto* cellRefinementStatusWriter         = patchWriter->createCellDataWriter("RefinementStatus", 1);
+  auto* cellPreviousRefinementStatusWriter = patchWriter->createCellDataWriter("PreviousRefinementStatus", 1);
+  auto* timeStampCellDataWriter            = patchWriter->createCellDataWriter("time", 1);
+  assertion( gridWriter!=nullptr );
+  assertion( timeStampCellDataWriter!=nullptr );
+
+  for (const PatchBuffer& buffer : buffers) {
+    const double* value = buffer.values.data();
+
+    for (unsigned int patch=0; patch<buffer.offsets.size(); patch++) {
+      int cellIndex = gridWriter->plotPatch(
+          buffer.offsets[patch], buffer.sizes[patch], buffer.cellsPerAxis[patch]).second;
+
+      const int cells = tarch::la::aPowI(DIMENSIONS,buffer.cellsPerAxis[patch]);
+      for (int cell=0; cell<cells; cell++) {
+        timeStampCellDataWriter->plotCell(cellIndex, buffer.timeStamps[patch]);
+        cellDataWriter->plotCell(cellIndex, const_cast<double*>(value), _writtenUnknowns);
+        cellRefinementStatusWriter->plotCell(cellIndex, static_cast<double>(buffer.refinementStatus[patch]));
+        cellPreviousRefinementStatusWriter->plotCell(cellIndex, static_cast<double>(buffer.previousRefinementStatus[patch]));
+
+        value += _writtenUnknowns;
+        cellIndex++;
       }
     }
+    assertion( value==buffer.values.data()+buffer.values.size() );
+  }
 
-    assertion(sizeOfPatch(0)==sizeOfPatch(1));
-    _postProcessing->mapQuantities(
-      offsetOfPatch,
-      sizeOfPatch,
-      offsetOfPatch + i.convertScalar<double>()* (sizeOfPatch(0)/(_order)),
-      i,
-      interpoland,
-      value,
-      timeStamp
-    );
+  gridWriter->close();
+  timeStampCellDataWriter->close();
+  cellDataWriter->close();
+  cellRefinementStatusWriter->close();
+  cellPreviousRefinementStatusWriter->close();
 
-    if (_writtenUnknowns>0) {
-      _vertexDataWriter->plotVertex(firstVertexIndex, value, _writtenUnknowns );
-    }
+  std::ostringstream snapshotFileName;
+  snapshotFileName << _filename << "-" << fileCounter;
 
-    _vertexRefinementStatusWriter->plotVertex(firstVertexIndex, static_cast<double>(RefinementStatusAsInt));
-    _vertexPreviousRefinementStatusWriter->plotVertex(firstVertexIndex, static_cast<double>(previousRefinementStatusAsInt));
+  switch (_plotterType) {
+    case PlotterType::BinaryVTK:
+      break;
+    case PlotterType::ASCIIVTK:
+      break;
+    case PlotterType::BinaryVTU:
+      _timeSeriesWriter.addSnapshot( snapshotFileName.str(), time);
+      _timeSeriesWriter.writeFile(_filename);
+      break;
+    case PlotterType::ASCIIVTU:
+      _timeSeriesWriter.addSnapshot( snapshotFileName.str(), time);
+      _timeSeriesWriter.writeFile(_filename);
+      break;
+    case PlotterType::Compressed:
+      break;
+  }
 
-    firstVertexIndex++;
+  const bool hasBeenSuccessful =
+    patchWriter->writeToFile(snapshotFileName.str());
+  if (hasBeenSuccessful) {
+    const bool isVTU = _plotterType==PlotterType::BinaryVTU || _plotterType==PlotterType::ASCIIVTU;
+    _snapshotIndexWriter.addSnapshot(
+        SnapshotIndexWriter::getRankFileName(_filename, ".index"), fileCounter, time,
+        SnapshotIndexWriter::getRankFileName(snapshotFileName.str(), isVTU ? ".vtu" : ".vtk"));
+  } else { // we might run on the writer thread
+    _asyncWriter->reportFailure("could not write snapshot "+snapshotFileName.str());
   }
 
-  if (interpoland!=nullptr)  delete[] interpoland;
-  if (value!=nullptr)        delete[] value;
+  delete cellDataWriter;
+  delete timeStampCellDataWriter;
+  delete cellRefinementStatusWriter;
+  delete cellPreviousRefinementStatusWriter;
+  delete gridWriter;
+  delete patchWriter;
 }
 
 
-void exahype::plotters::LimitingADERDG2CartesianVTK::plotCellData(
-  int firstCellIndex,
-  const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
-  const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
-  double* u,
-  double timeStamp,
-  const int RefinementStatusAsInt,
-  const int previousRefinementStatusAsInt
-) {
-  assertion( _cellDataWriter!=nullptr || _writtenUnknowns==0 );
-
-  double* interpoland = new double[_solverUnknowns];
-  double* value       = _writtenUnknowns==0 ? nullptr : new double[_writtenUnknowns];
-
-  dfor(i,_order) {
-    for (int unknown=0; unknown < _solverUnknowns; unknown++) {
-      interpoland[unknown] = kernels::legendre::interpolate(
-        offsetOfPatch.data(),
-        sizeOfPatch.data(),
-        (offsetOfPatch + (i.convertScalar<double>()+0.5)* (sizeOfPatch(0)/(_order))).data(),
-        _solverUnknowns,
-        unknown,
-        _order,
-        u
-      );
-    }
+void exahype::plotters::LimitingADERDG2CartesianVTK::writeCompressedSnapshot(
+    const std::vector<PatchBuffer>& buffers,
+    const int fileCounter,
+    const double time) {
+  exahype::plotters::CompressedSnapshotWriter writer(DIMENSIONS,_errorBounds);
 
-    assertion(sizeOfPatch(0)==sizeOfPatch(1));
-    _postProcessing->mapQuantities(
-      offsetOfPatch,
-      sizeOfPatch,
-      offsetOfPatch + (i.convertScalar<double>()+0.5)* (sizeOfPatch(0)/(_order)),
-      i,
-      interpoland,
-      value,
-      timeStamp
-    );
+  for (const PatchBuffer& buffer : buffers) {
+    const double* value = buffer.values.data();
 
-    if (_writtenUnknowns>0) {
-      _cellDataWriter->plotCell(firstCellIndex, value, _writtenUnknowns );
+    for (unsigned int patch=0; patch<buffer.offsets.size(); patch++) {
+      writer.addPatch(buffer.offsets[patch].data(), buffer.sizes[patch].data(), buffer.cellsPerAxis[patch]);
+
+      const int cells = tarch::la::aPowI(DIMENSIONS,buffer.cellsPerAxis[patch]);
+      for (int cell=0; cell<cells; cell++) {
+        writer.addCell(value);
+        value += _writtenUnknowns;
+      }
     }
+  }
 
-    _cellRefinementStatusWriter->plotCell(firstCellIndex, static_cast<double>(RefinementStatusAsInt));
-    _cellPreviousRefinementStatusWriter->plotCell(firstCellIndex, static_cast<double>(previousRefinementStatusAsInt));
+  std::ostringstream snapshotFileName;
+  snapshotFileName << _filename << "-" << fileCounter;
+  const std::string fileName = SnapshotIndexWriter::getRankFileName(snapshotFileName.str(), ".exz");
 
-    firstCellIndex++;
+  const bool hasBeenSuccessful = writer.writeToFile(fileName, time);
+  if (hasBeenSuccessful) {
+    _snapshotIndexWriter.addSnapshot(
+        SnapshotIndexWriter::getRankFileName(_filename, ".index"), fileCounter, time, fileName);
+  } else { // we might run on the writer thread
+    _asyncWriter->reportFailure("could not write compressed snapshot "+fileName);
   }
-
-  if (interpoland!=nullptr)  delete[] interpoland;
-  if (value!=nullptr)        delete[] value;
 }
 
+
 void exahype::plotters::LimitingADERDG2CartesianVTK::plotPatch(const int solverNumber,solvers::Solver::CellInfo& cellInfo) {
   // look up ADER-DG solver
   solvers::ADERDGSolver*        aderdgSolver = nullptr;
@@ -449,6 +441,8 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::plotPatch(const int solverN
   auto& solverPatch  = cellInfo._ADERDGCellDescriptions[element];
 
   if ( solverPatch.getType()==exahype::solvers::ADERDGSolver::CellDescription::Type::Leaf ) {
+    PatchBuffer& buffer = getPatchBuffer();
+
     int refinementStatus         = solverPatch.getRefinementStatus();
     int previousRefinementStatus = solverPatch.getPreviousRefinementStatus();
 
@@ -470,7 +464,7 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::plotPatch(const int solverN
         tarch::la::Vector<DIMENSIONS, double> subcellOffset = offsetOfPatch;
         double* u = solution;
         if ( subcellsPerDim > 1 ) {
-          u = _tempSolution.data();
+          u = buffer.tempSolution.data();
           for (int d=0; d<DIMENSIONS; d++) {
             subcellOffset[d] = offsetOfPatch[d] + subcellSize[d] * subcellIndex[d];
           }
@@ -478,6 +472,7 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::plotPatch(const int solverN
         }
 
         plotADERDGPatch(
+            buffer,
             subcellOffset,
             subcellSize,
             u,
@@ -488,7 +483,7 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::plotPatch(const int solverN
     } else {
       auto& limiterPatch = cellInfo._FiniteVolumesCellDescriptions[solverNumber];
       plotFiniteVolumesPatch
-          (solverPatch.getOffset(),solverPatch.getSize(),
+          (buffer,solverPatch.getOffset(),solverPatch.getSize(),
           static_cast<double*>(limiterPatch.getSolution()),
           solverPatch.getTimeStamp(),
           fvSolver->getNodesPerCoordinateAxis(),
@@ -499,6 +494,7 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::plotPatch(const int solverN
 
 
 void exahype::plotters::LimitingADERDG2CartesianVTK::plotADERDGPatch(
+    PatchBuffer& buffer,
     const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
     const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
     double* u,
@@ -506,30 +502,46 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::plotADERDGPatch(
     const int RefinementStatusAsInt,
     const int previousRefinementStatusAsInt) {
   if (!_slicer || _slicer->isPatchActive(offsetOfPatch, sizeOfPatch)) {
-    assertion( _writtenUnknowns==0 || _patchWriter!=nullptr );
-    assertion( _writtenUnknowns==0 || _gridWriter!=nullptr );
-
-    std::pair<int,int> vertexAndCellIndex(0,0);
     if (_writtenUnknowns>0) {
-      vertexAndCellIndex = _gridWriter->plotPatch(offsetOfPatch, sizeOfPatch, _order);
+      addPatchToBuffer(buffer,offsetOfPatch,sizeOfPatch,_order,timeStamp,RefinementStatusAsInt,previousRefinementStatusAsInt);
     }
 
-    if (_plotCells) {
-      writeTimeStampDataToADERDGPatch( timeStamp, vertexAndCellIndex.second );
+    double* interpoland = buffer.interpoland.data();
+    double* value       = _writtenUnknowns==0 ? nullptr : buffer.value.data();
 
-      assertion( _writtenUnknowns==0 || _timeStampCellDataWriter!=nullptr );
-      plotCellData( vertexAndCellIndex.second, offsetOfPatch, sizeOfPatch, u, timeStamp, RefinementStatusAsInt, previousRefinementStatusAsInt );
-    }
-    else {
-      writeTimeStampDataToADERDGPatch( timeStamp, vertexAndCellIndex.first );
+    dfor(i,_order) {
+      for (int unknown=0; unknown < _solverUnknowns; unknown++) {
+        interpoland[unknown] = kernels::legendre::interpolate(
+          offsetOfPatch.data(),
+          sizeOfPatch.data(),
+          (offsetOfPatch + (i.convertScalar<double>()+0.5)* (sizeOfPatch(0)/(_order))).data(),
+          _solverUnknowns,
+          unknown,
+          _order,
+          u
+        );
+      }
 
-      assertion( _writtenUnknowns==0 || _timeStampVertexDataWriter!=nullptr );
-      plotVertexData( vertexAndCellIndex.first, offsetOfPatch, sizeOfPatch, u, timeStamp, RefinementStatusAsInt, previousRefinementStatusAsInt );
+      assertion(sizeOfPatch(0)==sizeOfPatch(1));
+      _postProcessing->mapQuantities(
+        offsetOfPatch,
+        sizeOfPatch,
+        offsetOfPatch + (i.convertScalar<double>()+0.5)* (sizeOfPatch(0)/(_order)),
+        i,
+        interpoland,
+        value,
+        timeStamp
+      );
+
+      if (_writtenUnknowns>0) {
+        buffer.values.insert(buffer.values.end(), value, value+_writtenUnknowns);
+      }
     }
   }
 }
 
 void exahype::plotters::LimitingADERDG2CartesianVTK::plotFiniteVolumesPatch(
+  PatchBuffer&                                 buffer,
   const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
   const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
   double*                                      u,
@@ -542,22 +554,16 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::plotFiniteVolumesPatch(
     <<", size of patch: "<<sizeOfPatch
     <<", time stamp: "<<timeStamp);
 
-    assertion( _writtenUnknowns==0 || _patchWriter!=nullptr );
-    assertion( _writtenUnknowns==0 || _gridWriter!=nullptr );
-    assertion( _writtenUnknowns==0 || _timeStampCellDataWriter!=nullptr );
-
-    int cellIndex = _writtenUnknowns==0 ? -1 : _gridWriter->plotPatch(offsetOfPatch, sizeOfPatch, numberOfCellsPerAxis).second;
+    if (_writtenUnknowns>0) {
+      addPatchToBuffer(buffer,offsetOfPatch,sizeOfPatch,numberOfCellsPerAxis,timeStamp,RefinementStatusAsInt,previousRefinementStatusAsInt);
+    }
 
-    double* sourceValue = new double[_solverUnknowns];
-    double* value       = _writtenUnknowns==0 ? nullptr : new double[_writtenUnknowns];
+    double* sourceValue = buffer.interpoland.data();
+    double* value       = _writtenUnknowns==0 ? nullptr : buffer.value.data();
 
     dfor(i,numberOfCellsPerAxis+_ghostLayerWidth) {
       if (tarch::la::allSmaller(i,numberOfCellsPerAxis+_ghostLayerWidth)
           && tarch::la::allGreater(i,_ghostLayerWidth-1)) {
-        if (_writtenUnknowns>0) {
-          _timeStampCellDataWriter->plotCell(cellIndex, timeStamp);
-        }
-
         for (int unknown=0; unknown < _solverUnknowns; unknown++) {
           sourceValue[unknown] =
             u[peano::utils::dLinearisedWithoutLookup(i,numberOfCellsPerAxis+2*_ghostLayerWidth)*_solverUnknowns+unknown];
@@ -576,17 +582,9 @@ void exahype::plotters::LimitingADERDG2CartesianVTK::plotFiniteVolumesPatch(
         );
 
         if (_writtenUnknowns>0) {
-          _cellDataWriter->plotCell(cellIndex, value, _writtenUnknowns);
+          buffer.values.insert(buffer.values.end(), value, value+_writtenUnknowns);
         }
-
-        _cellRefinementStatusWriter->plotCell(cellIndex, static_cast<double>(RefinementStatusAsInt));
-        _cellPreviousRefinementStatusWriter->plotCell(cellIndex, static_cast<double>(previousRefinementStatusAsInt));
-
-        cellIndex++;
       }
     }
-
-    delete[] sourceValue;
-    delete[] value;
   }
 }
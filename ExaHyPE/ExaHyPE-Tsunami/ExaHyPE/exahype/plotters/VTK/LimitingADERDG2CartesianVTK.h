@@ -14,8 +14,17 @@
 #ifndef _EXAHYPE_PLOTTERS_LIMITING_ADERDG_2_CARTESIAN_VTK_H_
 #define _EXAHYPE_PLOTTERS_LIMITING_ADERDG_2_CARTESIAN_VTK_H_
 
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "tarch/plotter/griddata/blockstructured/PatchWriterUnstructured.h"
 #include "tarch/plotter/griddata/VTUTimeSeriesWriter.h"
+#include "tarch/multicore/BooleanSemaphore.h"
+
+#include "exahype/plotters/VTK/SnapshotIndexWriter.h"
+#include "exahype/plotters/AsyncWriter.h"
 
 #include "exahype/plotters/Plotter.h"
 #include "exahype/plotters/slicing/Slicer.h"
@@ -34,12 +43,37 @@ namespace exahype {
     class LimitingADERDG2CartesianCellsVTUAscii;
     class LimitingADERDG2CartesianCellsVTUBinary;
 
+    class LimitingADERDG2CartesianCellsCompressed;
+
     class Slicer; // external forward decl, #include exahype/plotters/slicing/Slicer.h
   }
 }
 
 /**
  * Common VTK class. Usually not used directly but through one of the subclasses.
+ *
+ * <h2>Concurrent plotting</h2>
+ * The patch writers are not thread-safe. If the plotter parameter "concurrent"
+ * is set to true (default false), every thread interpolates and post-processes
+ * its patches into its own PatchBuffer instead of serialising all plotPatch(...)
+ * calls. The buffers are handed over to the writers in finishPlotting().
+ * The user's mapQuantities(...) must then be thread-safe.
+ *
+ * The float-to-text conversion of the ascii variants is still done serially
+ * by the Peano writers; use a binary variant if it dominates the plot time.
+ *
+ * <h2>Asynchronous writing</h2>
+ * finishPlotting() moves the buffers into a job for an AsyncWriter which
+ * creates the Peano writers and writes the file in the background.
+ * The plotter parameter "asyncQueueLength" (default 2) limits the number of
+ * snapshots waiting to be written; 0 writes synchronously. A snapshot which
+ * cannot be written stops the program at the next plot or at the end of the run.
+ *
+ * <h2>Compressed snapshots</h2>
+ * The Compressed plotter type writes a CompressedSnapshotWriter file (.exz)
+ * instead of a VTK file. The absolute error bound of the written quantities
+ * is set via the plotter parameter "errorBound" (default 1e-4) or per
+ * quantity via "errorBounds": [...].
  */
 class exahype::plotters::LimitingADERDG2CartesianVTK: public exahype::plotters::Plotter::Device {
 protected:
@@ -47,7 +81,8 @@ protected:
      BinaryVTK,
      ASCIIVTK,
      BinaryVTU,
-     ASCIIVTU
+     ASCIIVTU,
+     Compressed
    };
 private:
   int           _fileCounter     = -1;
@@ -70,10 +105,9 @@ private:
 
 
   /**
-   * Temporary solution and gradient arrays used for interpolating the solution
-   * onto finer grids.
+   * Temporary gradient array. The temporary solution used for interpolating the solution
+   * onto finer grids is held per thread, see PatchBuffer.
    */
-  std::vector<double>          _tempSolution;
   std::vector<double>          _tempGradient;
   /**
    * The ghost layer width the finite volumes patch is using.
@@ -94,39 +128,81 @@ private:
    */
   tarch::plotter::griddata::VTUTimeSeriesWriter _timeSeriesWriter;
 
-  tarch::plotter::griddata::blockstructured::PatchWriter::SinglePatchWriter* _gridWriter  = nullptr;
-  tarch::plotter::griddata::blockstructured::PatchWriterUnstructured*        _patchWriter = nullptr;
+  /**
+   * Frame/time/size manifest of all snapshots, written for all plotter types
+   * so that readers do not have to list and sort the output directory.
+   */
+  exahype::plotters::SnapshotIndexWriter _snapshotIndexWriter;
 
-  tarch::plotter::griddata::Writer::VertexDataWriter*                        _vertexDataWriter = nullptr;
-  tarch::plotter::griddata::Writer::CellDataWriter*                          _cellDataWriter   = nullptr;
-  tarch::plotter::griddata::Writer::VertexDataWriter*                        _timeStampVertexDataWriter = nullptr;
-  tarch::plotter::griddata::Writer::CellDataWriter*                          _timeStampCellDataWriter   = nullptr;
-  tarch::plotter::griddata::Writer::CellDataWriter*                          _cellRefinementStatusWriter   = nullptr;
-  tarch::plotter::griddata::Writer::VertexDataWriter*                        _vertexRefinementStatusWriter         = nullptr;
-  tarch::plotter::griddata::Writer::CellDataWriter*                          _cellPreviousRefinementStatusWriter   = nullptr;
-  tarch::plotter::griddata::Writer::VertexDataWriter*                        _vertexPreviousRefinementStatusWriter = nullptr;
+  /**
+   * The patches a thread has plotted since startPlotting(...).
+   */
+  struct PatchBuffer {
+    std::vector<tarch::la::Vector<DIMENSIONS,double>> offsets;
+    std::vector<tarch::la::Vector<DIMENSIONS,double>> sizes;
+    std::vector<int>    cellsPerAxis;
+    std::vector<double> timeStamps;
+    std::vector<int>    refinementStatus;
+    std::vector<int>    previousRefinementStatus;
+    std::vector<double> values; // _writtenUnknowns entries per cell
+
+    // scratch data
+    std::vector<double> interpoland;
+    std::vector<double> value;
+    std::vector<double> tempSolution;
+  };
 
-  void writeTimeStampDataToADERDGPatch( double timeStamp, int vertexIndex );
+  /**
+   * Plot patches from multiple threads at once.
+   * Switched on via the plotter parameter "concurrent".
+   */
+  bool _plotPatchesConcurrently = false;
 
-  void plotVertexData(
-      int firstVertexIndex,
-      const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
-      const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
-      double* u,
-      double timeStamp,
-      const int RefinementStatus,
-      const int previousRefinementStatusAsInt
-  );
+  tarch::multicore::BooleanSemaphore               _patchBuffersSemaphore;
+  std::unordered_map<std::thread::id,PatchBuffer> _patchBuffers;
 
-  void plotCellData(
-      int firstCellIndex,
+  /**
+   * @return the buffer of the calling thread.
+   */
+  PatchBuffer& getPatchBuffer();
+
+  /**
+   * Append a patch with @p cellsPerAxis cells per coordinate axis to the buffer.
+   * The cell values must be appended afterwards.
+   */
+  void addPatchToBuffer(
+      PatchBuffer& buffer,
       const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
       const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
-      double* u,
-      double timeStamp,
+      const int cellsPerAxis,
+      const double timeStamp,
       const int RefinementStatusAsInt,
-      const int previousRefinementStatusAsInt
-  );
+      const int previousRefinementStatusAsInt);
+
+  /**
+   * Writes the snapshots. Declared last so that it is flushed
+   * before any other member is destroyed.
+   */
+  std::unique_ptr<exahype::plotters::AsyncWriter> _asyncWriter;
+
+  /**
+   * Absolute error bound per written unknown. Only used by the Compressed type.
+   */
+  std::vector<double> _errorBounds;
+
+  /**
+   * Variant of writeSnapshot(...) for the Compressed type.
+   */
+  void writeCompressedSnapshot(const std::vector<PatchBuffer>& buffers, const int fileCounter, const double time);
+
+  /**
+   * Hand the patches of the buffers over to Peano's writers and write
+   * the snapshot file. Runs on the writer thread.
+   *
+   * @note Updates the time series and the snapshot index; the jobs of
+   * the AsyncWriter are processed one after the other.
+   */
+  void writeSnapshot(const std::vector<PatchBuffer>& buffers, const int fileCounter, const double time);
 public:
   LimitingADERDG2CartesianVTK(
       exahype::plotters::Plotter::UserOnTheFlyPostProcessing* postProcessing,
@@ -140,10 +216,13 @@ public:
 
   void plotPatch(const int solverNumber,solvers::Solver::CellInfo& cellInfo) override;
 
+  bool canPlotPatchesConcurrently() const override;
+
   /**
    * Plot an ADER-DG solution.
    */
   void plotADERDGPatch(
+      PatchBuffer& buffer,
       const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
       const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch, double* u,
       double timeStamp,
@@ -154,6 +233,7 @@ public:
    * Plot a finite volumes solution.
    */
   void plotFiniteVolumesPatch(
+      PatchBuffer& buffer,
       const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
       const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch, double* u,
       double timeStamp,
@@ -219,4 +299,11 @@ class exahype::plotters::LimitingADERDG2CartesianCellsVTUBinary: public exahype:
     LimitingADERDG2CartesianCellsVTUBinary(exahype::plotters::Plotter::UserOnTheFlyPostProcessing* postProcessing,const int ghostLayerWidth);
 };
 
+// Compressed subclass
+class exahype::plotters::LimitingADERDG2CartesianCellsCompressed: public exahype::plotters::LimitingADERDG2CartesianVTK {
+  public:
+    static std::string getIdentifier();
+    LimitingADERDG2CartesianCellsCompressed(exahype::plotters::Plotter::UserOnTheFlyPostProcessing* postProcessing,const int ghostLayerWidth);
+};
+
 #endif // _EXAHYPE_PLOTTERS_LIMITING_ADERDG_2_CARTESIAN_VTK_H_
@@ -0,0 +1,63 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon 
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "SnapshotIndexWriter.h"
+
+#include "tarch/parallel/Node.h"
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sys/stat.h>
+
+tarch::logging::Log exahype::plotters::SnapshotIndexWriter::_log("exahype::plotters::SnapshotIndexWriter");
+
+std::string exahype::plotters::SnapshotIndexWriter::getRankFileName(
+    const std::string& snapshotFileName,
+    const std::string& extension) {
+  return snapshotFileName + "-rank-" + std::to_string(tarch::parallel::Node::getInstance().getRank()) + extension;
+}
+
+bool exahype::plotters::SnapshotIndexWriter::addSnapshot(
+    const std::string& indexFileName,
+    int                frame,
+    double             time,
+    const std::string& snapshotFileName,
+    long long          bytes) {
+  if (bytes < 0) {
+    struct stat fileStatus;
+    if (stat(snapshotFileName.c_str(), &fileStatus) == 0) {
+      bytes = static_cast<long long>(fileStatus.st_size);
+    } else {
+      logWarning("addSnapshot(...)", "cannot determine size of snapshot '" << snapshotFileName << "'");
+      bytes = 0;
+    }
+  }
+
+  std::ofstream out(indexFileName.c_str(), _isFirstSnapshot ? std::ios::trunc : std::ios::app);
+  if (!out) {
+    logError("addSnapshot(...)", "cannot open snapshot index '" << indexFileName << "'");
+    return false;
+  }
+  if (_isFirstSnapshot) {
+    out << "# frame time file bytes" << std::endl;
+    _isFirstSnapshot = false;
+  }
+
+  const std::size_t slash = snapshotFileName.find_last_of('/');
+  const std::string file  = (slash == std::string::npos) ? snapshotFileName : snapshotFileName.substr(slash + 1);
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+  out << frame << " " << time << " " << file << " " << bytes << "\n";
+  out.flush();
+  return out.good();
+}
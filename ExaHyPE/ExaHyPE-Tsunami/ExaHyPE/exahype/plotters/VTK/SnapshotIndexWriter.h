@@ -0,0 +1,73 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon 
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_PLOTTERS_SNAPSHOT_INDEX_WRITER_H_
+#define _EXAHYPE_PLOTTERS_SNAPSHOT_INDEX_WRITER_H_
+
+#include <string>
+
+#include "tarch/logging/Log.h"
+
+namespace exahype {
+  namespace plotters {
+    class SnapshotIndexWriter;
+  }
+}
+
+/**
+ * Manifest of all snapshots a plotter has written so far.
+ *
+ * Counterpart of tarch::plotter::griddata::VTUTimeSeriesWriter for the
+ * legacy VTK types. Each row holds the frame number, the simulated time,
+ * the file name (without directory, so the manifest stays valid when the
+ * output folder is copied) and the size of the snapshot file. Readers can
+ * thus load the sequence in a single linear pass instead of listing and
+ * sorting the output directory.
+ *
+ * Every snapshot appends a single row, so writing n snapshots costs O(n).
+ * The first snapshot of a run truncates a manifest left over from an
+ * earlier run.
+ *
+ * The file is plain text:
+ * <pre>
+ * # frame time file bytes
+ * 0 0 vtk-sandbox-0-rank-0.vtk 933886
+ * </pre>
+ */
+class exahype::plotters::SnapshotIndexWriter {
+  private:
+    static tarch::logging::Log _log;
+
+    bool _isFirstSnapshot = true;
+
+  public:
+    /**
+     * Append a row for a snapshot that has already been written to disk.
+     * The size is taken from the file system if \p bytes is negative.
+     * Returns false if the manifest could not be written.
+     *
+     * @param indexFileName    full path of the manifest including its extension
+     * @param snapshotFileName full path of the snapshot file as written
+     */
+    bool addSnapshot(
+        const std::string& indexFileName,
+        int frame, double time, const std::string& snapshotFileName, long long bytes=-1);
+
+    /**
+     * Compose the file name Peano's VTK/VTU writers use for a snapshot, cf.
+     * tarch::plotter::griddata::unstructured::vtk::VTKTextFileWriter::writeToFile(...).
+     */
+    static std::string getRankFileName(const std::string& snapshotFileName, const std::string& extension);
+};
+
+#endif // _EXAHYPE_PLOTTERS_SNAPSHOT_INDEX_WRITER_H_
@@ -0,0 +1,162 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_PLOTTERS_COMPRESSED_SNAPSHOT_READER_H_
+#define _EXAHYPE_PLOTTERS_COMPRESSED_SNAPSHOT_READER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Header-only decoder of the snapshots of the CompressedSnapshotWriter.
+ *
+ * It depends on the standard library only and is shared by the engine's
+ * tests and the visualisation front end (src/CompressedSnapshot.hpp), which
+ * decodes the chunks on its own thread pool. See CompressedSnapshotWriter
+ * for the file layout.
+ */
+namespace exahype {
+  namespace plotters {
+    namespace compressedsnapshot {
+
+      struct Snapshot {
+        int                  dimensions = 0;
+        int                  quantities = 0;
+        double               time       = 0.0;
+        std::vector<double>  errorBounds;
+        std::vector<double>  patchGeometry; // offset[dimensions], size[dimensions] per patch
+        std::vector<int32_t> cellsPerAxis;  // per patch
+        int64_t              cells      = 0;
+        int64_t              chunks     = 0; // per quantity
+        std::vector<double>  values;        // cells x quantities
+      };
+
+      template <typename T>
+      inline bool read(const char*& in, const char* end, T& value) {
+        if (end - in < static_cast<std::ptrdiff_t>(sizeof(T))) return false;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return true;
+      }
+
+      template <typename T>
+      inline bool readArray(const char*& in, const char* end, std::vector<T>& values, size_t n) {
+        if (static_cast<size_t>(end - in) / sizeof(T) < n) return false;
+        values.resize(n);
+        std::memcpy(values.data(), in, n * sizeof(T));
+        in += n * sizeof(T);
+        return true;
+      }
+
+      /**
+       * Decodes the n values of a chunk [in,end) into out[0], out[stride], ...
+       *
+       * @return false if the chunk is truncated or contains more values.
+       */
+      inline bool decodeChunk(const char* in, const char* end, int64_t n, double scale, double* out, int stride) {
+        int64_t previous = 0;
+        for (int64_t i = 0; i < n; ++i) {
+          uint64_t zigzag = 0;
+          int shift = 0;
+          while (true) {
+            if (in == end || shift > 63) return false;
+            const uint8_t byte = static_cast<uint8_t>(*in++);
+            zigzag |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) break;
+            shift += 7;
+          }
+          const int64_t difference = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+          previous += difference;
+          out[i * stride] = previous * scale;
+        }
+        return in == end;
+      }
+
+      /**
+       * Decodes the bytes of one snapshot.
+       *
+       * @param parallelFor callable parallelFor(tasks,body) which calls body(task)
+       *                    exactly once for every task in [0,tasks), in any order
+       *                    and on any thread. One task decodes one chunk.
+       */
+      template <typename ParallelFor>
+      bool readSnapshot(const std::string& data, Snapshot& snapshot, ParallelFor&& parallelFor) {
+        const char* in  = data.data();
+        const char* end = in + data.size();
+
+        if (data.size() < 8 || std::memcmp(in, "EXAZ0001", 8) != 0) return false;
+        in += 8;
+
+        int32_t dimensions, quantities, cellsPerChunk, reserved;
+        int64_t patches;
+        if (!read(in, end, dimensions) || !read(in, end, quantities) || !read(in, end, cellsPerChunk) ||
+            !read(in, end, reserved) || !read(in, end, snapshot.time)) return false;
+        if (dimensions < 1 || quantities < 0 || cellsPerChunk < 1) return false;
+        snapshot.dimensions = dimensions;
+        snapshot.quantities = quantities;
+        if (!readArray(in, end, snapshot.errorBounds, quantities) || !read(in, end, patches) ||
+            !read(in, end, snapshot.cells) || patches < 0 || snapshot.cells < 0) return false;
+        if (!readArray(in, end, snapshot.patchGeometry, static_cast<size_t>(patches) * 2 * dimensions) ||
+            !readArray(in, end, snapshot.cellsPerAxis, static_cast<size_t>(patches))) return false;
+
+        snapshot.chunks = (snapshot.cells + cellsPerChunk - 1) / cellsPerChunk;
+        std::vector<int64_t> chunkBytes;
+        if (!readArray(in, end, chunkBytes, static_cast<size_t>(snapshot.chunks * quantities))) return false;
+
+        std::vector<const char*> chunkBegin(chunkBytes.size());
+        for (size_t task = 0; task < chunkBytes.size(); ++task) {
+          if (chunkBytes[task] < 0 || end - in < chunkBytes[task]) return false;
+          chunkBegin[task] = in;
+          in += chunkBytes[task];
+        }
+        if (in != end) return false;
+
+        snapshot.values.resize(static_cast<size_t>(snapshot.cells) * quantities);
+        std::atomic<bool> valid(true);
+        parallelFor(static_cast<int>(chunkBytes.size()), [&] (const int task) {
+          const int     quantity = static_cast<int>(task / snapshot.chunks);
+          const int64_t first    = (task % snapshot.chunks) * cellsPerChunk;
+          const int64_t n        = std::min<int64_t>(cellsPerChunk, snapshot.cells - first);
+          if (!decodeChunk(chunkBegin[task], chunkBegin[task] + chunkBytes[task], n,
+                           2.0 * snapshot.errorBounds[quantity],
+                           snapshot.values.data() + first * snapshot.quantities + quantity, snapshot.quantities)) {
+            valid = false;
+          }
+        });
+        return valid;
+      }
+
+      /**
+       * Runs the tasks one after the other.
+       */
+      struct SerialFor {
+        template <typename Body>
+        void operator()(const int tasks, Body&& body) const {
+          for (int task = 0; task < tasks; ++task) body(task);
+        }
+      };
+
+      inline bool readSnapshot(const std::string& data, Snapshot& snapshot) {
+        return readSnapshot(data, snapshot, SerialFor());
+      }
+
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "CompressedSnapshotWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+tarch::logging::Log exahype::plotters::CompressedSnapshotWriter::_log("exahype::plotters::CompressedSnapshotWriter");
+
+const char exahype::plotters::CompressedSnapshotWriter::Magic[8] = {'E','X','A','Z','0','0','0','1'};
+
+namespace {
+  // keeps the differences of two quantised values within int64
+  const double MaxQuantised = 2305843009213693952.0; // 2^61
+
+  template <typename T>
+  void writeBinary(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+exahype::plotters::CompressedSnapshotWriter::CompressedSnapshotWriter(
+    int dimensions,
+    const std::vector<double>& errorBounds,
+    int cellsPerChunk)
+  : _dimensions(dimensions),
+    _cellsPerChunk(cellsPerChunk > 0 ? cellsPerChunk : 1),
+    _errorBounds(errorBounds),
+    _quantised(errorBounds.size()) {
+  for (double errorBound : _errorBounds) {
+    if (!(errorBound > 0.0)) {
+      logError("CompressedSnapshotWriter(...)", "error bounds must be positive. Have " << errorBound);
+      std::abort();
+    }
+  }
+}
+
+void exahype::plotters::CompressedSnapshotWriter::addPatch(const double* offset, const double* size, int cellsPerAxis) {
+  _patchGeometry.insert(_patchGeometry.end(), offset, offset+_dimensions);
+  _patchGeometry.insert(_patchGeometry.end(), size,   size+_dimensions);
+  _cellsPerAxis.push_back(cellsPerAxis);
+}
+
+void exahype::plotters::CompressedSnapshotWriter::addCell(const double* values) {
+  for (unsigned int q=0; q<_quantised.size(); q++) {
+    double scaled = values[q] / (2.0*_errorBounds[q]);
+    if (!(std::abs(scaled) < MaxQuantised)) { // also catches NaN
+      if (!_clamped) {
+        logWarning("addCell(...)", "value " << values[q] << " of quantity " << q << " cannot be represented with error bound " << _errorBounds[q] << "; clamping it");
+        _clamped = true;
+      }
+      scaled = (scaled > 0.0) ? MaxQuantised : ( scaled < 0.0 ? -MaxQuantised : 0.0 );
+    }
+    _quantised[q].push_back(std::llround(scaled));
+  }
+}
+
+void exahype::plotters::CompressedSnapshotWriter::encodeChunk(const int64_t* quantised, int64_t n, std::string& out) {
+  int64_t previous = 0;
+  for (int64_t i=0; i<n; i++) {
+    const int64_t  difference = quantised[i] - previous;
+    uint64_t       zigzag     = (static_cast<uint64_t>(difference) << 1) ^ static_cast<uint64_t>(difference >> 63);
+    while (zigzag >= 0x80) {
+      out.push_back(static_cast<char>((zigzag & 0x7f) | 0x80));
+      zigzag >>= 7;
+    }
+    out.push_back(static_cast<char>(zigzag));
+    previous = quantised[i];
+  }
+}
+
+bool exahype::plotters::CompressedSnapshotWriter::writeToFile(const std::string& filename, double time) const {
+  const int64_t cells  = _quantised.empty() ? 0 : static_cast<int64_t>(_quantised[0].size());
+  const int64_t chunks = (cells + _cellsPerChunk - 1) / _cellsPerChunk;
+
+  std::vector<std::string> data;
+  data.reserve(_quantised.size()*chunks);
+  for (const std::vector<int64_t>& quantised : _quantised) {
+    for (int64_t chunk=0; chunk<chunks; chunk++) {
+      const int64_t first = chunk * _cellsPerChunk;
+      data.emplace_back();
+      data.back().reserve(2*_cellsPerChunk);
+      encodeChunk(quantised.data()+first, std::min<int64_t>(_cellsPerChunk, cells-first), data.back());
+    }
+  }
+
+  std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+  if (!out) {
+    logError("writeToFile(...)", "cannot open compressed snapshot '" << filename << "'");
+    return false;
+  }
+
+  out.write(Magic, sizeof(Magic));
+  writeBinary(out, static_cast<int32_t>(_dimensions));
+  writeBinary(out, static_cast<int32_t>(_quantised.size()));
+  writeBinary(out, static_cast<int32_t>(_cellsPerChunk));
+  writeBinary(out, static_cast<int32_t>(0));
+  writeBinary(out, time);
+  out.write(reinterpret_cast<const char*>(_errorBounds.data()), _errorBounds.size()*sizeof(double));
+  writeBinary(out, static_cast<int64_t>(_cellsPerAxis.size()));
+  writeBinary(out, cells);
+  out.write(reinterpret_cast<const char*>(_patchGeometry.data()), _patchGeometry.size()*sizeof(double));
+  out.write(reinterpret_cast<const char*>(_cellsPerAxis.data()), _cellsPerAxis.size()*sizeof(int32_t));
+  for (const std::string& chunk : data) {
+    writeBinary(out, static_cast<int64_t>(chunk.size()));
+  }
+  for (const std::string& chunk : data) {
+    out.write(chunk.data(), chunk.size());
+  }
+
+  if (!out) {
+    logError("writeToFile(...)", "failed to write compressed snapshot '" << filename << "'");
+    return false;
+  }
+  return true;
+}
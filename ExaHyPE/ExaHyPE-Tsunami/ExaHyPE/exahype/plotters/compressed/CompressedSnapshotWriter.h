@@ -0,0 +1,100 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_PLOTTERS_COMPRESSED_SNAPSHOT_WRITER_H_
+#define _EXAHYPE_PLOTTERS_COMPRESSED_SNAPSHOT_WRITER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tarch/logging/Log.h"
+
+namespace exahype {
+  namespace plotters {
+    class CompressedSnapshotWriter;
+  }
+}
+
+/**
+ * Lossy compressed snapshot of cell data with a guaranteed absolute error
+ * bound per quantity.
+ *
+ * Every value v of quantity q is quantised to the integer round(v/(2 e_q)),
+ * so that the decoded value differs by at most e_q. The integers of a quantity
+ * are stored as differences to their predecessor in the order the cells were
+ * added (neighbouring cells of a patch have similar values), zigzag encoded
+ * and written as variable length integers (7 bits per byte). The cells are
+ * split into chunks which restart the differencing, so that a reader can
+ * decode all chunks of all quantities in parallel.
+ *
+ * The file layout (native byte order) is
+ * <pre>
+ * char[8] "EXAZ0001"
+ * int32   dimensions, quantities, cellsPerChunk, 0
+ * double  time
+ * double  errorBound[quantities]
+ * int64   patches, cells
+ * double  offset[dimensions], size[dimensions]   per patch
+ * int32   cellsPerAxis                           per patch
+ * int64   bytes                                  per chunk of every quantity
+ * byte    data                                   per chunk of every quantity
+ * </pre>
+ * The chunks are ordered by quantity first. The cells of a patch are
+ * ordered lexicographically with the first coordinate running fastest.
+ */
+class exahype::plotters::CompressedSnapshotWriter {
+  private:
+    static tarch::logging::Log _log;
+
+    const int                         _dimensions;
+    const int                         _cellsPerChunk;
+    const std::vector<double>         _errorBounds;
+
+    std::vector<double>               _patchGeometry;
+    std::vector<int32_t>              _cellsPerAxis;
+    std::vector<std::vector<int64_t>> _quantised;   // per quantity
+    bool                              _clamped = false;
+
+  public:
+    static const char Magic[8];
+
+    /**
+     * @param errorBounds absolute error bound per quantity; must be positive.
+     */
+    CompressedSnapshotWriter(int dimensions, const std::vector<double>& errorBounds, int cellsPerChunk=1<<16);
+
+    /**
+     * Start a patch. Its cellsPerAxis^dimensions cells must be added next.
+     */
+    void addPatch(const double* offset, const double* size, int cellsPerAxis);
+
+    /**
+     * @param values one value per quantity
+     */
+    void addCell(const double* values);
+
+    /**
+     * Encode the snapshot and write it to \p filename.
+     *
+     * @return false if the file could not be written.
+     */
+    bool writeToFile(const std::string& filename, double time) const;
+
+    /**
+     * Append the encoding of \p n quantised values to \p out.
+     */
+    static void encodeChunk(const int64_t* quantised, int64_t n, std::string& out);
+};
+
+#endif
@@ -28,6 +28,23 @@ bool hasSuffix(const std::string& str, const std::string& suffix) {
 namespace exahype {
 namespace profilers {
 
+int Profiler::addTag(const std::string& tag) {
+  auto it = tag_ids_.find(tag);
+  if (it != tag_ids_.end()) {
+    return it->second;
+  }
+  const int tagId = static_cast<int>(tags_.size());
+  tags_.push_back(tag);
+  tag_ids_[tag] = tagId;
+  registerTag(tag);
+  return tagId;
+}
+
+int Profiler::getTagId(const std::string& tag) const {
+  auto it = tag_ids_.find(tag);
+  return (it != tag_ids_.end()) ? it->second : -1;
+}
+
 void Profiler::writeToCout() const { writeToOstream(&std::cout); }
 
 void Profiler::writeToFile(const std::string& path) const {
@@ -16,6 +16,8 @@
 
 #include <iostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace exahype {
 namespace profilers {
@@ -36,6 +38,35 @@ class Profiler {
   virtual void stop(const std::string& tag) = 0;
   virtual void writeToOstream(std::ostream* os) const = 0;
 
+  /**
+   * Registers @p tag (if not done yet) and returns its integer id,
+   * i.e. the number of tags registered before it.
+   *
+   * Tags must be added before worker threads start profiling,
+   * e.g. in the solver constructor, as the tag table is read without
+   * synchronisation afterwards.
+   */
+  int addTag(const std::string& tag);
+
+  /**
+   * @return the id of a tag registered via addTag or -1 if the
+   * tag is unknown.
+   */
+  int getTagId(const std::string& tag) const;
+
+  const std::string& getTag(int tagId) const { return tags_[tagId]; }
+
+  int getNumberOfTags() const { return static_cast<int>(tags_.size()); }
+
+  /**
+   * Id-based variants of start and stop for hot code paths.
+   *
+   * Profilers without a cheaper implementation fall back to the
+   * string-keyed variants.
+   */
+  virtual void startById(int tagId) { start(tags_[tagId]); }
+  virtual void stopById(int tagId) { stop(tags_[tagId]); }
+
   void writeToCout() const;
   void writeToFile(const std::string& path) const;
   void writeToConfiguredOutput() const;
@@ -44,6 +75,35 @@ class Profiler {
   // Either "cout" or path to output file (format is determined based on
   // extension)
   const std::string output_;
+
+  std::vector<std::string> tags_;
+  std::unordered_map<std::string, int> tag_ids_;
+};
+
+/**
+ * Profiles the enclosing scope with the given tag id.
+ */
+class ScopedTag {
+ public:
+  ScopedTag(Profiler& profiler, int tagId)
+      : profiler_(profiler), tag_id_(tagId) {
+    profiler_.startById(tag_id_);
+  }
+
+  // Convenience constructor for enums whose values are tag ids.
+  template <typename Tag>
+  ScopedTag(Profiler& profiler, Tag tag)
+      : ScopedTag(profiler, static_cast<int>(tag)) {}
+
+  ~ScopedTag() { profiler_.stopById(tag_id_); }
+
+  // Disallow copy and assignment
+  ScopedTag(const ScopedTag& other) = delete;
+  ScopedTag& operator=(const ScopedTag& other) = delete;
+
+ private:
+  Profiler& profiler_;
+  const int tag_id_;
 };
 
 }  // namespace profilers
@@ -18,6 +18,7 @@
 #include <iostream>
 #include <unordered_map>
 
+#include "simple/ChromeTraceProfiler.h"
 #include "simple/ChronoElapsedTimeProfiler.h"
 #include "simple/IbmAemProfiler.h"
 #include "simple/NoOpProfiler.h"
@@ -194,6 +195,14 @@ const std::unordered_map<
                new exahype::profilers::simple::ChronoElapsedTimeProfiler(
                    profiling_output));
          }},
+        {"ChromeTraceProfiler",
+         [](const std::vector<std::string>& metrics,
+            const std::string& profiling_output) {
+           return std::unique_ptr<
+               exahype::profilers::simple::ChromeTraceProfiler>(
+               new exahype::profilers::simple::ChromeTraceProfiler(
+                   profiling_output));
+         }},
         {"IbmAemProfiler",
          [](const std::vector<std::string>& metrics,
             const std::string& profiling_output) {
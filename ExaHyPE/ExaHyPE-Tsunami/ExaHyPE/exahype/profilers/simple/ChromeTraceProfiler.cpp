@@ -0,0 +1,164 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "ChromeTraceProfiler.h"
+
+#include <algorithm>
+#include <iomanip>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+inline uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+}  // namespace
+
+namespace exahype {
+namespace profilers {
+namespace simple {
+
+std::atomic<int> ChromeTraceProfiler::next_id_(0);
+
+thread_local std::vector<std::pair<int, ChromeTraceProfiler::ThreadBuffer*>>
+    ChromeTraceProfiler::thread_buffers_;
+
+ChromeTraceProfiler::ChromeTraceProfiler(const std::string& output,
+                                         int eventsPerThread)
+    : Profiler(output),
+      id_(next_id_++),
+      events_per_thread_(std::max(1, eventsPerThread)),
+      ticks_at_start_(readTicks()),
+      time_at_start_(std::chrono::steady_clock::now()) {}
+
+void ChromeTraceProfiler::setNumberOfTags(int n) {
+  // tag table is kept by the base class
+}
+
+void ChromeTraceProfiler::registerTag(const std::string& tag) {
+  // tag table is kept by the base class
+}
+
+ChromeTraceProfiler::ThreadBuffer& ChromeTraceProfiler::getThreadBuffer() {
+  for (const auto& entry : thread_buffers_) {
+    if (entry.first == id_) {
+      return *entry.second;
+    }
+  }
+
+  // first measurement of this thread
+  std::lock_guard<std::mutex> lock(buffers_mutex_);
+  buffers_.emplace_back(new ThreadBuffer());
+  ThreadBuffer* buffer = buffers_.back().get();
+  buffer->thread_index = static_cast<int>(buffers_.size()) - 1;
+  buffer->events.resize(events_per_thread_);
+  buffer->open_events.resize(getNumberOfTags(), 0);
+  thread_buffers_.emplace_back(id_, buffer);
+  return *buffer;
+}
+
+void ChromeTraceProfiler::start(const std::string& tag) {
+  const int tagId = getTagId(tag);
+  if (tagId >= 0) {
+    startById(tagId);
+  }
+}
+
+void ChromeTraceProfiler::stop(const std::string& tag) {
+  const int tagId = getTagId(tag);
+  if (tagId >= 0) {
+    stopById(tagId);
+  }
+}
+
+void ChromeTraceProfiler::startById(int tagId) {
+  ThreadBuffer& buffer = getThreadBuffer();
+  if (tagId >= static_cast<int>(buffer.open_events.size())) {
+    buffer.open_events.resize(getNumberOfTags(), 0);
+  }
+  buffer.open_events[tagId] = readTicks();
+}
+
+void ChromeTraceProfiler::stopById(int tagId) {
+  const uint64_t end = readTicks();
+  ThreadBuffer& buffer = getThreadBuffer();
+  Event& event = buffer.events[buffer.recorded_events % events_per_thread_];
+  event.tag = tagId;
+  event.begin = buffer.open_events[tagId];
+  event.end = end;
+  buffer.recorded_events++;
+}
+
+void ChromeTraceProfiler::writeToOstream(std::ostream* os) const {
+  // calibrate the ticks against the steady clock over the whole run
+  const uint64_t ticks = readTicks();
+  const double elapsed_usec =
+      std::chrono::duration<double, std::micro>(
+          std::chrono::steady_clock::now() - time_at_start_)
+          .count();
+  const double ticks_per_usec =
+      (elapsed_usec > 0.0 && ticks > ticks_at_start_)
+          ? static_cast<double>(ticks - ticks_at_start_) / elapsed_usec
+          : 1.0;
+
+  uint64_t dropped_events = 0;
+  bool first = true;
+  *os << "{\"traceEvents\":[" << std::endl;
+  *os << std::fixed << std::setprecision(3);
+  for (const auto& buffer : buffers_) {
+    *os << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\","
+        << "\"pid\":0,\"tid\":" << buffer->thread_index
+        << ",\"args\":{\"name\":\"thread " << buffer->thread_index << "\"}}";
+    first = false;
+
+    const uint64_t stored =
+        std::min<uint64_t>(buffer->recorded_events, events_per_thread_);
+    dropped_events += buffer->recorded_events - stored;
+    for (uint64_t i = buffer->recorded_events - stored;
+         i < buffer->recorded_events; ++i) {
+      const Event& event = buffer->events[i % events_per_thread_];
+      const double begin_usec =
+          static_cast<double>(
+              static_cast<int64_t>(event.begin - ticks_at_start_)) /
+          ticks_per_usec;
+      const double duration_usec =
+          static_cast<double>(
+              static_cast<int64_t>(event.end - event.begin)) /
+          ticks_per_usec;
+      *os << ",\n{\"name\":\"" << getTag(event.tag)
+          << "\",\"cat\":\"exahype\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+          << buffer->thread_index << ",\"ts\":" << begin_usec
+          << ",\"dur\":" << duration_usec << "}";
+    }
+  }
+  *os << std::endl << "]," << std::endl;
+  *os << "\"displayTimeUnit\":\"ns\"," << std::endl;
+  *os << "\"otherData\":{\"profiler\":\"ChromeTraceProfiler\","
+      << "\"eventsPerThread\":" << events_per_thread_ << ","
+      << "\"droppedEvents\":" << dropped_events << "}" << std::endl;
+  *os << "}" << std::endl;
+}
+
+}  // namespace simple
+}  // namespace profilers
+}  // namespace exahype
@@ -0,0 +1,101 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_PROFILERS_SIMPLE_CHROME_TRACE_PROFILER_H_
+#define _EXAHYPE_PROFILERS_SIMPLE_CHROME_TRACE_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Profiler.h"
+
+namespace exahype {
+namespace profilers {
+namespace simple {
+
+/*
+ * A portable tracing profiler which does not require any hardware
+ * counter library.
+ *
+ * Every thread records complete events (tag id, begin, end) into its own
+ * fixed-size ring buffer; the oldest events are overwritten once it is full.
+ * Time stamps are taken from the time stamp counter where available and
+ * from the steady clock otherwise.
+ *
+ * The output is written in the Chrome trace-event JSON format which can be
+ * loaded into chrome://tracing or Perfetto, e.g. to inspect the load balance
+ * between the TBB workers.
+ *
+ * Tags must be registered before the first measurement. The string-keyed
+ * start and stop look up the tag id and ignore unregistered tags.
+ * A tag must not be nested with itself on the same thread, and
+ * writeToOstream must not run concurrently with any measurement.
+ */
+class ChromeTraceProfiler : public Profiler {
+ public:
+  ChromeTraceProfiler(const std::string& output, int eventsPerThread = 1 << 16);
+
+  virtual ~ChromeTraceProfiler() {}
+
+  void setNumberOfTags(int n) override;
+  void registerTag(const std::string& tag) override;
+  void start(const std::string& tag) override;
+  void stop(const std::string& tag) override;
+  void startById(int tagId) override;
+  void stopById(int tagId) override;
+  void writeToOstream(std::ostream* os) const override;
+
+ private:
+  struct Event {
+    int tag;
+    uint64_t begin;
+    uint64_t end;
+  };
+
+  struct ThreadBuffer {
+    int thread_index;
+    std::vector<Event> events;          // ring buffer
+    uint64_t recorded_events = 0;       // including overwritten ones
+    std::vector<uint64_t> open_events;  // begin time stamp per tag id
+  };
+
+  ThreadBuffer& getThreadBuffer();
+
+  static std::atomic<int> next_id_;
+
+  // Buffers of the calling thread, keyed by the id of the profiler.
+  static thread_local std::vector<std::pair<int, ThreadBuffer*>>
+      thread_buffers_;
+
+  const int id_;
+  const size_t events_per_thread_;
+
+  std::mutex buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+  const uint64_t ticks_at_start_;
+  const std::chrono::steady_clock::time_point time_at_start_;
+};
+
+}  // namespace simple
+}  // namespace profilers
+}  // namespace exahype
+
+#endif  // _EXAHYPE_PROFILERS_SIMPLE_CHROME_TRACE_PROFILER_H_
@@ -56,6 +56,110 @@ class exahype::records::ADERDGCellDescription {
       void setHasCompletedLastStep(bool state) {
         _hasCompletedLastStep.store(state);
       }
+
+      /**
+       * Indicates that the solution of this cell is inert, i.e. it is not
+       * changed by the scheme as long as the neighbours are inert too
+       * (e.g. dry cells of the shallow water equations).
+       * Set after each solution update from the user hook isInert(...).
+       */
+      util::CopyableAtomic<bool> _isInert{false};
+
+      bool getIsInert() const {
+        return _isInert.load();
+      }
+
+      void setIsInert(bool state) {
+        _isInert.store(state);
+      }
+
+      /**
+       * Set by the neighbour merges if any neighbour is not inert.
+       * Read and reset when the cell decides if it becomes inactive.
+       */
+      util::CopyableAtomic<bool> _hasNonInertNeighbour{false};
+
+      bool getHasNonInertNeighbour() const {
+        return _hasNonInertNeighbour.load();
+      }
+
+      void setHasNonInertNeighbour(bool state) {
+        _hasNonInertNeighbour.store(state);
+      }
+
+      /**
+       * Indicates that the cell and all its neighbours are inert and
+       * that the cell skips its time step.
+       */
+      util::CopyableAtomic<bool> _isInactive{false};
+
+      bool getIsInactive() const {
+        return _isInactive.load();
+      }
+
+      void setIsInactive(bool state) {
+        _isInactive.store(state);
+      }
+
+      /**
+       * Claimed by the neighbour merge which computes the prediction of an
+       * inactive cell on demand; see ADERDGSolver::reactivate(...).
+       */
+      util::CopyableAtomic<bool> _isBeingReactivated{false};
+
+      bool tryToClaimReactivation() {
+        bool isBeingReactivated = false;
+        return _isBeingReactivated.compare_exchange_strong(isBeingReactivated,true);
+      }
+
+      void releaseReactivation() {
+        _isBeingReactivated.store(false);
+      }
+
+      /**
+       * Bitmask of the faces whose Riemann solve was skipped as both adjacent
+       * cells are inert and at least one of them is inactive.
+       * Read and reset by the surface integral.
+       */
+      util::CopyableAtomic<int> _skippedFaces{0};
+
+      int getSkippedFaces() const {
+        return _skippedFaces.load();
+      }
+
+      void setSkippedFaces(int skippedFaces) {
+        _skippedFaces.store(skippedFaces);
+      }
+
+      void markFaceAsSkipped(int faceIndex) {
+        _skippedFaces.fetch_or(1 << faceIndex);
+      }
+
+      /**
+       * Local time stepping: heap index of the fluctuations the neighbour merges
+       * accumulate, weighted with the faces' time step sizes, during the time step
+       * of the cell. Same layout as the fluctuations. Each face is only written by
+       * the merge of this face; read and reset by the surface integral.
+       * -1 if not allocated.
+       */
+      int   _accumulatedFluctuationIndex = -1;
+      void* _accumulatedFluctuation      = nullptr;
+
+      int getAccumulatedFluctuationIndex() const {
+        return _accumulatedFluctuationIndex;
+      }
+
+      void setAccumulatedFluctuationIndex(int accumulatedFluctuationIndex) {
+        _accumulatedFluctuationIndex = accumulatedFluctuationIndex;
+      }
+
+      void* getAccumulatedFluctuation() const {
+        return _accumulatedFluctuation;
+      }
+
+      void setAccumulatedFluctuation(void* accumulatedFluctuation) {
+        _accumulatedFluctuation = accumulatedFluctuation;
+      }
       // MANUALLY ADDED
 
 
@@ -55,6 +55,50 @@ class exahype::records::FiniteVolumesCellDescription {
       void setHasCompletedLastStep(bool state) {
         _hasCompletedLastStep.store(state);
       }
+
+      /**
+       * Indicates that the solution of this cell is inert, i.e. it is not
+       * changed by the scheme as long as the neighbours are inert too
+       * (e.g. dry cells of the shallow water equations).
+       * Set after each solution update from the user hook isInert(...).
+       */
+      util::CopyableAtomic<bool> _isInert{false};
+
+      bool getIsInert() const {
+        return _isInert.load();
+      }
+
+      void setIsInert(bool state) {
+        _isInert.store(state);
+      }
+
+      /**
+       * Set by the neighbour merges if any neighbour is not inert.
+       * Read and reset when the cell decides if it becomes inactive.
+       */
+      util::CopyableAtomic<bool> _hasNonInertNeighbour{false};
+
+      bool getHasNonInertNeighbour() const {
+        return _hasNonInertNeighbour.load();
+      }
+
+      void setHasNonInertNeighbour(bool state) {
+        _hasNonInertNeighbour.store(state);
+      }
+
+      /**
+       * Indicates that the cell and all its neighbours are inert and
+       * that the cell skips its time step.
+       */
+      util::CopyableAtomic<bool> _isInactive{false};
+
+      bool getIsInactive() const {
+        return _isInactive.load();
+      }
+
+      void setIsInactive(bool state) {
+        _isInactive.store(state);
+      }
       // MANUALLY ADDED
       
       typedef exahype::records::FiniteVolumesCellDescriptionPacked Packed;
@@ -14,6 +14,8 @@
 #include "exahype/runners/Runner.h"
 
 #include <cmath>
+#include <algorithm>
+#include <sstream>
 
 #include "mpibalancing/HotspotBalancing.h"
 
@@ -30,6 +32,7 @@
 #include "tarch/parallel/NodePool.h"
 #include "tarch/parallel/FCFSNodePoolStrategy.h"
 
+#include "tarch/timing/Watch.h"
 #include "tarch/multicore/Core.h"
 #include "tarch/multicore/MulticoreDefinitions.h"
 #include "tarch/multicore/Jobs.h"
@@ -62,7 +65,9 @@
 #include "mpibalancing/SFCDiffusionNodePoolStrategy.h"
 #endif
 #include "exahype/plotters/Plotter.h"
+#include "exahype/profilers/ProfilerFactory.h"
 
+#include "exahype/mappings/Broadcast.h"
 #include "exahype/mappings/Empty.h"
 #include "exahype/mappings/MeshRefinement.h"
 #include "exahype/mappings/RefinementStatusSpreading.h"
@@ -384,6 +389,18 @@ void exahype::runners::Runner::initSharedMemoryConfiguration() {
       solvers::Solver::JobSystemWaitBehaviour = solvers::Solver::JobSystemWaitBehaviourType::ProcessJobsWithSamePriority;
     }
   }
+
+  // cost-aware job scheduling
+  solvers::Solver::CostAwareJobScheduling = _parser.getCostAwareJobScheduling();
+  solvers::Solver::JobGrainTime           = _parser.getJobGrainTime();
+  solvers::Solver::CostAwareJobPriorities =
+      solvers::Solver::CostAwareJobScheduling &&
+      _parser.compareBackgroundJobProcessing( "job_system" ) && // concurrent priority queue
+      solvers::Solver::JobSystemWaitBehaviour!=solvers::Solver::JobSystemWaitBehaviourType::ProcessJobsWithSamePriority;
+  if ( solvers::Solver::CostAwareJobScheduling && tarch::parallel::Node::getInstance().isGlobalMaster() ) {
+    logInfo("initSharedMemoryConfiguration(...)","Batch jobs which are estimated to take less than "<<solvers::Solver::JobGrainTime<<" s" <<
+        (solvers::Solver::CostAwareJobPriorities ? " and raise the priority of expensive jobs." : "."));
+  }
   #endif
 
   // NOTE: Adjusting the grain size might hurt the intermixing of compute-heavy background jobs, e.g. the PredictionJobs,
@@ -769,6 +786,43 @@ void exahype::runners::Runner::shutdownHeaps() {
   #endif
 }
 
+void exahype::runners::Runner::initProfiling() {
+  const std::string profiler = _parser.getProfilerIdentifier();
+  if ( profiler=="NoOpProfiler" ) {
+    return;
+  }
+
+  const std::string output = _parser.getProfilingOutputFilename();
+  for (auto* solver : exahype::solvers::RegisteredSolvers) {
+    std::string solverOutput = output;
+    if ( output!="" && output!="std.cout" ) {
+      std::string suffix = "";
+      if ( exahype::solvers::RegisteredSolvers.size()>1 ) {
+        suffix += "-" + solver->getIdentifier();
+      }
+      #ifdef Parallel
+      suffix += "-rank-" + std::to_string(tarch::parallel::Node::getInstance().getRank());
+      #endif
+      const size_t extension = output.find_last_of('.');
+      solverOutput = ( extension!=std::string::npos ) ?
+          output.substr(0,extension) + suffix + output.substr(extension) :
+          output + suffix;
+    }
+    solver->setProfiler(
+        profilers::ProfilerFactory::getInstance().create(profiler,{},solverOutput));
+
+    if ( tarch::parallel::Node::getInstance().isGlobalMaster() ) {
+      logInfo("initProfiling()","use "<<profiler<<" for solver "<<solver->getIdentifier()<<" (output: '"<<solverOutput<<"')");
+    }
+  }
+}
+
+void exahype::runners::Runner::shutdownProfiling() {
+  for (auto* solver : exahype::solvers::RegisteredSolvers) {
+    solver->getProfiler().writeToConfiguredOutput();
+  }
+}
+
 void exahype::runners::Runner::initHPCEnvironment() {
   peano::performanceanalysis::Analysis::getInstance().enable(false);
 
@@ -843,6 +897,48 @@ void exahype::runners::Runner::initOptimisations() const {
   exahype::solvers::Solver::FuseAllADERDGPhases              = _parser.getFuseAllAlgorithmicSteps();
   exahype::solvers::Solver::FusedTimeSteppingRerunFactor     = _parser.getFuseAlgorithmicStepsRerunFactor();
   exahype::solvers::Solver::FusedTimeSteppingDiffusionFactor = _parser.getFuseAlgorithmicStepsDiffusionFactor();
+  exahype::solvers::Solver::LocalTimeSteppingLevels          = _parser.getLocalTimeSteppingLevels();
+
+  for (auto* solver : exahype::solvers::RegisteredSolvers) {
+    if ( solver->getTimeStepping()==exahype::solvers::Solver::TimeStepping::Local ) {
+      if ( solver->getType()==exahype::solvers::Solver::Type::FiniteVolumes ) {
+        logError("initOptimisations()","solver '"<<solver->getIdentifier()<<"': 'local' time stepping is not supported by Finite Volumes solvers.");
+        _parser.invalidate();
+      }
+      if ( solver->getType()==exahype::solvers::Solver::Type::LimitingADERDG ) {
+        logError("initOptimisations()","solver '"<<solver->getIdentifier()<<"': 'local' time stepping is not supported by limiting ADER-DG solvers.");
+        _parser.invalidate();
+      }
+      if ( solver->getMaximumAdaptiveMeshDepth()>0 ) {
+        logError("initOptimisations()","solver '"<<solver->getIdentifier()<<"': 'local' time stepping requires a uniform mesh (maximum_mesh_depth=0).");
+        _parser.invalidate();
+      }
+      if ( exahype::solvers::Solver::FuseAllADERDGPhases ) {
+        logError("initOptimisations()","solver '"<<solver->getIdentifier()<<"': 'local' time stepping can not be combined with fused algorithmic steps.");
+        _parser.invalidate();
+      }
+      if ( tarch::parallel::Node::getInstance().getNumberOfNodes()>1 ) {
+        logError("initOptimisations()","solver '"<<solver->getIdentifier()<<"': 'local' time stepping is not supported with MPI yet.");
+        _parser.invalidate();
+      }
+    }
+    if (
+        solver->getType()==exahype::solvers::Solver::Type::ADERDG &&
+        static_cast<exahype::solvers::ADERDGSolver*>(solver)->usePredictorWaveSpeedsForTimeStepSize() &&
+        !exahype::solvers::Solver::FuseAllADERDGPhases
+    ) {
+      logError("initOptimisations()","solver '"<<solver->getIdentifier()<<"': time step sizes from the space-time predictor require fused algorithmic steps, "
+          "which rerun a time step if the predictor shows that it was not admissible.");
+      _parser.invalidate();
+    }
+    if (
+        solver->getType()==exahype::solvers::Solver::Type::LimitingADERDG &&
+        static_cast<exahype::solvers::LimitingADERDGSolver*>(solver)->getSolver()->usePredictorWaveSpeedsForTimeStepSize()
+    ) {
+      logError("initOptimisations()","solver '"<<solver->getIdentifier()<<"': time step sizes from the space-time predictor are not supported by limiting ADER-DG solvers.");
+      _parser.invalidate();
+    }
+  }
 
   #ifdef OnePredictionSweep
   exahype::solvers::Solver::PredictionSweeps = 1;
@@ -865,6 +961,7 @@ void exahype::runners::Runner::initOptimisations() const {
       logInfo("initOptimisations()","\tfuse-algorithmic-steps                  =" << (exahype::solvers::Solver::FuseAllADERDGPhases ? "on" : "off"));
       logInfo("initOptimisations()","\tfuse-algorithmic-steps-rerun-actor      =" << exahype::solvers::Solver::FusedTimeSteppingRerunFactor);
       logInfo("initOptimisations()","\tfuse-algorithmic-steps-diffusion-factor =" << exahype::solvers::Solver::FusedTimeSteppingDiffusionFactor);
+      logInfo("initOptimisations()","\tlocal-time-stepping-levels              =" << exahype::solvers::Solver::LocalTimeSteppingLevels);
       logInfo("initOptimisations()","\tspawn-predictor-as-background-thread ="    << (exahype::solvers::Solver::SpawnPredictionAsBackgroundJob ? "on" : "off"));
       logInfo("initOptimisations()","\tspawn-prolongation-as-background-thread=" << (exahype::solvers::Solver::SpawnProlongationAsBackgroundJob ? "on" : "off"));
       logInfo("initOptimisations()","\tspawn-update-as-background-thread="       << (exahype::solvers::Solver::SpawnUpdateAsBackgroundJob ? "on" : "off"));
@@ -904,6 +1001,8 @@ int exahype::runners::Runner::run() {
       initSharedMemoryConfiguration();
     if ( _parser.isValid() )
       initDataCompression();
+    if ( _parser.isValid() )
+      initProfiling();
     if ( _parser.isValid() )
       initHPCEnvironment();
 
@@ -930,6 +1029,8 @@ int exahype::runners::Runner::run() {
       shutdownSharedMemoryConfiguration();
     if ( _parser.isValid() )
       shutdownDistributedMemoryConfiguration();
+    if ( _parser.isValid() )
+      shutdownProfiling();
 
     shutdownHeaps();
 
@@ -1132,6 +1233,11 @@ int exahype::runners::Runner::runAsMaster(exahype::repositories::Repository& rep
     const bool fuseMostADERDGPhases                     = _parser.getFuseMostAlgorithmicSteps();
     const bool fuseMostADERDGPhasesDoRiemannSolvesTwice = _parser.getFuseMostAlgorithmicStepsDoRiemannSolvesTwice();
 
+    if ( !_parser.getCompressionBenchmarkThresholds().empty() ) {
+      runCompressionBenchmark(repository);
+      simulationTimeSteps = 0;
+    }
+
     // run time stepping loop
     int timeStep = 0;
     while (
@@ -1474,6 +1580,21 @@ void exahype::runners::Runner::printStatistics() {
   logInfo("printStatistics(...)","number of mesh refinements      = "<<_meshRefinements);
   logInfo("printStatistics(...)","number of local recomputations  = "<<_localRecomputations);
   logInfo("printStatistics(...)","number of predictor reruns      = "<<_predictorReruns);
+
+  for (auto* solver : exahype::solvers::RegisteredSolvers) {
+    switch (solver->getType()) {
+      case exahype::solvers::Solver::Type::ADERDG:
+        static_cast<exahype::solvers::ADERDGSolver*>(solver)->logPicardIterationStatistics();
+        static_cast<exahype::solvers::ADERDGSolver*>(solver)->logLocalTimeSteppingStatistics();
+        break;
+      case exahype::solvers::Solver::Type::LimitingADERDG:
+        static_cast<exahype::solvers::LimitingADERDGSolver*>(solver)->getSolver()->logPicardIterationStatistics();
+        static_cast<exahype::solvers::LimitingADERDGSolver*>(solver)->logJobCostModel();
+        break;
+      case exahype::solvers::Solver::Type::FiniteVolumes:
+        break;
+    }
+  }
 }
 
 void exahype::runners::Runner::validateInitialSolverTimeStepData(const bool fuseADERDGPhases) const {
@@ -1485,6 +1606,7 @@ void exahype::runners::Runner::validateInitialSolverTimeStepData(const bool fuse
 
     switch(solver->getTimeStepping()) {
       case exahype::solvers::Solver::TimeStepping::Global:
+      case exahype::solvers::Solver::TimeStepping::Local:
         assertionEquals(solver->getAdmissibleTimeStepSize(),std::numeric_limits<double>::infinity());
         break;
       case exahype::solvers::Solver::TimeStepping::GlobalFixed:
@@ -1771,6 +1893,7 @@ void exahype::runners::Runner::runOneTimeStepWithTwoSeparateAlgorithmicSteps(
     logInfo("runOneTimeStepWithTwoSeparateAlgorithmicSteps(...)","plot");
   }
 
+  // plotting is fused into the prediction sweep, see mappings::Prediction::enterCell(...)
   repository.switchToPrediction(); // Cell onto faces
   repository.iterate( exahype::solvers::Solver::PredictionSweeps, communicatePeanoVertices );
 }
@@ -1805,6 +1928,7 @@ void exahype::runners::Runner::runOneTimeStepWithThreeSeparateAlgorithmicSteps(
     logInfo("runOneTimeStepWithThreeSeparateAlgorithmicSteps(...)","plot");
   }
 
+  // plotting is fused into the prediction sweep, see mappings::Prediction::enterCell(...)
   repository.switchToPrediction(); // Cell onto faces
   repository.iterate( exahype::solvers::Solver::PredictionSweeps, communicatePeanoVertices );
 }
@@ -1841,10 +1965,138 @@ void exahype::runners::Runner::runOneTimeStepWithTwoSeparateAlgorithmicStepsDoRi
     logInfo("runOneTimeStepWithTwoSeparateAlgorithmicSteps(...)","plot");
   }
 
+  // plotting is fused into the prediction sweep, see mappings::Prediction::enterCell(...)
   repository.switchToPrediction(); // Cell onto faces
   repository.iterate( exahype::solvers::Solver::PredictionSweeps, communicatePeanoVertices );
 }
 
+void exahype::runners::Runner::runCompressionBenchmark(repositories::Repository& repository) {
+  #ifdef Parallel
+  if (tarch::parallel::Node::getInstance().getNumberOfNodes()>1) {
+    logWarning("runCompressionBenchmark(...)","compression benchmark is only supported for runs with a single rank. Skip it.");
+    return;
+  }
+  #endif
+  if ( _parser.getProfilingTarget()!=parser::Parser::ProfilingTarget::WholeCode ) {
+    logWarning("runCompressionBenchmark(...)","compression benchmark requires profiling target 'whole_code'. Skip it.");
+    return;
+  }
+
+  // restoring the snapshot uncompresses all cells with the previous threshold still set;
+  // the uncompressed baseline is nevertheless run and reported first
+  std::vector<double> thresholds = _parser.getCompressionBenchmarkThresholds();
+  std::sort(thresholds.begin(),thresholds.end());
+  const int timeStepsPerThreshold = _parser.getCompressionBenchmarkTimeSteps();
+
+  struct Measurement {
+    double threshold;
+    double timePerStep;
+    double dataHeapBytes;           // held by the compressible arrays after the last time step
+    double compressedDataHeapBytes;
+    double pipedUncompressedBytesPerStep;
+    double pipedCompressedBytesPerStep;
+  };
+  std::vector<Measurement> measurements;
+
+  storeOrRestoreSnapshot(repository,false);
+  for (double threshold : thresholds) {
+    storeOrRestoreSnapshot(repository,true); // before the new threshold is set
+    exahype::solvers::Solver::CompressionAccuracy = threshold;
+    #if defined(TrackGridStatistics)
+    exahype::solvers::Solver::PipedUncompressedBytes = 0;
+    exahype::solvers::Solver::PipedCompressedBytes   = 0;
+    #endif
+
+    tarch::timing::Watch watch("exahype::runners::Runner","runCompressionBenchmark(...)",false);
+    for (int timeStep=0; timeStep<timeStepsPerThreshold; timeStep++) {
+      preProcessTimeStepInSharedMemoryEnvironment();
+      if ( exahype::solvers::Solver::FuseAllADERDGPhases ) {
+        runTimeStepsWithFusedAlgorithmicSteps(repository,1);
+      } else if ( _parser.getFuseMostAlgorithmicSteps() ) {
+        runOneTimeStepWithTwoSeparateAlgorithmicSteps(repository,false);
+      } else if ( _parser.getFuseMostAlgorithmicStepsDoRiemannSolvesTwice() ) {
+        runOneTimeStepWithTwoSeparateAlgorithmicStepsDoRiemannSolvesTwice(repository,false);
+      } else {
+        runOneTimeStepWithThreeSeparateAlgorithmicSteps(repository,false);
+      }
+      postProcessTimeStepInSharedMemoryEnvironment();
+    }
+    watch.stopTimer();
+
+    Measurement measurement;
+    measurement.threshold   = threshold;
+    measurement.timePerStep = watch.getCalendarTime() / timeStepsPerThreshold;
+    #if defined(TrackGridStatistics)
+    measurement.dataHeapBytes                 = exahype::solvers::Solver::DataHeapBytes;
+    measurement.compressedDataHeapBytes       = exahype::solvers::Solver::CompressedDataHeapBytes;
+    measurement.pipedUncompressedBytesPerStep = exahype::solvers::Solver::PipedUncompressedBytes / timeStepsPerThreshold;
+    measurement.pipedCompressedBytesPerStep   = exahype::solvers::Solver::PipedCompressedBytes   / timeStepsPerThreshold;
+    #else
+    measurement.dataHeapBytes                 = -1.0; // not tracked
+    measurement.compressedDataHeapBytes       = -1.0;
+    measurement.pipedUncompressedBytesPerStep = -1.0;
+    measurement.pipedCompressedBytesPerStep   = -1.0;
+    #endif
+    measurements.push_back(measurement);
+
+    std::ostringstream bytes;
+    if ( measurement.dataHeapBytes>=0.0 ) {
+      bytes << "\tdata-heap-bytes=" << measurement.dataHeapBytes
+            << "\tcompressed-data-heap-bytes=" << measurement.compressedDataHeapBytes
+            << "\tpiped-uncompressed-bytes-per-step=" << measurement.pipedUncompressedBytesPerStep
+            << "\tpiped-compressed-bytes-per-step=" << measurement.pipedCompressedBytesPerStep;
+    } else {
+      bytes << "\theap bytes n/a (compile with TrackGridStatistics)";
+    }
+    logInfo("runCompressionBenchmark(...)",
+        "threshold=" << threshold << "\ttime-per-step=" << measurement.timePerStep << " s" << bytes.str());
+  }
+  storeOrRestoreSnapshot(repository,true);
+  for (auto* solver : exahype::solvers::RegisteredSolvers) {
+    solver->deleteSnapshot();
+  }
+
+  logInfo("runCompressionBenchmark(...)","summary (" << timeStepsPerThreshold << " time steps per threshold):");
+  logInfo("runCompressionBenchmark(...)","threshold\ttime per step [s]\tdata heap [bytes]\tcompressed heap [bytes]\tcompressed/uncompressed piped bytes");
+  for (const Measurement& measurement : measurements) {
+    std::ostringstream row;
+    row << measurement.threshold << "\t" << measurement.timePerStep << "\t";
+    if ( measurement.dataHeapBytes>=0.0 ) {
+      row << measurement.dataHeapBytes << "\t" << measurement.compressedDataHeapBytes << "\t";
+    } else {
+      row << "n/a\tn/a\t";
+    }
+    if ( measurement.pipedUncompressedBytesPerStep>0.0 ) {
+      row << measurement.pipedCompressedBytesPerStep/measurement.pipedUncompressedBytesPerStep;
+    } else {
+      row << "n/a";
+    }
+    logInfo("runCompressionBenchmark(...)",row.str());
+  }
+}
+
+void exahype::runners::Runner::storeOrRestoreSnapshot(repositories::Repository& repository,const bool restore) {
+  exahype::solvers::Solver::ensureAllJobsHaveTerminated(exahype::solvers::Solver::JobType::SkeletonJob);
+  exahype::solvers::Solver::ensureAllJobsHaveTerminated(exahype::solvers::Solver::JobType::EnclaveJob);
+  exahype::solvers::Solver::ensureAllJobsHaveTerminated(exahype::solvers::Solver::JobType::AMRJob);
+  exahype::solvers::Solver::ensureAllJobsHaveTerminated(exahype::solvers::Solver::JobType::ReductionJob);
+
+  for (auto* solver : exahype::solvers::RegisteredSolvers) {
+    if ( restore ) {
+      solver->restoreFromSnapshot();
+    } else {
+      solver->storeSnapshot();
+    }
+  }
+
+  exahype::mappings::Broadcast::CellSnapshot = restore ?
+      exahype::mappings::Broadcast::CellSnapshotOperation::Restore :
+      exahype::mappings::Broadcast::CellSnapshotOperation::Store;
+  repository.switchToBroadcast();
+  repository.iterate(1,false);
+  exahype::mappings::Broadcast::CellSnapshot = exahype::mappings::Broadcast::CellSnapshotOperation::None;
+}
+
 void exahype::runners::Runner::printGridStatistics(repositories::Repository& repository) {
   #if defined(TrackGridStatistics)
   if (repository.getState().getNumberOfInnerCells()>0 and repository.getState().getMaxLevel()>0) {
@@ -109,10 +109,19 @@ class exahype::runners::Runner {
   void initOptimisations() const;
 
   /**
+   * Replaces the solvers' profilers by the one selected in the
+   * specification file. Does nothing if the NoOpProfiler is selected.
    *
+   * If there is more than one solver or rank, the solver identifier and
+   * the rank are appended to the configured output file name.
    */
   void initProfiling();
 
+  /**
+   * Writes the output of the solvers' profilers.
+   */
+  void shutdownProfiling();
+
   /**
    * Setup the oracles for the shared memory parallelisation. Different
    * oracles can be employed:
@@ -298,6 +307,31 @@ class exahype::runners::Runner {
   void runOneTimeStepWithThreeSeparateAlgorithmicSteps(
       exahype::repositories::Repository& repository, bool plot);
 
+  /**
+   * Run a fixed number of time steps per heap data compression threshold
+   * ("double_compression") specified in the profiling section and report
+   * the time per step, the bytes the compressible ADER-DG and finite volumes
+   * (limiter patch) arrays hold on the data and the compressed heap after the
+   * last step, and the ratio of compressed to uncompressed bytes piped to the
+   * heaps. The byte counts require TrackGridStatistics and are reported as n/a
+   * otherwise.
+   *
+   * All thresholds run on the same mesh, in ascending order. Every threshold
+   * starts from the state after the initial prediction: a snapshot of the
+   * solvers is stored before the first threshold and restored before each
+   * threshold, and again after the last one.
+   */
+  void runCompressionBenchmark(repositories::Repository& repository);
+
+  /**
+   * Waits for all background jobs and stores or restores the snapshots of all
+   * registered solvers, see exahype::solvers::Solver::storeSnapshot(). The cells
+   * are processed in one serial Broadcast iteration.
+   *
+   * @param restore restore the snapshots instead of storing them
+   */
+  void storeOrRestoreSnapshot(repositories::Repository& repository,const bool restore);
+
   /**
    * Print grid statistics, e.g. number of inner cells, unrefined inner cells (leafs) ... .
    */
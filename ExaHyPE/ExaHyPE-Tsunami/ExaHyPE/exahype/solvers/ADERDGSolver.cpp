@@ -18,6 +18,8 @@
 #include <iomanip>
 #include <chrono>
 #include <algorithm> // copy_n
+#include <array>
+#include <thread>
 
 #include "exahype/Cell.h"
 #include "exahype/Vertex.h"
@@ -63,7 +65,9 @@ namespace {
                              "volumeUnknownsProlongation",
                              "volumeUnknownsRestriction",
                              "boundaryConditions",
-                             "deltaDistribution"
+                             "deltaDistribution",
+                             "faceIntegral",
+                             "fusedSpaceTimePredictorVolumeIntegral"
                              };
 }
 
@@ -99,11 +103,13 @@ constexpr int exahype::solvers::ADERDGSolver::BoundaryStatus;
 constexpr int exahype::solvers::ADERDGSolver::Pending;
 constexpr int exahype::solvers::ADERDGSolver::Erase; 
 constexpr int exahype::solvers::ADERDGSolver::Keep;
+constexpr int exahype::solvers::ADERDGSolver::PicardIterationsHistogramBins;
 
 tarch::multicore::BooleanSemaphore exahype::solvers::ADERDGSolver::RestrictionSemaphore;
 
 tarch::multicore::BooleanSemaphore exahype::solvers::ADERDGSolver::CoarseGridSemaphore;
 
+
 int exahype::solvers::ADERDGSolver::computeWeight(const int cellDescriptionsIndex) {
   if ( ADERDGSolver::isValidCellDescriptionIndex(cellDescriptionsIndex) ) {
     int result = 0;
@@ -210,14 +216,30 @@ exahype::solvers::ADERDGSolver::ADERDGSolver(
      _DMPObservables(DMPObservables),
      _minRefinementStatusForTroubledCell(_refineOrKeepOnFineGrid+3),
      _checkForNaNs(true),
-      _meshUpdateEvent(MeshUpdateEvent::None) {
-  // register tags with profiler
-  for (const char* tag : tags) {
-    _profiler->registerTag(tag);
+      _meshUpdateEvent(MeshUpdateEvent::None),
+      _localTimeStep(0),
+      _localTimeSteppingLevels(LocalTimeSteppingLevels),
+      _localTimeSteppingUpdates(0),
+      _localTimeSteppingSkippedUpdates(0),
+      _localTimeSteppingMerges(0),
+      _localTimeSteppingSkippedMerges(0),
+      _localTimeSteppingCellTime(0),
+      _localTimeSteppingMergeTime(0) {
+  registerProfilingTags();
+
+  for (int bin = 0; bin < PicardIterationsHistogramBins; ++bin) {
+    _picardIterationsHistogram[bin] = 0;
   }
 
 }
 
+void exahype::solvers::ADERDGSolver::registerProfilingTags() {
+  Solver::registerProfilingTags();
+  for (const char* tag : tags) {
+    _profiler->addTag(tag);
+  }
+}
+
 int exahype::solvers::ADERDGSolver::getUnknownsPerFace() const {
   return _numberOfVariables * power(_nodesPerCoordinateAxis, DIMENSIONS - 1);
 }
@@ -291,9 +313,11 @@ std::tuple<double,double> exahype::solvers::ADERDGSolver::getRiemannSolverTimeSt
       std::get<0>(result) = _minTimeStamp;
       std::get<1>(result) = _minTimeStepSize;
       break;
+    case TimeStepping::Local:
+      std::get<0>(result) = std::max(cellDescription1.getTimeStamp(),cellDescription2.getTimeStamp());
+      std::get<1>(result) = std::min(cellDescription1.getTimeStepSize(),cellDescription2.getTimeStepSize());
+      break;
     default:
-//      std::get<0>(result) = std::max(cellDescription1.getTimeStamp(),cellDescription2.getTimeStamp());
-//      std::get<1>(result) = std::min(cellDescription1.getTimeStepSize(),cellDescription2.getTimeStepSize());
       logError("getRiemannSolverTimeStepData(...)","Unknown time stepping scheme.")
       std::abort();
   }
@@ -322,6 +346,9 @@ std::tuple<double,double> exahype::solvers::ADERDGSolver::getPredictionTimeStepD
         std::get<1>(result) = _minTimeStepSize;
       }
       break;
+    case TimeStepping::Local:
+      std::get<0>(result) = cellDescription.getTimeStamp();
+      std::get<1>(result) = cellDescription.getTimeStepSize();
       break;
     default:
       logError("getRiemannSolverTimeStepData(...)","Unknown time stepping scheme.")
@@ -340,9 +367,41 @@ void exahype::solvers::ADERDGSolver::synchroniseTimeStepping(
   
       p.setTimeStamp(_minTimeStamp);
       p.setTimeStepSize(_minTimeStepSize);
+      break;
+    case TimeStepping::Local:
+      if ( isStartingTimeStep(p) ) {
+        // the cell must not skip the end of the macro time step
+        int maxLevel = _localTimeSteppingLevels; // > LocalTimeSteppingLevels if the time step size was halved within the macro time step
+        for (int level = 0; level < _localTimeSteppingLevels; level++) {
+          if ( (_localTimeStep >> level) & 1 ) {
+            maxLevel = level;
+            break;
+          }
+        }
+        maxLevel = std::min(maxLevel,LocalTimeSteppingLevels);
+        double timeStepSize = _minTimeStepSize;
+        for (int level = 0; level < maxLevel && 2.0*timeStepSize <= p.getTimeStepSize(); level++) {
+          timeStepSize *= 2.0;
+        }
+        p.setTimeStamp(_minTimeStamp);
+        p.setTimeStepSize(timeStepSize);
+      }
+      break;
   }
 }
 
+bool exahype::solvers::ADERDGSolver::isDueForUpdate(const CellDescription& cellDescription) const {
+  return
+      _timeStepping!=TimeStepping::Local ||
+      cellDescription.getTimeStamp()+cellDescription.getTimeStepSize() < _minTimeStamp + 1.5*_minTimeStepSize;
+}
+
+bool exahype::solvers::ADERDGSolver::isStartingTimeStep(const CellDescription& cellDescription) const {
+  return
+      _timeStepping!=TimeStepping::Local ||
+      std::abs(cellDescription.getTimeStamp()-_minTimeStamp) < 0.5*_minTimeStepSize;
+}
+
 void exahype::solvers::ADERDGSolver::kickOffTimeStep(const bool isFirstTimeStepOfBatchOrNoBatch) {
   if ( isFirstTimeStepOfBatchOrNoBatch ) {
     _meshUpdateEvent               = MeshUpdateEvent::None;
@@ -361,6 +420,12 @@ void exahype::solvers::ADERDGSolver::wrapUpTimeStep(const bool isFirstTimeStepOf
     _previousMinTimeStamp     = _minTimeStamp;
   }
   _minTimeStamp += _minTimeStepSize;
+  if ( getTimeStepping()==TimeStepping::Local ) {
+    _localTimeStep = (_localTimeStep + 1) % (1 << _localTimeSteppingLevels);
+    if ( _localTimeStep==0 ) {
+      _localTimeSteppingLevels = LocalTimeSteppingLevels;
+    }
+  }
 
   _stabilityConditionWasViolated = false;
   if (
@@ -380,7 +445,9 @@ void exahype::solvers::ADERDGSolver::wrapUpTimeStep(const bool isFirstTimeStepOf
       } else { // use fixed time step size in intermediate batch iterations
         _minTimeStepSize  = _estimatedTimeStepSize;
       }
-    } else if ( !isLinear() ) { // non-fused, non-linear
+    } else if ( !isLinear() && getTimeStepping()==TimeStepping::Local && _localTimeStep!=0 ) { // local time stepping: within a macro time step
+      refineLocalTimeStepSize();
+    } else if ( !isLinear() ) { // non-fused, non-linear; local time stepping: begin of a macro time step
       _minTimeStepSize = _admissibleTimeStepSize;
     } // else if linear do not change the time step size at all
   }
@@ -394,6 +461,26 @@ void exahype::solvers::ADERDGSolver::wrapUpTimeStep(const bool isFirstTimeStepOf
   endTimeStep(_minTimeStamp,isLastTimeStepOfBatchOrNoBatch);
 }
 
+void exahype::solvers::ADERDGSolver::refineLocalTimeStepSize() {
+  constexpr int MaximumLevels = 30; // _localTimeStep must fit into an int
+  int halvings = 0;
+  while ( _admissibleTimeStepSize < _minTimeStepSize && _localTimeSteppingLevels < MaximumLevels ) {
+    _minTimeStepSize         *= 0.5;
+    _localTimeStep           *= 2;
+    _localTimeSteppingLevels += 1;
+    halvings++;
+  }
+  if ( _admissibleTimeStepSize < _minTimeStepSize ) {
+    logError("refineLocalTimeStepSize()","solver "<<getIdentifier()<<": time step size "<<_minTimeStepSize<<
+        " is still not admissible (admissible: "<<_admissibleTimeStepSize<<") after halving it "<<halvings<<" times.");
+    std::abort();
+  }
+  if ( halvings > 0 ) {
+    logInfo("refineLocalTimeStepSize()","solver "<<getIdentifier()<<": time step size was not admissible anymore within the macro time step; "
+        "halved it "<<halvings<<" time(s) to "<<_minTimeStepSize<<" until the end of the macro time step.");
+  }
+}
+
 void exahype::solvers::ADERDGSolver::updateTimeStepSize() {
   if ( FuseAllADERDGPhases ) {
     _minTimeStepSize        = FusedTimeSteppingRerunFactor * _admissibleTimeStepSize;
@@ -432,6 +519,44 @@ double exahype::solvers::ADERDGSolver::getEstimatedTimeStepSize() const {
   return _estimatedTimeStepSize;
 }
 
+void exahype::solvers::ADERDGSolver::logPicardIterationStatistics() {
+  long int cells      = 0;
+  long int iterations = 0;
+  for (int bin = 0; bin < PicardIterationsHistogramBins; ++bin) {
+    const int count = _picardIterationsHistogram[bin].exchange(0);
+    cells      += count;
+    iterations += static_cast<long int>(count) * (bin+1);
+    if ( count > 0 ) {
+      logInfo("logPicardIterationStatistics()","solver "<<getIdentifier()<<": "<<
+          (bin+1 < PicardIterationsHistogramBins ? "" : ">=")<<(bin+1)<<" Picard iterations: "<<count<<" cells");
+    }
+  }
+  if ( cells > 0 ) {
+    logInfo("logPicardIterationStatistics()","solver "<<getIdentifier()<<": mean number of Picard iterations = "<<
+        static_cast<double>(iterations)/cells<<" (over "<<cells<<" predictor evaluations)");
+  }
+}
+
+void exahype::solvers::ADERDGSolver::logLocalTimeSteppingStatistics() {
+  const long int updates        = _localTimeSteppingUpdates.exchange(0);
+  const long int skippedUpdates = _localTimeSteppingSkippedUpdates.exchange(0);
+  const long int merges         = _localTimeSteppingMerges.exchange(0);
+  const long int skippedMerges  = _localTimeSteppingSkippedMerges.exchange(0);
+  const double   cellTime       = _localTimeSteppingCellTime.exchange(0) * 1e-9;
+  const double   mergeTime      = _localTimeSteppingMergeTime.exchange(0) * 1e-9;
+  if ( updates > 0 ) {
+    logInfo("logLocalTimeSteppingStatistics()","solver "<<getIdentifier()<<": local time stepping performed "<<updates<<
+        " cell updates and skipped "<<skippedUpdates<<"; performed "<<merges<<" face merges and skipped "<<skippedMerges);
+    // the global time stepping would perform all updates and merges at the measured cost per update and merge
+    const double timePerUpdate  = cellTime / updates;
+    const double timePerMerge   = ( merges > 0 ) ? mergeTime / merges : 0.0;
+    const double estimatedGlobalTime = timePerUpdate * (updates+skippedUpdates) + timePerMerge * (merges+skippedMerges);
+    logInfo("logLocalTimeSteppingStatistics()","solver "<<getIdentifier()<<": measured "<<cellTime<<" s in cell updates ("<<
+        timePerUpdate*1e6<<" us each) and "<<mergeTime<<" s in face merges ("<<timePerMerge*1e6<<" us each); "
+        "estimated speed-up w.r.t. global time stepping = "<<estimatedGlobalTime/(cellTime+mergeTime));
+  }
+}
+
 double exahype::solvers::ADERDGSolver::getPreviousMinTimeStepSize() const {
   return _previousMinTimeStepSize;
 }
@@ -710,7 +835,8 @@ void exahype::solvers::ADERDGSolver::fusedTimeStepBody(
   }
   #endif
 
-  correction(cellDescription,boundaryMarkers,isFirstTimeStepOfBatch,isFirstTimeStepOfBatch/*addSurfaceIntegralContributionToUpdate*/);
+  correction(cellDescription,boundaryMarkers,isFirstTimeStepOfBatch,
+      isFirstTimeStepOfBatch || cellDescription.getIsInert()/*addSurfaceIntegralContributionToUpdate*/);
 
   UpdateResult result;
   result._timeStepSize    = startNewTimeStep(cellDescription,isFirstTimeStepOfBatch);
@@ -719,21 +845,28 @@ void exahype::solvers::ADERDGSolver::fusedTimeStepBody(
 
   reduce(cellDescription,result);
 
-  if (
+  determineIfCellIsInert(cellDescription,boundaryMarkers);
+
+  if ( deactivateIfInert(cellDescription) ) {
+    compress(cellDescription,isSkeletonCell);
+    cellDescription.setHasCompletedLastStep(true);
+  }
+  else if (
       SpawnPredictionAsBackgroundJob &&
       !mustBeDoneImmediately &&
-      isLastTimeStepOfBatch // only spawned in last iteration if a FusedTimeStepJob was spawned before
+      isLastTimeStepOfBatch && // only spawned in last iteration if a FusedTimeStepJob was spawned before
+      !usePredictorWaveSpeedsForTimeStepSize() // the predictor must be reduced before the time step is wrapped up
   ) {
     const int element = cellInfo.indexOfADERDGCellDescription(cellDescription.getSolverNumber());
     peano::datatraversal::TaskSet( new PredictionJob(
         *this, cellDescription, cellInfo._cellDescriptionsIndex,element,
         predictionTimeStamp, predictionTimeStepSize,
-        false/*is uncompressed*/, isSkeletonCell, isLastTimeStepOfBatch/*addVolumeIntegralResultToUpdate*/ ) );
+        false/*is uncompressed*/, isSkeletonCell, isLastTimeStepOfBatch || cellDescription.getIsInert()/*addVolumeIntegralResultToUpdate*/ ) );
   } else {
     predictionAndVolumeIntegralBody(
         cellDescription,
         predictionTimeStamp, predictionTimeStepSize,
-        false, isSkeletonCell, isLastTimeStepOfBatch/*addVolumeIntegralResultToUpdate*/);
+        false, isSkeletonCell, isLastTimeStepOfBatch || cellDescription.getIsInert()/*addVolumeIntegralResultToUpdate*/);
   }
 
   #ifdef USE_ITAC
@@ -757,7 +890,13 @@ void exahype::solvers::ADERDGSolver::fusedTimeStepOrRestrict(
     synchroniseTimeStepping(cellDescription);
     cellDescription.setHasCompletedLastStep(false);
 
-    if ( cellDescription.getType()==CellDescription::Type::Leaf ) {
+    if ( cellDescription.getType()==CellDescription::Type::Leaf && cellDescription.getIsInactive() ) {
+      uncompress(cellDescription);
+      skipUpdateOfInactiveCell(cellDescription);
+      reduce(cellDescription,UpdateResult()); // the kept solution still contributes to the global observables
+      compress(cellDescription,false);
+      cellDescription.setHasCompletedLastStep(true);
+    } else if ( cellDescription.getType()==CellDescription::Type::Leaf ) {
       const bool isAMRSkeletonCell     = belongsToAMRSkeleton(cellDescription);
       const bool isAtRemoteBoundary    = tarch::la::oneEquals(boundaryMarkers,exahype::mappings::LevelwiseAdjacencyBookkeeping::RemoteAdjacencyIndex);
       const bool isSkeletonCell        = isAMRSkeletonCell || isAtRemoteBoundary;
@@ -822,7 +961,12 @@ void exahype::solvers::ADERDGSolver::updateBody(
   assertion1(cellDescription.getType()==CellDescription::Type::Leaf,cellDescription.toString());
   uncompress(cellDescription);
 
-  correction(cellDescription,boundaryMarkers,true,false/*effect: add face integral result directly to solution*/);
+  const std::chrono::high_resolution_clock::time_point timeStart = std::chrono::high_resolution_clock::now();
+  correction(cellDescription,boundaryMarkers,true,
+      getTimeStepping()==TimeStepping::Local || cellDescription.getIsInert()/*effect: add face integral result to update; otherwise directly to solution*/);
+  if ( getTimeStepping()==TimeStepping::Local ) {
+    _localTimeSteppingCellTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now()-timeStart).count();
+  }
 
   UpdateResult result;
   result._timeStepSize    = startNewTimeStep(cellDescription,true);
@@ -831,6 +975,8 @@ void exahype::solvers::ADERDGSolver::updateBody(
 
   reduce(cellDescription,result);
 
+  determineIfCellIsInert(cellDescription,boundaryMarkers);
+
   const bool isAtRemoteBoundary = tarch::la::oneEquals(boundaryMarkers,mappings::LevelwiseAdjacencyBookkeeping::RemoteAdjacencyIndex);
   compress(cellDescription,isAtRemoteBoundary);
 
@@ -852,7 +998,22 @@ void exahype::solvers::ADERDGSolver::updateOrRestrict(
     cellDescription.setHasCompletedLastStep(false);
 
     const bool isAtRemoteBoundary = tarch::la::oneEquals(boundaryMarkers,exahype::mappings::LevelwiseAdjacencyBookkeeping::RemoteAdjacencyIndex);
-    if ( cellDescription.getType()==CellDescription::Type::Leaf && SpawnUpdateAsBackgroundJob ) {
+    const bool isDue              = isDueForUpdate(cellDescription);
+    if ( cellDescription.getType()==CellDescription::Type::Leaf && getTimeStepping()==TimeStepping::Local ) {
+      if ( isDue ) { _localTimeSteppingUpdates++; } else { _localTimeSteppingSkippedUpdates++; }
+    }
+
+    if ( cellDescription.getType()==CellDescription::Type::Leaf && !isDue ) {
+      cellDescription.setHasCompletedLastStep(true); // cell is in the middle of its time step
+    }
+    else if ( cellDescription.getType()==CellDescription::Type::Leaf && cellDescription.getIsInactive() ) {
+      uncompress(cellDescription);
+      skipUpdateOfInactiveCell(cellDescription);
+      reduce(cellDescription,UpdateResult()); // the kept solution still contributes to the global observables
+      compress(cellDescription,isAtRemoteBoundary);
+      cellDescription.setHasCompletedLastStep(true);
+    }
+    else if ( cellDescription.getType()==CellDescription::Type::Leaf && SpawnUpdateAsBackgroundJob ) {
       peano::datatraversal::TaskSet ( new UpdateJob(*this,cellDescription,cellInfo,boundaryMarkers) );
     }
     else if ( cellDescription.getType()==CellDescription::Type::Leaf ) {
@@ -872,6 +1033,62 @@ void exahype::solvers::ADERDGSolver::updateOrRestrict(
   }
 }
 
+void exahype::solvers::ADERDGSolver::determineIfCellIsInert(
+    CellDescription&                                   cellDescription,
+    const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers) {
+  assertion1(cellDescription.getType()==CellDescription::Type::Leaf,cellDescription.toString());
+  const bool isAtBoundary =
+      tarch::la::oneEquals(boundaryMarkers,mappings::LevelwiseAdjacencyBookkeeping::DomainBoundaryAdjacencyIndex) ||
+      tarch::la::oneEquals(boundaryMarkers,mappings::LevelwiseAdjacencyBookkeeping::RemoteAdjacencyIndex);
+  cellDescription.setIsInert(
+      !isAtBoundary &&
+      getTimeStepping()!=TimeStepping::Local &&
+      cellDescription.getRefinementStatus()<_minRefinementStatusForTroubledCell-2 &&
+      isInert(
+          static_cast<double*>(cellDescription.getSolution()),
+          cellDescription.getOffset()+0.5*cellDescription.getSize(),
+          cellDescription.getSize()));
+}
+
+bool exahype::solvers::ADERDGSolver::deactivateIfInert(CellDescription& cellDescription) {
+  const bool deactivate =
+      cellDescription.getIsInert() &&
+      !cellDescription.getHasNonInertNeighbour() &&
+      cellDescription.getRefinementStatus()<_minRefinementStatusForTroubledCell-2 && // might have changed since the update
+      cellDescription.getAugmentationStatus()==0;
+  cellDescription.setHasNonInertNeighbour(false);
+  cellDescription.setIsInactive(deactivate);
+  return deactivate;
+}
+
+void exahype::solvers::ADERDGSolver::reactivate(CellDescription& cellDescription) {
+  if ( cellDescription.getIsInactive() ) {
+    if ( cellDescription.tryToClaimReactivation() ) {
+      if ( cellDescription.getIsInactive() ) { // another merge might have reactivated the cell in the meantime
+        const auto predictionTimeStepData = getPredictionTimeStepData(cellDescription,false);
+        predictionAndVolumeIntegralBody(
+            cellDescription,
+            std::get<0>(predictionTimeStepData),std::get<1>(predictionTimeStepData),
+            true/*uncompressBefore*/,false/*isSkeletonCell*/,true/*addVolumeIntegralResultToUpdate*/);
+        cellDescription.setIsInactive(false);
+      }
+      cellDescription.releaseReactivation();
+    }
+    while ( cellDescription.getIsInactive() ) { // another merge computes the prediction
+      std::this_thread::yield();
+    }
+  }
+}
+
+void exahype::solvers::ADERDGSolver::skipUpdateOfInactiveCell(CellDescription& cellDescription) {
+  assertion1(cellDescription.getIsInactive(),cellDescription.toString());
+  std::copy_n(
+      static_cast<double*>(cellDescription.getSolution()),getDataPerCell(),
+      static_cast<double*>(cellDescription.getPreviousSolution()));
+  cellDescription.setNeighbourMergePerformed(static_cast<signed char>(false));
+  cellDescription.setSkippedFaces(0);
+}
+
 void exahype::solvers::ADERDGSolver::compress(
       const int solverNumber,
       CellInfo& cellInfo,
@@ -900,6 +1117,8 @@ int exahype::solvers::ADERDGSolver::predictionAndVolumeIntegralBody(
     VT_begin(predictorBodyHandle);
   }
   #endif
+  profilers::ScopedTag profilingScope(*_profiler,ProfilingPhase::Predictor);
+
   if (uncompressBefore) { uncompress(cellDescription); }
 
   validateCellDescriptionData(cellDescription,true,false,true,"exahype::solvers::ADERDGSolver::performPredictionAndVolumeIntegralBody [pre]");
@@ -921,6 +1140,11 @@ int exahype::solvers::ADERDGSolver::predictionAndVolumeIntegralBody(
   counter++;
   #endif
 
+  const bool reduceAdmissibleTimeStepSize =
+      usePredictorWaveSpeedsForTimeStepSize() && getTimeStepping()!=TimeStepping::GlobalFixed;
+  double admissibleTimeStepSize = std::numeric_limits<double>::infinity();
+
+  const std::chrono::high_resolution_clock::time_point timeStart = std::chrono::high_resolution_clock::now();
   const int numberOfPicardIterations = fusedSpaceTimePredictorVolumeIntegral(
       lduh,lQhbnd,lGradQhbnd,lFhbnd,
       luh,
@@ -928,7 +1152,20 @@ int exahype::solvers::ADERDGSolver::predictionAndVolumeIntegralBody(
       cellDescription.getSize(),
       predictorTimeStamp,
       predictorTimeStepSize,
-      addVolumeIntegralResultToUpdate); // TODO(Dominic): fix 'false' case
+      addVolumeIntegralResultToUpdate, // TODO(Dominic): fix 'false' case
+      reduceAdmissibleTimeStepSize ? &admissibleTimeStepSize : nullptr);
+  if ( getTimeStepping()==TimeStepping::Local ) {
+    _localTimeSteppingCellTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now()-timeStart).count();
+  }
+
+  if ( numberOfPicardIterations > 0 ) { // linear kernels do not iterate
+    const int bin = std::min(numberOfPicardIterations,PicardIterationsHistogramBins)-1;
+    _picardIterationsHistogram[bin]++;
+  }
+  if ( reduceAdmissibleTimeStepSize ) {
+    assertion2(!_checkForNaNs || admissibleTimeStepSize>0,admissibleTimeStepSize,cellDescription.toString());
+    updateAdmissibleTimeStepSize(admissibleTimeStepSize);
+  }
 
   compress(cellDescription,isSkeletonCell);
 
@@ -961,6 +1198,7 @@ void exahype::solvers::ADERDGSolver::predictionAndVolumeIntegral(
 
   if ( cellDescription.getType()==CellDescription::Type::Leaf ) {
     cellDescription.setHasCompletedLastStep(false);
+    cellDescription.setIsInactive(false);
 
     const bool isAMRSkeletonCell     = belongsToAMRSkeleton(cellDescription);
     const bool isSkeletonCell        = isAMRSkeletonCell || isAtRemoteBoundary;
@@ -993,11 +1231,17 @@ void exahype::solvers::ADERDGSolver::predictionAndVolumeIntegral(
     const bool isAMRSkeletonCell = belongsToAMRSkeleton(cellDescription);
     const bool isSkeletonCell    = isAMRSkeletonCell || isAtRemoteBoundary;
     waitUntilCompletedLastStep(cellDescription,isSkeletonCell,false);
-    if ( cellDescription.getType()==CellDescription::Type::Leaf ) {
+    if (
+        cellDescription.getType()==CellDescription::Type::Leaf &&
+        isStartingTimeStep(cellDescription) &&
+        !deactivateIfInert(cellDescription)
+    ) {
       const auto predictionTimeStepData = getPredictionTimeStepData(cellDescription,false); // this is either the fused scheme or a predictor recomputation
 
-      const bool rollbacksPossible = !OnlyInitialMeshRefinement;
-      if ( !FuseAllADERDGPhases && rollbacksPossible ) { // backup previous solution here as prediction already adds a contribution to solution if not all alg. phases are fused.
+      const bool rollbacksPossible               = !OnlyInitialMeshRefinement;
+      const bool addVolumeIntegralResultToUpdate =
+          FuseAllADERDGPhases || getTimeStepping()==TimeStepping::Local || cellDescription.getIsInert();
+      if ( !addVolumeIntegralResultToUpdate && rollbacksPossible ) { // backup previous solution here as prediction already adds a contribution to solution if not all alg. phases are fused.
         std::copy_n(
             static_cast<double*>(cellDescription.getSolution()),getDataPerCell(),
             static_cast<double*>(cellDescription.getPreviousSolution()));
@@ -1007,7 +1251,7 @@ void exahype::solvers::ADERDGSolver::predictionAndVolumeIntegral(
           std::get<0>(predictionTimeStepData),
           std::get<1>(predictionTimeStepData),
           true,isAtRemoteBoundary,
-          FuseAllADERDGPhases/*addVolumeIntegralResultToUpdate*/);
+          addVolumeIntegralResultToUpdate);
     }
   }
 }
@@ -1041,7 +1285,9 @@ double exahype::solvers::ADERDGSolver::startNewTimeStep(
   }
   // n
   cellDescription.setTimeStamp(cellDescription.getTimeStamp()+cellDescription.getTimeStepSize());
-  if ( getTimeStepping() != TimeStepping::GlobalFixed ) {
+  if ( getTimeStepping() != TimeStepping::GlobalFixed && usePredictorWaveSpeedsForTimeStepSize() ) {
+    return std::numeric_limits<double>::infinity(); // reduced from the predictor, see predictionAndVolumeIntegralBody
+  } else if ( getTimeStepping() != TimeStepping::GlobalFixed ) {
     double admissibleTimeStepSize = computeTimeStepSize(cellDescription);
     cellDescription.setTimeStepSize(admissibleTimeStepSize);
     return admissibleTimeStepSize;
@@ -1083,6 +1329,10 @@ void exahype::solvers::ADERDGSolver::rollbackToPreviousTimeStep(CellDescription&
 
   cellDescription.setPreviousTimeStamp(std::numeric_limits<double>::infinity());
   cellDescription.setPreviousTimeStepSize(std::numeric_limits<double>::infinity());
+
+  // the flags refer to the discarded solution
+  cellDescription.setIsInert(false);
+  cellDescription.setIsInactive(false);
 }
 
 void exahype::solvers::ADERDGSolver::adjustSolution(CellDescription& cellDescription) {
@@ -1214,8 +1464,22 @@ void exahype::solvers::ADERDGSolver::surfaceIntegral(
       if ( boundaryMarkers[faceIndex]==mappings::LevelwiseAdjacencyBookkeeping::DomainBoundaryAdjacencyIndex ) {
         mergeWithBoundaryData(cellDescription,faceIndex,direction,orientation);
       }
-      // perform face integral
-      if ( cellDescription.getFacewiseAugmentationStatus(faceIndex)<MaximumAugmentationStatus ) { // ignore Ancestors
+      // perform face integral; local time stepping: interior faces integrate what the neighbour merges accumulated
+      const bool useAccumulatedFluctuations =
+          getTimeStepping()==TimeStepping::Local &&
+          boundaryMarkers[faceIndex]!=mappings::LevelwiseAdjacencyBookkeeping::DomainBoundaryAdjacencyIndex;
+      if ( useAccumulatedFluctuations ) {
+        double* const accumulatedFluctuation = static_cast<double*>(cellDescription.getAccumulatedFluctuation()) + dofsPerFace * faceIndex;
+        if ( cellDescription.getFacewiseAugmentationStatus(faceIndex)<MaximumAugmentationStatus ) { // ignore Ancestors
+          faceIntegral(output,accumulatedFluctuation,direction,orientation,0/*implicit conversion*/,0,cellDescription.getSize(),
+                       cellDescription.getTimeStepSize(),addToUpdate);
+        }
+        std::fill_n(accumulatedFluctuation,dofsPerFace,0.0);
+      }
+      else if (
+          cellDescription.getFacewiseAugmentationStatus(faceIndex)<MaximumAugmentationStatus && // ignore Ancestors
+          ((cellDescription.getSkippedFaces() >> faceIndex) & 1)==0 // zero flux between inert cells
+      ) {
         double* const lFhbnd = static_cast<double*>(cellDescription.getFluctuation()) + dofsPerFace * faceIndex;
         faceIntegral(output,lFhbnd,direction,orientation,0/*implicit conversion*/,0,cellDescription.getSize(),
                      cellDescription.getTimeStepSize(),addToUpdate);
@@ -1230,6 +1494,7 @@ void exahype::solvers::ADERDGSolver::surfaceIntegral(
   }
   assertion1( tarch::la::equals(cellDescription.getNeighbourMergePerformed(),static_cast<signed char>(true)) || ProfileUpdate,cellDescription.toString());
   cellDescription.setNeighbourMergePerformed(static_cast<signed char>(false));
+  cellDescription.setSkippedFaces(0);
 
   #ifdef Asserts
   if ( _checkForNaNs ) {
@@ -1283,6 +1548,8 @@ void exahype::solvers::ADERDGSolver::correction(
     const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers,
     const bool                                         backupPreviousSolution,
     const bool                                         addSurfaceIntegralResultToUpdate) {
+  profilers::ScopedTag profilingScope(*_profiler,ProfilingPhase::Update);
+
   assertion1(cellDescription.getType()==CellDescription::Type::Leaf,cellDescription.toString())
   assertion1(std::isfinite(cellDescription.getTimeStamp()   ),cellDescription.toString());
   assertion1(std::isfinite(cellDescription.getTimeStepSize()),cellDescription.toString());
@@ -1586,6 +1853,103 @@ void exahype::solvers::ADERDGSolver::rollbackSolutionGlobally(const int solverNu
   }
 }
 
+std::array<int,9> exahype::solvers::ADERDGSolver::getSnapshotIndices(const CellDescription& cellDescription) const {
+  return {{
+    cellDescription.getPreviousSolutionIndex(), cellDescription.getSolutionIndex(), cellDescription.getUpdateIndex(),
+    cellDescription.getExtrapolatedPredictorIndex(), cellDescription.getFluctuationIndex(),
+    isUseViscousFlux() ? cellDescription.getExtrapolatedPredictorGradientIndex() : -1,
+    cellDescription.getAccumulatedFluctuationIndex(),
+    cellDescription.getSolutionMinIndex(), cellDescription.getSolutionMaxIndex() }};
+}
+
+void exahype::solvers::ADERDGSolver::storeSnapshot() {
+  _snapshot.previousMinTimeStamp    = _previousMinTimeStamp;
+  _snapshot.previousMinTimeStepSize = _previousMinTimeStepSize;
+  _snapshot.minTimeStamp            = _minTimeStamp;
+  _snapshot.minTimeStepSize         = _minTimeStepSize;
+  _snapshot.estimatedTimeStepSize   = _estimatedTimeStepSize;
+  _snapshot.admissibleTimeStepSize  = _admissibleTimeStepSize;
+  _snapshot.localTimeStep           = _localTimeStep;
+  _snapshot.localTimeSteppingLevels = _localTimeSteppingLevels;
+  _snapshot.meshUpdateEvent         = _meshUpdateEvent;
+  _snapshot.globalObservables       = _globalObservables;
+  _snapshot.cells.clear();
+}
+
+void exahype::solvers::ADERDGSolver::storeSnapshot(const int solverNumber,CellInfo& cellInfo) {
+  const int element = cellInfo.indexOfADERDGCellDescription(solverNumber);
+  if ( element != NotFound ) {
+    CellDescription& cellDescription = cellInfo._ADERDGCellDescriptions[element];
+    uncompress(cellDescription);
+
+    auto& snapshot = _snapshot.cells[cellInfo._cellDescriptionsIndex];
+    snapshot.first = cellDescription;
+    snapshot.second.clear();
+    for (int index : getSnapshotIndices(cellDescription)) {
+      snapshot.second.push_back( index>=0 ? getDataHeapEntries(index) : DataHeap::HeapEntries() );
+    }
+  }
+}
+
+void exahype::solvers::ADERDGSolver::restoreFromSnapshot() {
+  _previousMinTimeStamp    = _snapshot.previousMinTimeStamp;
+  _previousMinTimeStepSize = _snapshot.previousMinTimeStepSize;
+  _minTimeStamp            = _snapshot.minTimeStamp;
+  _minTimeStepSize         = _snapshot.minTimeStepSize;
+  _estimatedTimeStepSize   = _snapshot.estimatedTimeStepSize;
+  _admissibleTimeStepSize  = _snapshot.admissibleTimeStepSize;
+  _localTimeStep           = _snapshot.localTimeStep;
+  _localTimeSteppingLevels = _snapshot.localTimeSteppingLevels;
+  _meshUpdateEvent         = _snapshot.meshUpdateEvent;
+  _globalObservables       = _snapshot.globalObservables;
+}
+
+void exahype::solvers::ADERDGSolver::restoreFromSnapshot(const int solverNumber,CellInfo& cellInfo) {
+  const int element = cellInfo.indexOfADERDGCellDescription(solverNumber);
+  if ( element != NotFound ) {
+    CellDescription& cellDescription = cellInfo._ADERDGCellDescriptions[element];
+    auto snapshot = _snapshot.cells.find(cellInfo._cellDescriptionsIndex);
+    if (
+        snapshot == _snapshot.cells.end() ||
+        snapshot->second.first.getType()  != cellDescription.getType() ||
+        snapshot->second.first.getLevel() != cellDescription.getLevel()
+    ) {
+      logWarning("restoreFromSnapshot(...)","cell description was created or changed after the snapshot was stored. Do not restore it. "
+          "cell description="<<cellDescription.toString());
+      return;
+    }
+    uncompress(cellDescription);
+
+    const CellDescription& stored = snapshot->second.first;
+    cellDescription.setTimeStamp(stored.getTimeStamp());
+    cellDescription.setTimeStepSize(stored.getTimeStepSize());
+    cellDescription.setPreviousTimeStamp(stored.getPreviousTimeStamp());
+    cellDescription.setPreviousTimeStepSize(stored.getPreviousTimeStepSize());
+    cellDescription.setRefinementStatus(stored.getRefinementStatus());
+    cellDescription.setPreviousRefinementStatus(stored.getPreviousRefinementStatus());
+    cellDescription.setFacewiseRefinementStatus(stored.getFacewiseRefinementStatus());
+    cellDescription.setNeighbourMergePerformed(stored.getNeighbourMergePerformed());
+    cellDescription.setSkippedFaces(stored.getSkippedFaces());
+    cellDescription.setIsInert(stored.getIsInert());
+    cellDescription.setIsInactive(stored.getIsInactive());
+    cellDescription.setHasNonInertNeighbour(stored.getHasNonInertNeighbour());
+
+    const std::array<int,9> indices = getSnapshotIndices(cellDescription);
+    for (unsigned int i = 0; i < indices.size(); i++) {
+      const DataHeap::HeapEntries& storedEntries = snapshot->second.second[i];
+      if ( indices[i]>=0 && !storedEntries.empty() ) {
+        DataHeap::HeapEntries& entries = getDataHeapEntries(indices[i]);
+        assertionEquals2(entries.size(),storedEntries.size(),i,cellDescription.toString());
+        std::copy(storedEntries.begin(),storedEntries.end(),entries.begin());
+      }
+    }
+  }
+}
+
+void exahype::solvers::ADERDGSolver::deleteSnapshot() {
+  _snapshot = Snapshot();
+}
+
 void exahype::solvers::ADERDGSolver::mergeWithNeighbourMetadata(
     const int                                    solverNumber,
     Solver::CellInfo&                            cellInfo, // corresponds to dest
@@ -1680,7 +2044,12 @@ void exahype::solvers::ADERDGSolver::mergeNeighboursData(
     CellDescription& cellDescription1 = cellInfo1._ADERDGCellDescriptions[element1];
     CellDescription& cellDescription2 = cellInfo2._ADERDGCellDescriptions[element2];
 
-    if ( ADERDGSolver::communicateWithNeighbour(cellDescription1,face._faceIndex1) ) {
+    const bool communicate = ADERDGSolver::communicateWithNeighbour(cellDescription1,face._faceIndex1);
+    const bool isDue       = isDueForUpdate(cellDescription1) || isDueForUpdate(cellDescription2); // local time stepping: skip if both cells are in the middle of their time step
+    if ( communicate && !isDue ) {
+      _localTimeSteppingSkippedMerges++;
+    }
+    if ( communicate && isDue ) {
       assertion1( ADERDGSolver::communicateWithNeighbour(cellDescription2,face._faceIndex2),cellDescription2.toString() );
 
       prefetchFaceData(cellDescription1,face._faceIndex1);
@@ -1700,26 +2069,49 @@ void exahype::solvers::ADERDGSolver::mergeNeighboursData(
       waitUntilCompletedLastStep<CellDescription>(cellDescription1,false,false);  // must be done before any other operation on the patches
       waitUntilCompletedLastStep<CellDescription>(cellDescription2,false,false);
 
-      if ( CompressionAccuracy > 0.0 ) {
-        peano::datatraversal::TaskSet uncompression(
-            [&] () -> bool {
-          uncompress(cellDescription1);
-          return false;
-        },
-        [&] () -> bool {
-          uncompress(cellDescription1);
-          return false;
-        },
-        peano::datatraversal::TaskSet::TaskType::Background,
-        peano::datatraversal::TaskSet::TaskType::Background,
-        true
-        );
-      }
+      // inert cells: zero flux if an inactive cell borders an inert cell; reactivate inactive cells otherwise
+      const bool isInert1 = isLeaf(cellDescription1) && cellDescription1.getIsInert();
+      const bool isInert2 = isLeaf(cellDescription2) && cellDescription2.getIsInert();
+      if ( !isInert2 ) { cellDescription1.setHasNonInertNeighbour(true); }
+      if ( !isInert1 ) { cellDescription2.setHasNonInertNeighbour(true); }
+      if (
+          isInert1 && isInert2 &&
+          (cellDescription1.getIsInactive() || cellDescription2.getIsInactive())
+      ) {
+        cellDescription1.markFaceAsSkipped(face._faceIndex1);
+        cellDescription2.markFaceAsSkipped(face._faceIndex2);
+      } else {
+        reactivate(cellDescription1);
+        reactivate(cellDescription2);
+
+        if ( CompressionAccuracy > 0.0 ) {
+          peano::datatraversal::TaskSet uncompression(
+              [&] () -> bool {
+            uncompress(cellDescription1);
+            return false;
+          },
+          [&] () -> bool {
+            uncompress(cellDescription2);
+            return false;
+          },
+          peano::datatraversal::TaskSet::TaskType::Background,
+          peano::datatraversal::TaskSet::TaskType::Background,
+          true
+          );
+        }
 
-      //
-      // 1. Solve Riemann problem (merge data)
-      //
-      solveRiemannProblemAtInterface(cellDescription1,cellDescription2,face);
+        //
+        // 1. Solve Riemann problem (merge data)
+        //
+        if ( getTimeStepping()==TimeStepping::Local ) {
+          const std::chrono::high_resolution_clock::time_point timeStart = std::chrono::high_resolution_clock::now();
+          solveRiemannProblemAtInterface(cellDescription1,cellDescription2,face);
+          _localTimeSteppingMergeTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now()-timeStart).count();
+          _localTimeSteppingMerges++;
+        } else {
+          solveRiemannProblemAtInterface(cellDescription1,cellDescription2,face);
+        }
+      }
     }
 
      cellDescription1.setNeighbourMergePerformed(face._faceIndex1,true);
@@ -1767,6 +2159,8 @@ void exahype::solvers::ADERDGSolver::solveRiemannProblemAtInterface(
     CellDescription& cellDescription1,
     CellDescription& cellDescription2,
     Solver::InterfaceInfo& face) {
+  profilers::ScopedTag profilingScope(*_profiler,ProfilingPhase::Riemann);
+
   CellDescription& pLeft  =
       (face._orientation1==1) ? cellDescription1 : cellDescription2;
   CellDescription& pRight =
@@ -1799,13 +2193,35 @@ void exahype::solvers::ADERDGSolver::solveRiemannProblemAtInterface(
   #endif
 
   std::tuple<double,double> timeStepData = getRiemannSolverTimeStepData(pLeft,pRight);
-  riemannSolver(
-      FL,FR,QL,QR,
-      std::get<0>(timeStepData),
-      std::get<1>(timeStepData),
-      pLeft.getSize(),
-      face._direction, false, -1); // TODO(Dominic): Merge Riemann solver directly with the face integral and push the result on update
-                                   // does not make sense to overwrite the flux when performing local time stepping; coarse grid flux must be constant, or not?
+  if ( _timeStepping==TimeStepping::Local ) {
+    // The predictor fluxes of a cell which is in the middle of its time step are required again
+    // by later merges. We thus solve the Riemann problem on thread-local copies and accumulate
+    // the fluctuations, weighted with the face's time step size, per face of both cells.
+    static thread_local std::vector<double> FLCopy;
+    static thread_local std::vector<double> FRCopy;
+    FLCopy.resize(dofsPerFace);
+    FRCopy.resize(dofsPerFace);
+    std::copy_n(FL,dofsPerFace,FLCopy.begin());
+    std::copy_n(FR,dofsPerFace,FRCopy.begin());
+    riemannSolver(
+        FLCopy.data(),FRCopy.data(),QL,QR,
+        std::get<0>(timeStepData),
+        std::get<1>(timeStepData),
+        pLeft.getSize(),
+        face._direction, false, -1);
+    accumulateFluctuations(pLeft,FLCopy.data(),face._faceIndexLeft,std::get<1>(timeStepData)/pLeft.getTimeStepSize());
+    accumulateFluctuations(pRight,FRCopy.data(),face._faceIndexRight,std::get<1>(timeStepData)/pRight.getTimeStepSize());
+    FL = FLCopy.data(); // for the checks below
+    FR = FRCopy.data();
+  } else {
+    riemannSolver(
+        FL,FR,QL,QR,
+        std::get<0>(timeStepData),
+        std::get<1>(timeStepData),
+        pLeft.getSize(),
+        face._direction, false, -1); // TODO(Dominic): Merge Riemann solver directly with the face integral and push the result on update
+                                     // does not make sense to overwrite the flux when performing local time stepping; coarse grid flux must be constant, or not?
+  }
 
   #ifdef Asserts
   if ( _checkForNaNs ) { // assumes the solver is used as part of the hybrid solver
@@ -1824,6 +2240,19 @@ void exahype::solvers::ADERDGSolver::solveRiemannProblemAtInterface(
   #endif
 }
 
+void exahype::solvers::ADERDGSolver::accumulateFluctuations(
+    CellDescription&    cellDescription,
+    const double* const lFhbnd,
+    const int           faceIndex,
+    const double        weight) {
+  assertion1(DataHeap::getInstance().isValidIndex(cellDescription.getAccumulatedFluctuationIndex()),cellDescription.toString());
+  const int dofsPerFace = getBndFluxSize();
+  double* const accumulatedFluctuation = static_cast<double*>(cellDescription.getAccumulatedFluctuation()) + dofsPerFace * faceIndex;
+  for (int i = 0; i < dofsPerFace; i++) {
+    accumulatedFluctuation[i] += weight * lFhbnd[i];
+  }
+}
+
 void exahype::solvers::ADERDGSolver::mergeWithBoundaryData(CellDescription& cellDescription,const int faceIndex,const int direction,const int orientation) {
   assertion1(cellDescription.getType()==CellDescription::Type::Leaf,cellDescription.toString());
   applyBoundaryConditions(cellDescription,faceIndex,direction,orientation);
@@ -1836,6 +2265,8 @@ void exahype::solvers::ADERDGSolver::mergeWithBoundaryData(CellDescription& cell
 }
 
 void exahype::solvers::ADERDGSolver::applyBoundaryConditions(CellDescription& cellDescription,const int faceIndex,const int direction,const int orientation) {
+  profilers::ScopedTag profilingScope(*_profiler,ProfilingPhase::Riemann);
+
   assertion1(cellDescription.getType()==CellDescription::Type::Leaf,cellDescription.toString());
   assertion1(DataHeap::getInstance().isValidIndex(cellDescription.getExtrapolatedPredictorIndex()),cellDescription.toString());
   assertion1(DataHeap::getInstance().isValidIndex(cellDescription.getFluctuationIndex()),cellDescription.toString());
@@ -2029,6 +2460,8 @@ void exahype::solvers::ADERDGSolver::solveRiemannProblemAtInterface(
     const double* const lQhbnd,
     const double* const lFhbnd,
     const int fromRank) {
+  profilers::ScopedTag profilingScope(*_profiler,ProfilingPhase::Riemann);
+
   logDebug("solveRiemannProblemAtInterface(...)",
       "cell-description=" << cellDescription.toString());
 
@@ -2338,6 +2771,10 @@ bool exahype::solvers::ADERDGSolver::CompressionJob::run(bool runOnMasterThread)
   _solver.determineUnknownAverages(_cellDescription);
   _solver.computeHierarchicalTransform(_cellDescription,-1.0);
   _solver.putUnknownsIntoByteStream(_cellDescription);
+  // uncompress(...) polls the state under the heap semaphore
+  tarch::multicore::Lock lock(exahype::HeapSemaphore);
+    _cellDescription.setCompressionState(CellDescription::Compressed);
+  lock.free();
 
   if (_isSkeletonJob) {
     NumberOfSkeletonJobs.fetch_sub(1);
@@ -2355,15 +2792,7 @@ void exahype::solvers::ADERDGSolver::compress( CellDescription& cellDescription,
   if (CompressionAccuracy>0.0) {
     if ( SpawnCompressionAsBackgroundJob ) {
       cellDescription.setCompressionState(CellDescription::CurrentlyProcessed);
-      CompressionJob compressionJob( *this, cellDescription, isSkeletonCell );
-      assertionMsg( false, "this call is invalid" );
-/*
-      if ( isSkeletonCell ) {
-        peano::datatraversal::TaskSet spawnedSet( compressionJob, peano::datatraversal::TaskSet::TaskType::IsTaskAndRunAsSoonAsPossible  );
-      } else {
-        peano::datatraversal::TaskSet spawnedSet( compressionJob, peano::datatraversal::TaskSet::TaskType::Background  );
-      }
-*/
+      peano::datatraversal::TaskSet ( new CompressionJob( *this, cellDescription, isSkeletonCell ));
     }
     else {
       determineUnknownAverages(cellDescription);
@@ -2437,6 +2866,13 @@ void exahype::solvers::ADERDGSolver::determineUnknownAverages(
   double* extrapolatedPredictor = static_cast<double*>(cellDescription.getExtrapolatedPredictor());
   double* fluctuation           = static_cast<double*>(cellDescription.getFluctuation());
 
+  // the averages are initialised with NaNs and still hold the previous averages otherwise
+  std::fill_n(solutionAverages,             dataPerNode,                                 0.0);
+  std::fill_n(previousSolutionAverage,      dataPerNode,                                 0.0);
+  std::fill_n(updateAverages,               getNumberOfVariables(),                      0.0);
+  std::fill_n(extrapolatedPredictorAverages,dataPerNode*DIMENSIONS_TIMES_TWO,            0.0);
+  std::fill_n(fluctuationAverages,          getNumberOfVariables()*DIMENSIONS_TIMES_TWO, 0.0);
+
   // patch data
   kernels::idx2 idx_cellData    (nodesPerCell,dataPerNode);
   kernels::idx2 idx_cellUnknowns(nodesPerCell,getNumberOfVariables());
@@ -2545,6 +2981,10 @@ void exahype::solvers::ADERDGSolver::putUnknownsIntoByteStream(
   assertion( cellDescription.getExtrapolatedPredictorCompressedIndex()==-1 );
   assertion( cellDescription.getFluctuationCompressedIndex()==-1 );
 
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,-1.0);
+  #endif
+
   int compressionOfPreviousSolution;
   int compressionOfSolution;
   int compressionOfUpdate;
@@ -2807,6 +3247,10 @@ void exahype::solvers::ADERDGSolver::putUnknownsIntoByteStream(
 	peano::datatraversal::TaskSet::TaskType::Background,
     true
   );
+
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,1.0);
+  #endif
 }
 
 
@@ -2814,89 +3258,84 @@ void exahype::solvers::ADERDGSolver::pullUnknownsFromByteStream(
     CellDescription& cellDescription) const {
   assertion(CompressionAccuracy>0.0);
 
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,-1.0);
+  #endif
+
   #if !defined(ValidateCompressedVsUncompressedData)
+  // arrays which did not compress (7 bytes per DoF) have been kept
+  const bool previousSolutionIsCompressed      = cellDescription.getBytesPerDoFInPreviousSolution()<7;
+  const bool solutionIsCompressed              = cellDescription.getBytesPerDoFInSolution()<7;
+  const bool updateIsCompressed                = cellDescription.getBytesPerDoFInUpdate()<7;
+  const bool extrapolatedPredictorIsCompressed = cellDescription.getBytesPerDoFInExtrapolatedPredictor()<7;
+  const bool fluctuationIsCompressed           = cellDescription.getBytesPerDoFInFluctuation()<7;
+
   const int dataPointsPerCell       = getDataPerCell();
+  const int dataPointsPerBoundary   = getDataPerCellBoundary();
   const int unknownsPerCellBoundary = getUnknownsPerCellBoundary();
 
   {
     tarch::multicore::Lock lock(exahype::HeapSemaphore);
-      cellDescription.setPreviousSolutionIndex( DataHeap::getInstance().createData( dataPointsPerCell, dataPointsPerCell ) );
-      cellDescription.setSolutionIndex( DataHeap::getInstance().createData(         dataPointsPerCell, dataPointsPerCell ) );
-      cellDescription.setUpdateIndex( DataHeap::getInstance().createData(           getUpdateSize(),   getUpdateSize() ) );
-
-      cellDescription.setExtrapolatedPredictorIndex( DataHeap::getInstance().createData( unknownsPerCellBoundary, unknownsPerCellBoundary ) );
-      cellDescription.setFluctuationIndex( DataHeap::getInstance().createData(           unknownsPerCellBoundary, unknownsPerCellBoundary ) );
+      if (previousSolutionIsCompressed) {
+        cellDescription.setPreviousSolutionIndex( DataHeap::getInstance().createData( dataPointsPerCell, dataPointsPerCell ) );
+      }
+      if (solutionIsCompressed) {
+        cellDescription.setSolutionIndex( DataHeap::getInstance().createData( dataPointsPerCell, dataPointsPerCell ) );
+      }
+      if (updateIsCompressed) {
+        cellDescription.setUpdateIndex( DataHeap::getInstance().createData( getUpdateSize(), getUpdateSize() ) );
+      }
+      if (extrapolatedPredictorIsCompressed) {
+        cellDescription.setExtrapolatedPredictorIndex( DataHeap::getInstance().createData( dataPointsPerBoundary, dataPointsPerBoundary ) );
+      }
+      if (fluctuationIsCompressed) {
+        cellDescription.setFluctuationIndex( DataHeap::getInstance().createData( unknownsPerCellBoundary, unknownsPerCellBoundary ) );
+      }
     lock.free();
 
-    if (cellDescription.getPreviousSolutionIndex()==-1) {
+    if (previousSolutionIsCompressed && cellDescription.getPreviousSolutionIndex()==-1) {
       ensureAllJobsHaveTerminated(JobType::SkeletonJob);
       ensureAllJobsHaveTerminated(JobType::EnclaveJob);
       lock.lock();
         cellDescription.setPreviousSolutionIndex( DataHeap::getInstance().createData( dataPointsPerCell, dataPointsPerCell ) );
       lock.free();
     }
-    if (cellDescription.getSolutionIndex()==-1) {
+    if (solutionIsCompressed && cellDescription.getSolutionIndex()==-1) {
       ensureAllJobsHaveTerminated(JobType::SkeletonJob);
       ensureAllJobsHaveTerminated(JobType::EnclaveJob);
       lock.lock();
         cellDescription.setSolutionIndex( DataHeap::getInstance().createData( dataPointsPerCell, dataPointsPerCell ) );
       lock.free();
     }
-    if (cellDescription.getUpdateIndex()==-1) {
+    if (updateIsCompressed && cellDescription.getUpdateIndex()==-1) {
       ensureAllJobsHaveTerminated(JobType::SkeletonJob);
       ensureAllJobsHaveTerminated(JobType::EnclaveJob);
       lock.lock();
         cellDescription.setUpdateIndex( DataHeap::getInstance().createData( getUpdateSize(), getUpdateSize() ) );
       lock.free();
     }
-    if (cellDescription.getExtrapolatedPredictorIndex()==-1) {
+    if (extrapolatedPredictorIsCompressed && cellDescription.getExtrapolatedPredictorIndex()==-1) {
       ensureAllJobsHaveTerminated(JobType::SkeletonJob);
       ensureAllJobsHaveTerminated(JobType::EnclaveJob);
       lock.lock();
-        cellDescription.setExtrapolatedPredictorIndex( DataHeap::getInstance().createData(unknownsPerCellBoundary ) );
+        cellDescription.setExtrapolatedPredictorIndex( DataHeap::getInstance().createData( dataPointsPerBoundary, dataPointsPerBoundary ) );
       lock.free();
     }
-    if (cellDescription.getFluctuationIndex()==-1) {
+    if (fluctuationIsCompressed && cellDescription.getFluctuationIndex()==-1) {
       ensureAllJobsHaveTerminated(JobType::SkeletonJob);
       ensureAllJobsHaveTerminated(JobType::EnclaveJob);
       lock.lock();
         cellDescription.setFluctuationIndex( DataHeap::getInstance().createData( unknownsPerCellBoundary, unknownsPerCellBoundary ) );
       lock.free();
     }
-
-    cellDescription.setPreviousSolution     ( static_cast<void*>(CompressedDataHeap::getInstance().getData(cellDescription.getPreviousSolutionIndex()).data() ) );
-    cellDescription.setSolution             ( static_cast<void*>(CompressedDataHeap::getInstance().getData(cellDescription.getSolutionIndex()).data() ) );
-    cellDescription.setExtrapolatedPredictor( static_cast<void*>(CompressedDataHeap::getInstance().getData(cellDescription.getExtrapolatedPredictorIndex()).data() ) );
-
   }
-  #else
-  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getPreviousSolution() ));
-  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getSolution() ));
-  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getUpdate() ));
-  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getExtrapolatedPredictor() ));
-  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getFluctuation() ));
   #endif
 
-  assertion1(
-      CompressedDataHeap::getInstance().isValidIndex( cellDescription.getPreviousSolutionCompressedIndex() ),
-      cellDescription.getPreviousSolutionCompressedIndex()
-    );
-  assertion1(
-    CompressedDataHeap::getInstance().isValidIndex( cellDescription.getSolutionCompressedIndex() ),
-    cellDescription.getSolutionCompressedIndex()
-  );
-  assertion1(
-    CompressedDataHeap::getInstance().isValidIndex( cellDescription.getUpdateCompressedIndex() ),
-    cellDescription.getUpdateCompressedIndex()
-  );
-  assertion1(
-    CompressedDataHeap::getInstance().isValidIndex( cellDescription.getExtrapolatedPredictorCompressedIndex() ),
-    cellDescription.getExtrapolatedPredictorCompressedIndex()
-  );
-  assertion1(
-    CompressedDataHeap::getInstance().isValidIndex( cellDescription.getFluctuationCompressedIndex() ),
-    cellDescription.getFluctuationCompressedIndex()
-  );
+  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getPreviousSolutionIndex() ));
+  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getSolutionIndex() ));
+  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getUpdateIndex() ));
+  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getExtrapolatedPredictorIndex() ));
+  assertion( DataHeap::getInstance().isValidIndex( cellDescription.getFluctuationIndex() ));
 
   peano::datatraversal::TaskSet glueTasks(
     [&]() -> bool {
@@ -2976,7 +3415,40 @@ void exahype::solvers::ADERDGSolver::pullUnknownsFromByteStream(
     peano::datatraversal::TaskSet::TaskType::Background,
     true
   );
+
+  // glueTogether(...) resizes the arrays, so the pointers are set afterwards
+  cellDescription.setPreviousSolution     ( getDataHeapEntries(cellDescription.getPreviousSolutionIndex()).data() );
+  cellDescription.setSolution             ( getDataHeapEntries(cellDescription.getSolutionIndex()).data() );
+  cellDescription.setUpdate               ( getDataHeapEntries(cellDescription.getUpdateIndex()).data() );
+  cellDescription.setExtrapolatedPredictor( getDataHeapEntries(cellDescription.getExtrapolatedPredictorIndex()).data() );
+  cellDescription.setFluctuation          ( getDataHeapEntries(cellDescription.getFluctuationIndex()).data() );
+
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,1.0);
+  #endif
+}
+
+#if defined(TrackGridStatistics)
+void exahype::solvers::ADERDGSolver::trackHeapBytes(const CellDescription& cellDescription,const double sign) const {
+  const std::array<int,5> indices = {{
+      cellDescription.getPreviousSolutionIndex(), cellDescription.getSolutionIndex(), cellDescription.getUpdateIndex(),
+      cellDescription.getExtrapolatedPredictorIndex(), cellDescription.getFluctuationIndex() }};
+  const std::array<int,5> compressedIndices = {{
+      cellDescription.getPreviousSolutionCompressedIndex(), cellDescription.getSolutionCompressedIndex(), cellDescription.getUpdateCompressedIndex(),
+      cellDescription.getExtrapolatedPredictorCompressedIndex(), cellDescription.getFluctuationCompressedIndex() }};
+
+  tarch::multicore::Lock lock(exahype::HeapSemaphore);
+  for (int i = 0; i < 5; i++) {
+    if ( indices[i]>=0 ) {
+      DataHeapBytes += sign * getDataHeapEntries(indices[i]).size() * 8.0;
+    }
+    if ( compressedIndices[i]>=0 ) {
+      CompressedDataHeapBytes += sign * CompressedDataHeap::getInstance().getData(compressedIndices[i]).size();
+    }
+  }
+  lock.free();
 }
+#endif
 
 ///////////////////////
 // PROFILING
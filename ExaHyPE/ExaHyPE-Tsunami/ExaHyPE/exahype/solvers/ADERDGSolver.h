@@ -16,10 +16,12 @@
 #ifndef _EXAHYPE_SOLVERS_ADERDG_SOLVER_H_
 #define _EXAHYPE_SOLVERS_ADERDG_SOLVER_H_
 
+#include <array>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <tuple>
+#include <unordered_map>
 
 #include "exahype/solvers/Solver.h"
 
@@ -39,6 +41,11 @@ namespace exahype {
   namespace solvers {
     class ADERDGSolver;
   }
+  namespace tests {
+    namespace solvers {
+      class ADERDGSolverTest;
+    }
+  }
 }
 
 /**
@@ -102,6 +109,7 @@ namespace exahype {
  */
 class exahype::solvers::ADERDGSolver : public exahype::solvers::Solver {
   friend class LimitingADERDGSolver;
+  friend class exahype::tests::solvers::ADERDGSolverTest;
 public:
 
   #ifdef USE_ITAC
@@ -296,6 +304,165 @@ private:
    */
   MeshUpdateEvent _meshUpdateEvent;
 
+  /**
+   * Number of histogram bins for the Picard iteration counts.
+   * Bin i counts the cells which needed i+1 iterations; the last bin
+   * collects all cells which needed more.
+   */
+  static constexpr int PicardIterationsHistogramBins = 16;
+
+  /**
+   * Rank-local histogram of the Picard iterations the nonlinear space-time
+   * predictor needed per cell. Filled by predictionAndVolumeIntegralBody(...),
+   * which might be run by background jobs, and
+   * printed as well as reset by logPicardIterationStatistics().
+   */
+  std::atomic<int> _picardIterationsHistogram[PicardIterationsHistogramBins];
+
+  /**
+   * Index of the current time step of the solver within the macro time step
+   * of the local time stepping, i.e. a number in [0,2^_localTimeSteppingLevels).
+   *
+   * The solver's time step size is only adapted when a new macro time step begins,
+   * or halved within a macro time step if it is not admissible anymore, see
+   * refineLocalTimeStepSize().
+   */
+  int _localTimeStep;
+
+  /**
+   * Number of solver time steps per macro time step as a power of two.
+   * Equals LocalTimeSteppingLevels at the begin of each macro time step and is
+   * increased whenever refineLocalTimeStepSize() halves the solver's time step size.
+   */
+  int _localTimeSteppingLevels;
+
+  /**
+   * Number of cell updates performed and skipped,
+   * respectively, because of the local time stepping. Filled by updateOrRestrict(...)
+   * and printed as well as reset by logLocalTimeSteppingStatistics().
+   */
+  std::atomic<long int> _localTimeSteppingUpdates;
+  std::atomic<long int> _localTimeSteppingSkippedUpdates;
+
+  /**
+   * Number of face merges performed and skipped, respectively, because of the
+   * local time stepping, and the time in nanoseconds spent in the performed cell
+   * updates (including the prediction) and in the performed face merges.
+   * Printed as well as reset by logLocalTimeSteppingStatistics().
+   */
+  std::atomic<long int> _localTimeSteppingMerges;
+  std::atomic<long int> _localTimeSteppingSkippedMerges;
+  std::atomic<long int> _localTimeSteppingCellTime;
+  std::atomic<long int> _localTimeSteppingMergeTime;
+
+  /**
+   * The solver state stored by storeSnapshot(...); see Solver::storeSnapshot().
+   */
+  struct Snapshot {
+    double          previousMinTimeStamp;
+    double          previousMinTimeStepSize;
+    double          minTimeStamp;
+    double          minTimeStepSize;
+    double          estimatedTimeStepSize;
+    double          admissibleTimeStepSize;
+    int             localTimeStep;
+    int             localTimeSteppingLevels;
+    MeshUpdateEvent meshUpdateEvent;
+    DataHeap::HeapEntries globalObservables;
+    /** Per cell descriptions index, the cell description and the arrays listed by getSnapshotIndices(...). */
+    std::unordered_map<int,std::pair<CellDescription,std::vector<DataHeap::HeapEntries>>> cells;
+  };
+  Snapshot _snapshot;
+
+  /**
+   * @return the DataHeap indices of the arrays of the cell description which are
+   * stored in a snapshot, -1 for arrays which are not allocated.
+   */
+  std::array<int,9> getSnapshotIndices(const CellDescription& cellDescription) const;
+
+  /**
+   * @return if the cell finishes its time step in the current time step
+   * of the solver. Always true for the global time stepping schemes.
+   */
+  bool isDueForUpdate(const CellDescription& cellDescription) const;
+
+  /**
+   * @return if the cell begins a new time step in the current time step of the solver,
+   * i.e. if a prediction must be computed. Always true for the global time stepping schemes.
+   */
+  bool isStartingTimeStep(const CellDescription& cellDescription) const;
+
+  /**
+   * Local time stepping: Called on the sub-steps of a macro time step, where
+   * the solver's time step size is kept fixed. If a cell which completed its time step
+   * does not admit the solver's time step size anymore, the latter is halved (and the
+   * macro time step index scaled accordingly) until it is admissible.
+   * Cells in the middle of their time step then still end on a time step of the solver;
+   * all cells are synchronised again at the original end of the macro time step.
+   */
+  void refineLocalTimeStepSize();
+
+  /**
+   * Local time stepping: Add the fluctuations @p lFhbnd of a face merge, weighted
+   * with the ratio between the face's and the cell's time step size, to the
+   * accumulated fluctuations of face @p faceIndex of the cell.
+   *
+   * Only the merge of this face writes to this part of the array, so concurrent
+   * merges of the cell's other faces need no lock.
+   */
+  void accumulateFluctuations(
+      CellDescription&    cellDescription,
+      const double* const lFhbnd,
+      const int           faceIndex,
+      const double        weight);
+
+  /**
+   * Set the inert flag of a cell after its solution was updated.
+   *
+   * Only cells without limiter patch, without domain or remote boundary faces
+   * and not subject to local time stepping are considered; for those, the
+   * user hook isInert(...) decides.
+   *
+   * @note Requires uncompressed data.
+   */
+  void determineIfCellIsInert(
+      CellDescription&                                   cellDescription,
+      const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers);
+
+  /**
+   * Deactivate an inert cell whose neighbours have all been inert.
+   * An inactive cell neither computes a prediction nor updates its solution
+   * until a neighbour merge with a non-inert cell reactivates it.
+   *
+   * Resets the flag which indicates if a neighbour was not inert.
+   *
+   * @return if the cell was deactivated, i.e. must skip its prediction.
+   */
+  bool deactivateIfInert(CellDescription& cellDescription);
+
+  /**
+   * Compute the prediction of an inactive cell which is required
+   * by a neighbour merge with a non-inert cell.
+   *
+   * The volume integral is added to the update as inert cells
+   * always add their integrals to the update; see updateBody(...).
+   * Nothing is done if the cell is active.
+   *
+   * The first merge claims the cell and computes the prediction without
+   * holding a lock; concurrent merges of the same cell wait until
+   * the cell is active. Merges of other cells are not blocked.
+   */
+  void reactivate(CellDescription& cellDescription);
+
+  /**
+   * Keep the solution of an inactive cell. Stores it as
+   * previous solution in case of a rollback and resets the neighbour
+   * merge flags.
+   *
+   * @note Requires uncompressed data.
+   */
+  void skipUpdateOfInactiveCell(CellDescription& cellDescription);
+
   /**
    * Different to compress(), this operation is called automatically by
    * mergeNeighbours(). Therefore the routine is private.
@@ -953,6 +1120,16 @@ private:
    */
   void pullUnknownsFromByteStream(CellDescription& cellDescription) const;
 
+  #if defined(TrackGridStatistics)
+  /**
+   * Add the bytes the compressible arrays of the cell currently hold on the
+   * DataHeap and the CompressedDataHeap, multiplied by @p sign, to
+   * DataHeapBytes and CompressedDataHeapBytes. Called with -1 before and +1
+   * after the cell's arrays are allocated, freed, compressed or uncompressed.
+   */
+  void trackHeapBytes(const CellDescription& cellDescription,const double sign) const;
+  #endif
+
   class CompressionJob: public tarch::multicore::jobs::Job {
     private:
       const ADERDGSolver& _solver;
@@ -1528,6 +1705,12 @@ public:
   /**
    * Copies the time stepping data from the global solver onto the patch's time
    * stepping data.
+   *
+   * For the local time stepping, the time step size of a cell which begins a new time step
+   * is set to 2^k times the solver's time step size. Here, k is the largest level
+   * that is admissible and that does not let the cell skip the end of the macro time step.
+   * Troubled cells and their neighbours (cells which participate in limiter merges)
+   * always use the solver's time step size.
    */
   void synchroniseTimeStepping(CellDescription& p) const;
 
@@ -1551,6 +1734,25 @@ public:
 
   double getEstimatedTimeStepSize() const;
 
+  /**
+   * Log the histogram of the Picard iterations the space-time
+   * predictor needed per cell since the last call and reset it.
+   *
+   * Does nothing if no nonlinear predictor was run.
+   * The statistics are rank-local.
+   */
+  void logPicardIterationStatistics();
+
+  /**
+   * Log the cell updates and face merges which were performed and skipped since the last call,
+   * and reset the counters. The speed-up w.r.t. the global time stepping is estimated
+   * from the measured time per performed cell update (incl. prediction) and per face merge.
+   *
+   * Does nothing if the solver does not use the local time stepping.
+   * The statistics are rank-local.
+   */
+  void logLocalTimeSteppingStatistics();
+
   /**
    * \return true if the CFL condition was violated
    * (by the last fused time step).
@@ -1780,8 +1982,7 @@ public:
    * \return the newly computed time step size if the cell description is of type Leaf or the maximum
    *         double value.
    */
-  double computeTimeStepSize(
-      CellDescription& cellDescription);
+  double computeTimeStepSize(CellDescription& cellDescription);
 
   /**
    * Advances the local time stamp of a cell by adding the
@@ -1939,6 +2140,23 @@ public:
    */
   void rollbackSolutionGlobally(const int solverNumber,CellInfo& cellInfo) const final override;
 
+  void storeSnapshot() final override;
+
+  /**
+   * Uncompresses the cell description and stores its solution, update, face
+   * and DMP arrays.
+   */
+  void storeSnapshot(const int solverNumber,CellInfo& cellInfo) final override;
+
+  void restoreFromSnapshot() final override;
+
+  /**
+   * Skips and reports cell descriptions whose type or level has changed.
+   */
+  void restoreFromSnapshot(const int solverNumber,CellInfo& cellInfo) final override;
+
+  void deleteSnapshot() final override;
+
   ///////////////////////////////////
   // NEIGHBOUR
   ///////////////////////////////////
@@ -2378,6 +2596,8 @@ protected:
   // make super class virtual function accessible
   using Solver::updateGlobalObservables;
 
+  void registerProfilingTags() override;
+
   /** @name Plugin points for derived solvers.
    *
    *  These are the macro kernels solvers derived from
@@ -2535,6 +2755,8 @@ protected:
    * @param[in]    t                               time stamp
    * @param[in]    dt                              time step size
    * @param[in]    addVolumeIntegralResultToUpdate if the volume integral result should be added to the update vector @lduh. Otherwise, it is added to the solution vector @p luh.
+   * @param[out]   admissibleTimeStepSize          if not nullptr, a stable time step size estimated from all space-time nodes
+   *                                               of the predictor. Only requested if usePredictorWaveSpeedsForTimeStepSize() is true.
    *
    * \return the number of Picard iterations performed by the
    * space-time predictor computation kernel.
@@ -2549,7 +2771,8 @@ protected:
       const tarch::la::Vector<DIMENSIONS, double>& dx,
       const double                                 t,
       const double                                 dt,
-      const bool                                   addVolumeIntegralResultToUpdate) = 0;
+      const bool                                   addVolumeIntegralResultToUpdate,
+      double* const                                admissibleTimeStepSize) = 0;
 
   /**
    * \brief Returns a stable time step size.
@@ -2561,6 +2784,37 @@ protected:
       const double* const                          luh,
       const tarch::la::Vector<DIMENSIONS, double>& dx) = 0;
 
+  /**
+   * If true, the admissible time step size of a fused time step is reduced from
+   * the space-time predictors of that step, see kernels::aderdg::generic::c::stableTimeStepSizeFromSpaceTimePredictor,
+   * instead of evaluating the eigenvalues at every node of the corrected solution.
+   * As the estimate covers the time slab the predictor was computed for,
+   * the rerun check of the fused time stepping validates the estimated time step size
+   * against it. The initial time step size and the one after mesh refinement are always
+   * computed from the solution.
+   *
+   * Only supported by solvers with fused time stepping; see Runner::initOptimisations().
+   */
+  virtual bool usePredictorWaveSpeedsForTimeStepSize() const {return false;}
+
+  /**
+   * If true, the scheme does not change the solution @p luh of the cell
+   * as long as all its neighbours are inert too, e.g. dry cells of the
+   * shallow water equations.
+   *
+   * Cells which are inert and have only inert neighbours are deactivated; they skip
+   * their prediction and update until a non-inert neighbour reactivates them.
+   * Fluxes between inert cells are assumed to vanish.
+   *
+   * @param[in] luh        the cell's solution after the update.
+   * @param[in] cellCentre centre of the cell.
+   * @param[in] cellSize   extent of the cell in each coordinate direction.
+   */
+  virtual bool isInert(
+      const double* const                         luh,
+      const tarch::la::Vector<DIMENSIONS,double>& cellCentre,
+      const tarch::la::Vector<DIMENSIONS,double>& cellSize) {return false;}
+
   /**
    * This operation allows you to impose time-dependent solution values
    * as well as to add contributions of source terms.
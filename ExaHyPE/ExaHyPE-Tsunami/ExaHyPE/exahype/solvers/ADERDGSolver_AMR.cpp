@@ -277,6 +277,12 @@ void exahype::solvers::ADERDGSolver::addNewCellDescription(
 
 void exahype::solvers::ADERDGSolver::ensureNecessaryMemoryIsAllocated(
     CellDescription& cellDescription) const {
+  // the checks below interpret compressed arrays as missing ones
+  if (CompressionAccuracy>0.0) { uncompress(cellDescription); }
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,-1.0);
+  #endif
+
   // allocate solution
   if (
       holdsSolution(cellDescription) &&
@@ -381,6 +387,14 @@ void exahype::solvers::ADERDGSolver::ensureNecessaryMemoryIsAllocated(
     std::fill_n(static_cast<double*>(cellDescription.getFluctuation()),dofPerBnd,std::numeric_limits<double>::quiet_NaN());
     std::fill_n(static_cast<double*>(cellDescription.getFluctuationAverages()),boundaryUnknowns,std::numeric_limits<double>::quiet_NaN());
 
+    // local time stepping: fluctuations accumulated during the cell's time step
+    if ( getTimeStepping()==TimeStepping::Local ) {
+      cellDescription.setAccumulatedFluctuationIndex( DataHeap::getInstance().createData(dofPerBnd, dofPerBnd) );
+      checkDataHeapIndex(cellDescription,cellDescription.getAccumulatedFluctuationIndex(),"getAccumulatedFluctuation()");
+      cellDescription.setAccumulatedFluctuation( getDataHeapEntries(cellDescription.getAccumulatedFluctuationIndex()).data() ) ;
+      std::fill_n(static_cast<double*>(cellDescription.getAccumulatedFluctuation()),dofPerBnd,0.0);
+    }
+
     // Allocate volume DoF for limiter (we need for every of the 2*DIMENSIONS faces an array of min values
     // and array of max values of the neighbour at this face).
     const int numberOfObservables = getDMPObservables();
@@ -400,10 +414,19 @@ void exahype::solvers::ADERDGSolver::ensureNecessaryMemoryIsAllocated(
 
     lock.free();
   }
+
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,1.0);
+  #endif
 }
 
 void exahype::solvers::ADERDGSolver::ensureNoUnnecessaryMemoryIsAllocated(
     CellDescription& cellDescription) const {
+  // compressed arrays would not be found and leak
+  if (CompressionAccuracy>0.0) { uncompress(cellDescription); }
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,-1.0);
+  #endif
 
   if (
       !holdsSolution(cellDescription) &&
@@ -423,6 +446,10 @@ void exahype::solvers::ADERDGSolver::ensureNoUnnecessaryMemoryIsAllocated(
       assertion(cellDescription.getSolutionIndex()==-1);
       CompressedDataHeap::getInstance().deleteData(cellDescription.getSolutionCompressedIndex());
     }
+    if ( cellDescription.getPreviousSolutionIndex()>=0 ) {
+      DataHeap::getInstance().deleteData(cellDescription.getPreviousSolutionIndex());
+      assertion(cellDescription.getPreviousSolutionCompressedIndex()==-1);
+    }
 
     DataHeap::getInstance().deleteData(cellDescription.getSolutionAveragesIndex());
     DataHeap::getInstance().deleteData(cellDescription.getPreviousSolutionAveragesIndex());
@@ -523,6 +550,13 @@ void exahype::solvers::ADERDGSolver::ensureNoUnnecessaryMemoryIsAllocated(
     cellDescription.setFluctuationAveragesIndex(-1);
     cellDescription.setFluctuationAverages(nullptr);
 
+    if ( cellDescription.getAccumulatedFluctuationIndex()>=0 ) {
+      assertion(DataHeap::getInstance().isValidIndex(cellDescription.getAccumulatedFluctuationIndex()));
+      DataHeap::getInstance().deleteData(cellDescription.getAccumulatedFluctuationIndex());
+      cellDescription.setAccumulatedFluctuationIndex(-1);
+      cellDescription.setAccumulatedFluctuation(nullptr);
+    }
+
     if ( getDMPObservables()>0 ) {
       assertion(DataHeap::getInstance().isValidIndex(cellDescription.getSolutionMinIndex()));
       assertion(DataHeap::getInstance().isValidIndex(cellDescription.getSolutionMaxIndex()));
@@ -537,6 +571,10 @@ void exahype::solvers::ADERDGSolver::ensureNoUnnecessaryMemoryIsAllocated(
 
     lock.free();
   }
+
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,1.0);
+  #endif
 }
 
 void exahype::solvers::ADERDGSolver::checkDataHeapIndex(const CellDescription& cellDescription, const int arrayIndex,const std::string arrayName) {
@@ -1441,6 +1479,7 @@ bool exahype::solvers::ADERDGSolver::sendCellDescriptions(
     for (auto& cellDescription : Heap::getInstance().getData(cellDescriptionsIndex)) {
       // wait for background jobs to complete
       if ( !cellDescription.getHasCompletedLastStep() ) {
+        spawnPendingJobBatches();
         peano::datatraversal::TaskSet::startToProcessBackgroundJobs();
       }
       int numberOfBackgroundJobsToProcess = 1;
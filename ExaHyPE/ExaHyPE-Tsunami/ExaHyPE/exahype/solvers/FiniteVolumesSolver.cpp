@@ -19,7 +19,9 @@
 #include <string>
 #include <limits>
 #include <algorithm> // copy_n
+#include <array>
 #include <chrono>    // profiling
+#include <vector>
 
 #include "peano/utils/Loop.h"
 
@@ -98,11 +100,15 @@ exahype::solvers::FiniteVolumesSolver::FiniteVolumesSolver(
             _admissibleTimeStepSize( std::numeric_limits<double>::infinity() ),
             _ghostLayerWidth( ghostLayerWidth ),
             _meshUpdateEvent( MeshUpdateEvent::None ) {
-  // register tags with profiler
+  registerProfilingTags();
+
+}
+
+void exahype::solvers::FiniteVolumesSolver::registerProfilingTags() {
+  Solver::registerProfilingTags();
   for (const char* tag : tags) {
-    _profiler->registerTag(tag);
+    _profiler->addTag(tag);
   }
-
 }
 
 int exahype::solvers::FiniteVolumesSolver::getDataPerPatch() const {
@@ -220,6 +226,7 @@ void exahype::solvers::FiniteVolumesSolver::synchroniseTimeStepping(CellDescript
   switch (_timeStepping) {
     case TimeStepping::Global:
     case TimeStepping::GlobalFixed:
+    case TimeStepping::Local: // only used as limiter; limiter patches always advance with the solver's time step size
       cellDescription.setPreviousTimeStepSize(_previousMinTimeStamp);
       cellDescription.setPreviousTimeStepSize(_previousMinTimeStepSize);
       cellDescription.setTimeStamp(_minTimeStamp);
@@ -305,6 +312,14 @@ int exahype::solvers::FiniteVolumesSolver::computeWeight(const int cellDescripti
   else return 0;
 }
 
+double* exahype::solvers::FiniteVolumesSolver::getPatchScratch(const int size) {
+  static thread_local std::vector<double> scratch;
+  if ( static_cast<int>(scratch.size()) < size ) {
+    scratch.resize(size);
+  }
+  return scratch.data();
+}
+
 ///////////////////////////////////
 // MODIFY CELL DESCRIPTION
 ///////////////////////////////////
@@ -410,6 +425,12 @@ void exahype::solvers::FiniteVolumesSolver::addNewCellDescription(
 
 void exahype::solvers::FiniteVolumesSolver::ensureNoUnnecessaryMemoryIsAllocated(
     CellDescription& cellDescription) const {
+  // compressed arrays would not be found and leak
+  if (CompressionAccuracy>0.0) { uncompress(cellDescription); }
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,-1.0);
+  #endif
+
   if (DataHeap::getInstance().isValidIndex(cellDescription.getSolutionIndex())) {
     switch (cellDescription.getType()) {
       case CellDescription::Erased: {
@@ -478,6 +499,10 @@ void exahype::solvers::FiniteVolumesSolver::ensureNoUnnecessaryMemoryIsAllocated
         break;
     }
   }
+
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,1.0);
+  #endif
 }
 
 void exahype::solvers::FiniteVolumesSolver::checkDataHeapIndex(const CellDescription& cellDescription, const int arrayIndex,const std::string arrayName) {
@@ -491,6 +516,12 @@ void exahype::solvers::FiniteVolumesSolver::checkDataHeapIndex(const CellDescrip
 
 void exahype::solvers::FiniteVolumesSolver::ensureNecessaryMemoryIsAllocated(
     CellDescription& cellDescription) const {
+  // the check below interprets compressed arrays as missing ones
+  if (CompressionAccuracy>0.0) { uncompress(cellDescription); }
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,-1.0);
+  #endif
+
   switch (cellDescription.getType()) {
     case CellDescription::Type::Leaf:
       if (!DataHeap::getInstance().isValidIndex(cellDescription.getSolutionIndex())) {
@@ -551,6 +582,10 @@ void exahype::solvers::FiniteVolumesSolver::ensureNecessaryMemoryIsAllocated(
       assertionMsg(false,"No other cell description types are supported at the moment!");
       break;
   }
+
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,1.0);
+  #endif
 }
 
 void exahype::solvers::FiniteVolumesSolver::progressMeshRefinementInLeaveCell(
@@ -647,6 +682,8 @@ void exahype::solvers::FiniteVolumesSolver::rollbackToPreviousTimeStep(CellDescr
 
   cellDescription.setPreviousTimeStamp(std::numeric_limits<double>::infinity());
   cellDescription.setPreviousTimeStepSize(std::numeric_limits<double>::infinity());
+
+  cellDescription.setIsInert(false); // refers to the discarded solution
 }
 
 void exahype::solvers::FiniteVolumesSolver::adjustSolutionDuringMeshRefinementBody(
@@ -835,6 +872,8 @@ void exahype::solvers::FiniteVolumesSolver::updateSolution(
     const int                                          cellDescriptionsIndex,
     const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers,
     const bool                                         backupPreviousSolution) {
+  profilers::ScopedTag profilingScope(*_profiler,ProfilingPhase::Update);
+
   // boundary conditions
   double* solution       = static_cast<double*>(cellDescription.getSolution());
   for (int direction=0; direction<DIMENSIONS; direction++) {
@@ -881,6 +920,10 @@ void exahype::solvers::FiniteVolumesSolver::updateSolution(
     std::copy(solution,solution+getDataPerPatch()+getGhostDataPerPatch(),solutionBackup); // Copy (current solution) in old solution field.
   }
 
+  if ( deactivateIfInert(cellDescription) ) { // keep the solution
+    return;
+  }
+
   assertion3(cellDescription.getTimeStepSize() > 0 && std::isfinite(cellDescription.getTimeStamp()) && std::isfinite(cellDescription.getTimeStepSize()), cellDescription.getTimeStamp(),cellDescription.getTimeStepSize(),cellDescription.toString());
   validateNoNansInFiniteVolumesSolution(cellDescription,cellDescriptionsIndex,"updateSolution[pre]");
 
@@ -910,6 +953,29 @@ void exahype::solvers::FiniteVolumesSolver::updateSolution(
   if ( Solver::ProfileUpdate ) { swapSolutionAndPreviousSolution(cellDescription); }
 
   validateNoNansInFiniteVolumesSolution(cellDescription,cellDescriptionsIndex,"updateSolution[post]");
+
+  determineIfCellIsInert(cellDescription,boundaryMarkers);
+}
+
+void exahype::solvers::FiniteVolumesSolver::determineIfCellIsInert(
+    CellDescription&                                   cellDescription,
+    const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers) {
+  const bool isAtBoundary =
+      tarch::la::oneEquals(boundaryMarkers,mappings::LevelwiseAdjacencyBookkeeping::DomainBoundaryAdjacencyIndex) ||
+      tarch::la::oneEquals(boundaryMarkers,mappings::LevelwiseAdjacencyBookkeeping::RemoteAdjacencyIndex);
+  cellDescription.setIsInert(
+      !isAtBoundary &&
+      isInert(
+          static_cast<double*>(cellDescription.getSolution()),
+          cellDescription.getOffset()+0.5*cellDescription.getSize(),
+          cellDescription.getSize()));
+}
+
+bool exahype::solvers::FiniteVolumesSolver::deactivateIfInert(CellDescription& cellDescription) {
+  const bool deactivate = cellDescription.getIsInert() && !cellDescription.getHasNonInertNeighbour();
+  cellDescription.setHasNonInertNeighbour(false);
+  cellDescription.setIsInactive(deactivate);
+  return deactivate;
 }
 
 void exahype::solvers::FiniteVolumesSolver::swapSolutionAndPreviousSolution(
@@ -929,6 +995,88 @@ void exahype::solvers::FiniteVolumesSolver::rollbackSolutionGlobally(const int s
   std::abort();
 }
 
+std::array<int,3> exahype::solvers::FiniteVolumesSolver::getSnapshotIndices(const CellDescription& cellDescription) const {
+  return {{ cellDescription.getPreviousSolutionIndex(), cellDescription.getSolutionIndex(), cellDescription.getExtrapolatedSolutionIndex() }};
+}
+
+void exahype::solvers::FiniteVolumesSolver::storeSnapshot() {
+  _snapshot.previousMinTimeStamp    = _previousMinTimeStamp;
+  _snapshot.previousMinTimeStepSize = _previousMinTimeStepSize;
+  _snapshot.minTimeStamp            = _minTimeStamp;
+  _snapshot.minTimeStepSize         = _minTimeStepSize;
+  _snapshot.admissibleTimeStepSize  = _admissibleTimeStepSize;
+  _snapshot.meshUpdateEvent         = _meshUpdateEvent;
+  _snapshot.globalObservables       = _globalObservables;
+  _snapshot.cells.clear();
+}
+
+void exahype::solvers::FiniteVolumesSolver::storeSnapshot(const int solverNumber,CellInfo& cellInfo) {
+  const int element = cellInfo.indexOfFiniteVolumesCellDescription(solverNumber);
+  if ( element != NotFound ) {
+    CellDescription& cellDescription = cellInfo._FiniteVolumesCellDescriptions[element];
+    uncompress(cellDescription);
+
+    auto& snapshot = _snapshot.cells[cellInfo._cellDescriptionsIndex];
+    snapshot.first = cellDescription;
+    snapshot.second.clear();
+    for (int index : getSnapshotIndices(cellDescription)) {
+      snapshot.second.push_back( index>=0 ? getDataHeapEntries(index) : DataHeap::HeapEntries() );
+    }
+  }
+}
+
+void exahype::solvers::FiniteVolumesSolver::restoreFromSnapshot() {
+  _previousMinTimeStamp    = _snapshot.previousMinTimeStamp;
+  _previousMinTimeStepSize = _snapshot.previousMinTimeStepSize;
+  _minTimeStamp            = _snapshot.minTimeStamp;
+  _minTimeStepSize         = _snapshot.minTimeStepSize;
+  _admissibleTimeStepSize  = _snapshot.admissibleTimeStepSize;
+  _meshUpdateEvent         = _snapshot.meshUpdateEvent;
+  _globalObservables       = _snapshot.globalObservables;
+}
+
+void exahype::solvers::FiniteVolumesSolver::restoreFromSnapshot(const int solverNumber,CellInfo& cellInfo) {
+  const int element = cellInfo.indexOfFiniteVolumesCellDescription(solverNumber);
+  if ( element != NotFound ) {
+    CellDescription& cellDescription = cellInfo._FiniteVolumesCellDescriptions[element];
+    auto snapshot = _snapshot.cells.find(cellInfo._cellDescriptionsIndex);
+    if (
+        snapshot == _snapshot.cells.end() ||
+        snapshot->second.first.getType()  != cellDescription.getType() ||
+        snapshot->second.first.getLevel() != cellDescription.getLevel()
+    ) {
+      logWarning("restoreFromSnapshot(...)","cell description was created or changed after the snapshot was stored. Do not restore it. "
+          "cell description="<<cellDescription.toString());
+      return;
+    }
+    uncompress(cellDescription);
+
+    const CellDescription& stored = snapshot->second.first;
+    cellDescription.setTimeStamp(stored.getTimeStamp());
+    cellDescription.setTimeStepSize(stored.getTimeStepSize());
+    cellDescription.setPreviousTimeStamp(stored.getPreviousTimeStamp());
+    cellDescription.setPreviousTimeStepSize(stored.getPreviousTimeStepSize());
+    cellDescription.setNeighbourMergePerformed(stored.getNeighbourMergePerformed());
+    cellDescription.setIsInert(stored.getIsInert());
+    cellDescription.setIsInactive(stored.getIsInactive());
+    cellDescription.setHasNonInertNeighbour(stored.getHasNonInertNeighbour());
+
+    const std::array<int,3> indices = getSnapshotIndices(cellDescription);
+    for (unsigned int i = 0; i < indices.size(); i++) {
+      const DataHeap::HeapEntries& storedEntries = snapshot->second.second[i];
+      if ( indices[i]>=0 && !storedEntries.empty() ) {
+        DataHeap::HeapEntries& entries = getDataHeapEntries(indices[i]);
+        assertionEquals2(entries.size(),storedEntries.size(),i,cellDescription.toString());
+        std::copy(storedEntries.begin(),storedEntries.end(),entries.begin());
+      }
+    }
+  }
+}
+
+void exahype::solvers::FiniteVolumesSolver::deleteSnapshot() {
+  _snapshot = Snapshot();
+}
+
 ///////////////////////////////////
 // NEIGHBOUR
 ///////////////////////////////////
@@ -992,6 +1140,9 @@ void exahype::solvers::FiniteVolumesSolver::mergeNeighboursData(
     ghostLayerFilling(solution1,solution2,pos2-pos1);
     ghostLayerFilling(solution2,solution1,pos1-pos2);
 
+    if ( !cellDescription2.getIsInert() ) { cellDescription1.setHasNonInertNeighbour(true); }
+    if ( !cellDescription1.getIsInert() ) { cellDescription2.setHasNonInertNeighbour(true); }
+
     Solver::InterfaceInfo face(pos1,pos2);
     cellDescription1.setNeighbourMergePerformed(face._faceIndex1,true);
     cellDescription2.setNeighbourMergePerformed(face._faceIndex2,true);
@@ -1016,6 +1167,7 @@ void exahype::solvers::FiniteVolumesSolver::sendCellDescriptions(
   if ( isValidCellDescriptionIndex(cellDescriptionsIndex) ) {
     for (auto& cellDescription : Heap::getInstance().getData(cellDescriptionsIndex)) {
       if ( !cellDescription.getHasCompletedLastStep() ) {
+        spawnPendingJobBatches();
         peano::datatraversal::TaskSet::startToProcessBackgroundJobs();
       }
       int numberOfBackgroundJobsToProcess = 1;
@@ -1607,6 +1759,10 @@ void exahype::solvers::FiniteVolumesSolver::putUnknownsIntoByteStream(
   assertion( cellDescription.getSolutionCompressedIndex()==-1 );
   assertion( cellDescription.getExtrapolatedSolutionCompressedIndex()==-1 );
 
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,-1.0);
+  #endif
+
   int compressionOfPreviousSolution;
   int compressionOfSolution;
   int compressionOfExtrapolatedSolution;
@@ -1772,6 +1928,10 @@ void exahype::solvers::FiniteVolumesSolver::putUnknownsIntoByteStream(
 	peano::datatraversal::TaskSet::TaskType::Background,
     true
   );
+
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,1.0);
+  #endif
 }
 
 
@@ -1779,60 +1939,59 @@ void exahype::solvers::FiniteVolumesSolver::pullUnknownsFromByteStream(
     CellDescription& cellDescription) const {
   assertion(CompressionAccuracy>0.0);
 
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,-1.0);
+  #endif
+
   #if !defined(ValidateCompressedVsUncompressedData)
+  // arrays which did not compress (7 bytes per DoF) have been kept
+  const bool previousSolutionIsCompressed     = cellDescription.getBytesPerDoFInPreviousSolution()<7;
+  const bool solutionIsCompressed             = cellDescription.getBytesPerDoFInSolution()<7;
+  const bool extrapolatedSolutionIsCompressed = cellDescription.getBytesPerDoFInExtrapolatedSolution()<7;
+
   const int dataPerCell     = getDataPerPatch() + getGhostDataPerPatch();
   const int dataPerBoundary = getDataPerPatchBoundary();
 
   {
     tarch::multicore::Lock lock(exahype::HeapSemaphore);
-    cellDescription.setPreviousSolutionIndex( DataHeap::getInstance().createData( dataPerCell,dataPerCell,DataHeap::Allocation::UseOnlyRecycledEntries) );
-    cellDescription.setSolutionIndex( DataHeap::getInstance().createData( dataPerCell,dataPerCell,DataHeap::Allocation::UseOnlyRecycledEntries) );
-    cellDescription.setExtrapolatedSolutionIndex( DataHeap::getInstance().createData( dataPerBoundary,dataPerBoundary,DataHeap::Allocation::UseOnlyRecycledEntries) );
+    if (previousSolutionIsCompressed) {
+      cellDescription.setPreviousSolutionIndex( DataHeap::getInstance().createData( dataPerCell,dataPerCell,DataHeap::Allocation::UseOnlyRecycledEntries) );
+    }
+    if (solutionIsCompressed) {
+      cellDescription.setSolutionIndex( DataHeap::getInstance().createData( dataPerCell,dataPerCell,DataHeap::Allocation::UseOnlyRecycledEntries) );
+    }
+    if (extrapolatedSolutionIsCompressed) {
+      cellDescription.setExtrapolatedSolutionIndex( DataHeap::getInstance().createData( dataPerBoundary,dataPerBoundary,DataHeap::Allocation::UseOnlyRecycledEntries) );
+    }
     lock.free();
 
-    if (cellDescription.getPreviousSolutionIndex()==-1) { // allocate new array if recycling has failed
+    if (previousSolutionIsCompressed && cellDescription.getPreviousSolutionIndex()==-1) { // allocate new array if recycling has failed
       ensureAllJobsHaveTerminated(JobType::SkeletonJob);
       ensureAllJobsHaveTerminated(JobType::EnclaveJob);
       lock.lock();
       cellDescription.setPreviousSolutionIndex( DataHeap::getInstance().createData( dataPerCell, dataPerCell ) );
       lock.free();
     }
-    if (cellDescription.getSolutionIndex()==-1) {
+    if (solutionIsCompressed && cellDescription.getSolutionIndex()==-1) {
       ensureAllJobsHaveTerminated(JobType::SkeletonJob);
       ensureAllJobsHaveTerminated(JobType::EnclaveJob);
       lock.lock();
       cellDescription.setSolutionIndex( DataHeap::getInstance().createData( dataPerCell, dataPerCell ) );
       lock.free();
     }
-    if (cellDescription.getExtrapolatedSolutionIndex()==-1) {
+    if (extrapolatedSolutionIsCompressed && cellDescription.getExtrapolatedSolutionIndex()==-1) {
       ensureAllJobsHaveTerminated(JobType::SkeletonJob);
       ensureAllJobsHaveTerminated(JobType::EnclaveJob);
       lock.lock();
       cellDescription.setExtrapolatedSolutionIndex( DataHeap::getInstance().createData(dataPerBoundary, dataPerBoundary ) );
       lock.free();
     }
-    cellDescription.setPreviousSolution    ( static_cast<void*>(CompressedDataHeap::getInstance().getData(cellDescription.getPreviousSolutionIndex()).data() ) );
-    cellDescription.setSolution            ( static_cast<void*>(CompressedDataHeap::getInstance().getData(cellDescription.getSolutionIndex()).data() ) );
-    cellDescription.setExtrapolatedSolution( static_cast<void*>(CompressedDataHeap::getInstance().getData(cellDescription.getExtrapolatedSolutionIndex()).data() ) );
   }
-  #else
+  #endif
+
   assertion( DataHeap::getInstance().isValidIndex( cellDescription.getPreviousSolutionIndex() ));
   assertion( DataHeap::getInstance().isValidIndex( cellDescription.getSolutionIndex() ));
   assertion( DataHeap::getInstance().isValidIndex( cellDescription.getExtrapolatedSolutionIndex() ));
-  #endif
-
-  assertion1(
-      CompressedDataHeap::getInstance().isValidIndex( cellDescription.getPreviousSolutionCompressedIndex() ),
-      cellDescription.getPreviousSolutionCompressed()
-    );
-  assertion1(
-    CompressedDataHeap::getInstance().isValidIndex( cellDescription.getSolutionCompressedIndex() ),
-    cellDescription.getSolutionCompressed()
-  );
-  assertion1(
-    CompressedDataHeap::getInstance().isValidIndex( cellDescription.getExtrapolatedSolutionCompressedIndex() ),
-    cellDescription.getExtrapolatedSolutionCompressed()
-  );
 
   peano::datatraversal::TaskSet glueTasks(
     [&]() -> bool {
@@ -1882,7 +2041,37 @@ void exahype::solvers::FiniteVolumesSolver::pullUnknownsFromByteStream(
 	peano::datatraversal::TaskSet::TaskType::Background,
 	true
   );
+
+  // glueTogether(...) resizes the arrays, so the pointers are set afterwards
+  cellDescription.setPreviousSolution    ( getDataHeapEntries(cellDescription.getPreviousSolutionIndex()).data() );
+  cellDescription.setSolution            ( getDataHeapEntries(cellDescription.getSolutionIndex()).data() );
+  cellDescription.setExtrapolatedSolution( getDataHeapEntries(cellDescription.getExtrapolatedSolutionIndex()).data() );
+
+  #if defined(TrackGridStatistics)
+  trackHeapBytes(cellDescription,1.0);
+  #endif
+}
+
+#if defined(TrackGridStatistics)
+void exahype::solvers::FiniteVolumesSolver::trackHeapBytes(const CellDescription& cellDescription,const double sign) const {
+  const std::array<int,3> indices = {{
+      cellDescription.getPreviousSolutionIndex(), cellDescription.getSolutionIndex(), cellDescription.getExtrapolatedSolutionIndex() }};
+  const std::array<int,3> compressedIndices = {{
+      cellDescription.getPreviousSolutionCompressedIndex(), cellDescription.getSolutionCompressedIndex(),
+      cellDescription.getExtrapolatedSolutionCompressedIndex() }};
+
+  tarch::multicore::Lock lock(exahype::HeapSemaphore);
+  for (int i = 0; i < 3; i++) {
+    if ( indices[i]>=0 ) {
+      DataHeapBytes += sign * getDataHeapEntries(indices[i]).size() * 8.0;
+    }
+    if ( compressedIndices[i]>=0 ) {
+      CompressedDataHeapBytes += sign * CompressedDataHeap::getInstance().getData(compressedIndices[i]).size();
+    }
+  }
+  lock.free();
 }
+#endif
 
 
 void exahype::solvers::FiniteVolumesSolver::compress(CellDescription& cellDescription,const bool isSkeletonCell) const {
@@ -1954,6 +2143,10 @@ void exahype::solvers::FiniteVolumesSolver::determineUnknownAverages(
   auto& solutionAverages             = getDataHeapEntries( cellDescription.getSolutionAveragesIndex() );
   auto& previousSolutionAverage      = getDataHeapEntries( cellDescription.getPreviousSolutionAveragesIndex() );
   auto& extrapolatedSolutionAverages = getDataHeapEntries( cellDescription.getExtrapolatedSolutionAveragesIndex() );
+  // the averages are initialised with NaNs and still hold the previous averages otherwise
+  std::fill( solutionAverages.begin(),             solutionAverages.end(),             0.0 );
+  std::fill( previousSolutionAverage.begin(),      previousSolutionAverage.end(),      0.0 );
+  std::fill( extrapolatedSolutionAverages.begin(), extrapolatedSolutionAverages.end(), 0.0 );
 
   // patch data
   kernels::idx2 idx_patchData    (subcellsPerPatch,dataPerSubcell);
@@ -2040,7 +2233,10 @@ bool exahype::solvers::FiniteVolumesSolver::CompressionJob::run(bool runOnMaster
   _solver.determineUnknownAverages(_cellDescription);
   _solver.computeHierarchicalTransform(_cellDescription,-1.0);
   _solver.putUnknownsIntoByteStream(_cellDescription);
+  // uncompress(...) polls the state under the heap semaphore
+  tarch::multicore::Lock lock(exahype::HeapSemaphore);
   _cellDescription.setCompressionState(CellDescription::Compressed);
+  lock.free();
 
   if (_isSkeletonJob) {
     NumberOfSkeletonJobs.fetch_sub(1);
@@ -16,6 +16,8 @@
 #ifndef _EXAHYPE_SOLVERS_FINITE_VOLUMES_SOLVER_H_
 #define _EXAHYPE_SOLVERS_FINITE_VOLUMES_SOLVER_H_
 
+#include <array>
+#include <unordered_map>
 
 #include "exahype/solvers/Solver.h"
 
@@ -118,6 +120,28 @@ private:
    */
   MeshUpdateEvent _meshUpdateEvent;
 
+  /**
+   * The solver state stored by storeSnapshot(...); see Solver::storeSnapshot().
+   */
+  struct Snapshot {
+    double          previousMinTimeStamp;
+    double          previousMinTimeStepSize;
+    double          minTimeStamp;
+    double          minTimeStepSize;
+    double          admissibleTimeStepSize;
+    MeshUpdateEvent meshUpdateEvent;
+    DataHeap::HeapEntries globalObservables;
+    /** Per cell descriptions index, the cell description and the arrays listed by getSnapshotIndices(...). */
+    std::unordered_map<int,std::pair<CellDescription,std::vector<DataHeap::HeapEntries>>> cells;
+  };
+  Snapshot _snapshot;
+
+  /**
+   * @return the DataHeap indices of the previous solution, solution and extrapolated
+   * solution of the cell description, -1 for arrays which are not allocated.
+   */
+  std::array<int,3> getSnapshotIndices(const CellDescription& cellDescription) const;
+
   /**
    * Synchronises the cell description's time stepping data with
    * the solver's time stepping data.
@@ -229,6 +253,16 @@ private:
   void putUnknownsIntoByteStream(CellDescription& cellDescription) const;
   void uncompress(CellDescription& cellDescription) const;
 
+  #if defined(TrackGridStatistics)
+  /**
+   * \copydoc ADERDGSolver::trackHeapBytes()
+   *
+   * Counts the solution, previous solution and extrapolated solution.
+   * This covers the limiter patches of the LimitingADERDGSolver.
+   */
+  void trackHeapBytes(const CellDescription& cellDescription,const double sign) const;
+  #endif
+
   /**
    * Perform a solution update.
    *
@@ -242,6 +276,25 @@ private:
       const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers,
       const bool                                         backupPreviousSolution);
 
+  /**
+   * Set the inert flag of a cell after its solution was updated.
+   * Cells with domain or remote boundary faces are never inert;
+   * for all others, the user hook isInert(...) decides.
+   */
+  void determineIfCellIsInert(
+      CellDescription&                                   cellDescription,
+      const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers);
+
+  /**
+   * Deactivate an inert cell whose neighbours have all been inert.
+   * An inactive cell keeps its solution instead of performing an update.
+   *
+   * Resets the flag which indicates if a neighbour was not inert.
+   *
+   * @return if the cell was deactivated, i.e. must skip its update.
+   */
+  bool deactivateIfInert(CellDescription& cellDescription);
+
   /**
    * Rolls back the solver's solution on the cell description.
    * This method is used by the ADER-DG a-posteriori
@@ -531,6 +584,18 @@ public:
    */
   static int computeWeight(const int cellDescriptionsIndex);
 
+  /**
+   * Scratch memory for the patch kernels (e.g. the Godunov solution update).
+   *
+   * Every thread owns one buffer which grows to the largest request and is
+   * then reused, so the kernels neither allocate per patch nor keep
+   * patch-sized temporaries on the stack. The memory is only valid until the
+   * next call on the same thread.
+   *
+   * @return at least @p size doubles, uninitialised.
+   */
+  static double* getPatchScratch(const int size);
+
   ///////////////////////////////////
   // MODIFY CELL DESCRIPTION
   ///////////////////////////////////
@@ -638,6 +703,22 @@ public:
    */
   void rollbackSolutionGlobally(const int solverNumber,CellInfo& cellInfo) const final override;
 
+  void storeSnapshot() final override;
+
+  /**
+   * Uncompresses the cell description and stores its solution arrays.
+   */
+  void storeSnapshot(const int solverNumber,CellInfo& cellInfo) final override;
+
+  void restoreFromSnapshot() final override;
+
+  /**
+   * Skips and reports cell descriptions whose type or level has changed.
+   */
+  void restoreFromSnapshot(const int solverNumber,CellInfo& cellInfo) final override;
+
+  void deleteSnapshot() final override;
+
   void compress(
       const int solverNumber,
       CellInfo& cellInfo,
@@ -931,6 +1012,8 @@ protected:
   // make super class virtual function accessible
   using Solver::updateGlobalObservables;
 
+  void registerProfilingTags() override;
+
   /** @name Plugin points for derived solvers.
    *
    *  These are the macro kernels and user hooks solvers derived from
@@ -1117,6 +1200,23 @@ protected:
       const double        t,
       const double        dt,
       double* const       Q) = 0;
+
+  /**
+   * If true, the scheme does not change the solution @p luh of the cell
+   * as long as all its neighbours are inert too, e.g. dry cells of the
+   * shallow water equations.
+   *
+   * Cells which are inert and have only inert neighbours skip their update
+   * until a neighbour is not inert anymore.
+   *
+   * @param[in] luh        the cell's solution after the update (including the ghost layers).
+   * @param[in] cellCentre centre of the cell.
+   * @param[in] cellSize   extent of the cell in each coordinate direction.
+   */
+  virtual bool isInert(
+      const double* const                         luh,
+      const tarch::la::Vector<DIMENSIONS,double>& cellCentre,
+      const tarch::la::Vector<DIMENSIONS,double>& cellSize) {return false;}
   ///@}
 };
 
@@ -15,6 +15,7 @@
 
 #include <algorithm> // copy_n
 #include <iomanip>
+#include <sstream>
 #include <chrono>
 
 #include "LimitingADERDGSolver.h"
@@ -533,6 +534,13 @@ void exahype::solvers::LimitingADERDGSolver::copyTimeStepDataFromSolverPatch(
   limiterPatch.setTimeStepSize(solverPatch.getTimeStepSize());
 }
 
+int exahype::solvers::LimitingADERDGSolver::getJobCostClass(const SolverPatch& solverPatch) const {
+  const bool isTroubled = // see updateSolution(...)
+      solverPatch.getLevel()==getMaximumAdaptiveMeshLevel() &&
+      solverPatch.getRefinementStatus() >= _solver->_minRefinementStatusForTroubledCell-1;
+  return JobCostModel::getCostClass(isTroubled,solverPatch.getIsInert());
+}
+
 void exahype::solvers::LimitingADERDGSolver::fusedTimeStepOrRestrict(
     const int                                          solverNumber,
     CellInfo&                                          cellInfo,
@@ -548,7 +556,10 @@ void exahype::solvers::LimitingADERDGSolver::fusedTimeStepOrRestrict(
     // Write the previous limiter status back onto the patch for all cell description types
     solverPatch.setPreviousRefinementStatus(solverPatch.getRefinementStatus());
 
-    if ( ADERDGSolver::isLeaf(solverPatch) ) {
+    if ( ADERDGSolver::isLeaf(solverPatch) && solverPatch.getIsInactive() ) {
+      skipUpdateOfInactiveCell(solverPatch,cellInfo,false);
+    }
+    else if ( ADERDGSolver::isLeaf(solverPatch) ) {
       const bool isAMRSkeletonCell     = solverPatch.getAugmentationStatus() > ADERDGSolver::MinimumAugmentationStatusForVirtualRefining;
       const bool isAtRemoteBoundary    = tarch::la::oneEquals(boundaryMarkers,exahype::mappings::LevelwiseAdjacencyBookkeeping::RemoteAdjacencyIndex);
       const bool isSkeletonCell        = isAMRSkeletonCell || isAtRemoteBoundary;
@@ -559,10 +570,19 @@ void exahype::solvers::LimitingADERDGSolver::fusedTimeStepOrRestrict(
           !mustBeDoneImmediately
       ) {
         const auto predictionTimeStepData = _solver->getPredictionTimeStepData(solverPatch,true/*duringFusedTimeStep*/);
-        peano::datatraversal::TaskSet( new FusedTimeStepJob(
+        const int    costClass     = getJobCostClass(solverPatch);
+        const double estimatedCost = _jobCostModel.getEstimate(JobCostModel::JobKind::FusedTimeStep,costClass);
+        const int    priority      = getCostAwareTaskPriority(getTaskPriority(isLastTimeStepOfBatch),estimatedCost);
+        FusedTimeStepJob* job = new FusedTimeStepJob(
             *this,solverPatch,cellInfo,
             std::get<0>(predictionTimeStepData),std::get<1>(predictionTimeStepData),
-            isFirstTimeStepOfBatch,isLastTimeStepOfBatch,boundaryMarkers,isSkeletonCell) );
+            isFirstTimeStepOfBatch,isLastTimeStepOfBatch,boundaryMarkers,isSkeletonCell,
+            costClass,priority);
+        if ( isSkeletonCell ) { // results are sent to other ranks, do not delay them
+          peano::datatraversal::TaskSet spawn( job );
+        } else {
+          spawnOrBatchBackgroundJob( job, priority, estimatedCost );
+        }
       } else {
         const auto predictionTimeStepData = _solver->getPredictionTimeStepData(solverPatch,true/*duringFusedTimeStep*/);
         fusedTimeStepBody(
@@ -620,7 +640,7 @@ void exahype::solvers::LimitingADERDGSolver::fusedTimeStepBody(
   #endif
 
   updateSolution(solverPatch,cellInfo,isFirstTimeStepOfBatch,boundaryMarkers,
-                 isFirstTimeStepOfBatch/*addSurfaceIntegralContributionToUpdate*/);
+                 isFirstTimeStepOfBatch || solverPatch.getIsInert()/*addSurfaceIntegralContributionToUpdate*/);
   const bool isTroubled = checkIfCellIsTroubledAndDetermineMinAndMax(solverPatch,cellInfo);
 
   UpdateResult result;
@@ -629,7 +649,13 @@ void exahype::solvers::LimitingADERDGSolver::fusedTimeStepBody(
 
   reduce(solverPatch,cellInfo,result);
 
-  if (
+  _solver->determineIfCellIsInert(solverPatch,boundaryMarkers);
+
+  if ( _solver->deactivateIfInert(solverPatch) ) {
+    _solver->compress(solverPatch,isSkeletonCell);
+    solverPatch.setHasCompletedLastStep(true);
+  }
+  else if (
       solverPatch.getRefinementStatus()<_solver->_minRefinementStatusForTroubledCell &&
       SpawnPredictionAsBackgroundJob &&
       !mustBeDoneImmediately         &&
@@ -642,14 +668,14 @@ void exahype::solvers::LimitingADERDGSolver::fusedTimeStepBody(
             cellInfo._cellDescriptionsIndex,element,
             predictionTimeStamp,
             predictionTimeStepSize,
-            false/*is uncompressed*/,isSkeletonCell,isLastTimeStepOfBatch/*addVolumeIntegralResultToUpdate*/));
+            false/*is uncompressed*/,isSkeletonCell,isLastTimeStepOfBatch || solverPatch.getIsInert()/*addVolumeIntegralResultToUpdate*/));
   }
   else if ( solverPatch.getRefinementStatus()<_solver->_minRefinementStatusForTroubledCell ){
     _solver->predictionAndVolumeIntegralBody(
         solverPatch,
         predictionTimeStamp,
         predictionTimeStepSize,
-        false/*is uncompressed*/,isSkeletonCell,isLastTimeStepOfBatch/*addVolumeIntegralResultToUpdate*/);
+        false/*is uncompressed*/,isSkeletonCell,isLastTimeStepOfBatch || solverPatch.getIsInert()/*addVolumeIntegralResultToUpdate*/);
   } else {
     solverPatch.setHasCompletedLastStep(true);
   }
@@ -676,14 +702,17 @@ void exahype::solvers::LimitingADERDGSolver::predictionAndVolumeIntegral(
     const bool isSkeletonCell    = isAMRSkeletonCell || isAtRemoteBoundary;
     waitUntilCompletedLastStep(solverPatch,isSkeletonCell,false);
     if ( _solver->isLeaf(solverPatch) ) {
-      if ( solverPatch.getRefinementStatus()<_solver->_minRefinementStatusForTroubledCell ) { // only compute predictor for cells which need to communicate with ADER-DG neighbours
+      if (
+          solverPatch.getRefinementStatus()<_solver->_minRefinementStatusForTroubledCell && // only compute predictor for cells which need to communicate with ADER-DG neighbours
+          !_solver->deactivateIfInert(solverPatch)
+      ) {
         const auto predictionTimeStepData = _solver->getPredictionTimeStepData(solverPatch,false); // this is either the fused scheme or a predictor recomputation
         _solver->predictionAndVolumeIntegral(
             solverNumber,cellInfo,
             std::get<0>(predictionTimeStepData),
             std::get<1>(predictionTimeStepData),
             true,isAtRemoteBoundary,
-            FuseAllADERDGPhases || areRollbacksPossible()/*addVolumeIntegralResultToUpdate*/);
+            FuseAllADERDGPhases || areRollbacksPossible() || solverPatch.getIsInert()/*addVolumeIntegralResultToUpdate*/);
       }
     }
   }
@@ -742,7 +771,8 @@ void exahype::solvers::LimitingADERDGSolver::updateBody(
   if (CompressionAccuracy>0.0) { uncompress(solverPatch,cellInfo); }
 
   // the actual computations
-  updateSolution(solverPatch,cellInfo,true,boundaryMarkers,areRollbacksPossible()/*effect: add surface integral result to solution*/);
+  updateSolution(solverPatch,cellInfo,true,boundaryMarkers,
+      areRollbacksPossible() || solverPatch.getIsInert()/*effect: add surface integral result to solution*/);
   const bool isTroubled = checkIfCellIsTroubledAndDetermineMinAndMax(solverPatch,cellInfo);
 
   UpdateResult result;
@@ -751,6 +781,8 @@ void exahype::solvers::LimitingADERDGSolver::updateBody(
 
   reduce(solverPatch,cellInfo,result);
 
+  _solver->determineIfCellIsInert(solverPatch,boundaryMarkers);
+
   const bool isAtRemoteBoundary = tarch::la::oneEquals(boundaryMarkers,exahype::mappings::LevelwiseAdjacencyBookkeeping::RemoteAdjacencyIndex);
   if (CompressionAccuracy>0.0) { compress(solverPatch,cellInfo,isAtRemoteBoundary); }
 
@@ -772,8 +804,14 @@ void exahype::solvers::LimitingADERDGSolver::updateOrRestrict(
     solverPatch.setHasCompletedLastStep(false);
 
     const bool isAtRemoteBoundary    = tarch::la::oneEquals(boundaryMarkers,exahype::mappings::LevelwiseAdjacencyBookkeeping::RemoteAdjacencyIndex);
-    if ( _solver->isLeaf(solverPatch) && SpawnUpdateAsBackgroundJob ) {
-      peano::datatraversal::TaskSet( new UpdateJob(*this, solverPatch,cellInfo,boundaryMarkers ) );
+    if ( _solver->isLeaf(solverPatch) && solverPatch.getIsInactive() ) {
+      skipUpdateOfInactiveCell(solverPatch,cellInfo,isAtRemoteBoundary);
+    }
+    else if ( _solver->isLeaf(solverPatch) && SpawnUpdateAsBackgroundJob ) {
+      const int    costClass     = getJobCostClass(solverPatch);
+      const double estimatedCost = _jobCostModel.getEstimate(JobCostModel::JobKind::Update,costClass);
+      const int    priority      = getCostAwareTaskPriority(getHighPriorityTaskPriority(),estimatedCost);
+      spawnOrBatchBackgroundJob( new UpdateJob(*this,solverPatch,cellInfo,boundaryMarkers,costClass,priority), priority, estimatedCost );
     }
     else if ( _solver->isLeaf(solverPatch) ) {
       updateBody(solverPatch,cellInfo,boundaryMarkers);
@@ -792,6 +830,21 @@ void exahype::solvers::LimitingADERDGSolver::updateOrRestrict(
   }
 }
 
+void exahype::solvers::LimitingADERDGSolver::skipUpdateOfInactiveCell(
+    SolverPatch& solverPatch,
+    CellInfo&    cellInfo,
+    const bool   isAtRemoteBoundary) {
+  if (CompressionAccuracy>0.0) { uncompress(solverPatch,cellInfo); }
+
+  _solver->skipUpdateOfInactiveCell(solverPatch);
+  determineSolverMinAndMax(solverPatch,false);
+  reduce(solverPatch,cellInfo,UpdateResult());
+
+  if (CompressionAccuracy>0.0) { compress(solverPatch,cellInfo,isAtRemoteBoundary); }
+
+  solverPatch.setHasCompletedLastStep(true);
+}
+
 void exahype::solvers::LimitingADERDGSolver::uncompress(
     SolverPatch& solverPatch,CellInfo& cellInfo) const {
   _solver->uncompress(solverPatch);
@@ -864,6 +917,8 @@ void exahype::solvers::LimitingADERDGSolver::updateSolution(
       limiterStatus == _solver->_minRefinementStatusForTroubledCell-2;
 
   if ( isTroubledCellOrDirectNeighbour ) { // limiter update
+    profilers::ScopedTag profilingScope(getProfiler(),ProfilingPhase::Limiter);
+
     assertion1(solverPatch.getRefinementStatus()>0,solverPatch.toString());
     LimiterPatch& limiterPatch = getLimiterPatch(solverPatch,cellInfo);
 
@@ -898,6 +953,7 @@ exahype::solvers::LimitingADERDGSolver::checkIfCellIsTroubledAndDetermineMinAndM
   if ( OnlyStaticLimiting ) {
     return solverPatch.getRefinementStatus()>=_solver->_minRefinementStatusForTroubledCell;
   }
+  profilers::ScopedTag profilingScope(getProfiler(),ProfilingPhase::Limiter);
 
   bool isTroubled =
       !evaluateDiscreteMaximumPrincipleAndDetermineMinAndMax(solverPatch) ||
@@ -1236,6 +1292,7 @@ void exahype::solvers::LimitingADERDGSolver::rollbackSolutionGlobally(const int
         if ( solverPatch.getPreviousRefinementStatus() >= _solver->_minRefinementStatusForTroubledCell-2 ) {
           LimiterPatch& limiterPatch = getLimiterPatch(solverPatch,cellInfo);
           _limiter->swapSolutionAndPreviousSolution(limiterPatch); // roll back limiter (must exist!)
+          limiterPatch.setIsInert(false);
         } else {
           const int limiterElement = cellInfo.indexOfFiniteVolumesCellDescription(solverNumber);
           if ( limiterElement!=Solver::NotFound ) {
@@ -1255,6 +1312,44 @@ void exahype::solvers::LimitingADERDGSolver::rollbackSolutionGlobally(const int
   }
 }
 
+void exahype::solvers::LimitingADERDGSolver::storeSnapshot() {
+  _solver->storeSnapshot();
+  _limiter->storeSnapshot();
+}
+
+void exahype::solvers::LimitingADERDGSolver::storeSnapshot(const int solverNumber,CellInfo& cellInfo) {
+  _solver->storeSnapshot(solverNumber,cellInfo);
+  _limiter->storeSnapshot(solverNumber,cellInfo);
+}
+
+void exahype::solvers::LimitingADERDGSolver::restoreFromSnapshot() {
+  _solver->restoreFromSnapshot();
+  _limiter->restoreFromSnapshot();
+}
+
+void exahype::solvers::LimitingADERDGSolver::restoreFromSnapshot(const int solverNumber,CellInfo& cellInfo) {
+  _solver->restoreFromSnapshot(solverNumber,cellInfo);
+
+  const int solverElement = cellInfo.indexOfADERDGCellDescription(solverNumber);
+  if ( solverElement!=NotFound ) {
+    SolverPatch& solverPatch = cellInfo._ADERDGCellDescriptions[solverElement];
+    const bool hadLimiterPatch = _limiter->_snapshot.cells.count(cellInfo._cellDescriptionsIndex) > 0;
+    const bool hasLimiterPatch = cellInfo.indexOfFiniteVolumesCellDescription(solverNumber)!=NotFound;
+    if ( hadLimiterPatch && !hasLimiterPatch ) {
+      allocateLimiterPatch(solverPatch,cellInfo);
+    } else if ( !hadLimiterPatch && hasLimiterPatch ) {
+      deallocateLimiterPatch(solverPatch,cellInfo);
+    }
+  }
+
+  _limiter->restoreFromSnapshot(solverNumber,cellInfo);
+}
+
+void exahype::solvers::LimitingADERDGSolver::deleteSnapshot() {
+  _solver->deleteSnapshot();
+  _limiter->deleteSnapshot();
+}
+
 void exahype::solvers::LimitingADERDGSolver::rollbackSolutionLocally(
     const int  solverNumber,
     CellInfo&  cellInfo,
@@ -1955,6 +2050,23 @@ void exahype::solvers::LimitingADERDGSolver::toString (std::ostream& out) const
   out << _limiter->toString() << "}";
 }
 
+exahype::profilers::Profiler& exahype::solvers::LimitingADERDGSolver::getProfiler() const {
+  return _solver->getProfiler();
+}
+
+void exahype::solvers::LimitingADERDGSolver::setProfiler(std::unique_ptr<profilers::Profiler> profiler) {
+  _solver->setProfiler(std::move(profiler));
+}
+
+void exahype::solvers::LimitingADERDGSolver::logJobCostModel() const {
+  if ( CostAwareJobScheduling ) {
+    std::ostringstream stringstr;
+    stringstr << "estimated job cost per cell for solver "<<getIdentifier()<<":"<<std::endl;
+    _jobCostModel.toString(stringstr,1e6,"\u00B5s","\t\t");
+    logInfo("logJobCostModel()",stringstr.str());
+  }
+}
+
 exahype::solvers::Solver::CellProcessingTimes exahype::solvers::LimitingADERDGSolver::measureCellProcessingTimes(const int numberOfRuns) {
   // Setup
   const int cellDescriptionsIndex = ADERDGSolver::Heap::getInstance().createData(0,1);
@@ -2150,6 +2262,16 @@ exahype::solvers::Solver::CellProcessingTimes exahype::solvers::LimitingADERDGSo
     result._timeADERDGRiemann = time_sec / numberOfRuns;
   }
 
+  // Seed the job cost model; dry cells are assumed to be as expensive as wet ones until they are measured
+  for (int isDry=0; isDry<2; isDry++) {
+    const int costClass         = JobCostModel::getCostClass(false,isDry==1);
+    const int troubledCostClass = JobCostModel::getCostClass(true,isDry==1);
+    _jobCostModel.seed(JobCostModel::JobKind::Update,costClass,result._timeADERDGUpdate);
+    _jobCostModel.seed(JobCostModel::JobKind::Update,troubledCostClass,result._timeFV2ADERDGUpdate);
+    _jobCostModel.seed(JobCostModel::JobKind::FusedTimeStep,costClass,result._timeADERDGUpdate+result._maxTimePredictor);
+    _jobCostModel.seed(JobCostModel::JobKind::FusedTimeStep,troubledCostClass,result._timeFV2ADERDGUpdate+result._minTimePredictor);
+  }
+
   // Clean up
   solverPatch.setRefinementStatus(0);
   ensureNoUnrequiredLimiterPatchIsAllocatedOnComputeCell(solverPatch,cellInfo);
@@ -127,6 +127,19 @@ private:
   static tarch::logging::Log _log;
 
 
+  /**
+   * Estimated cost of the fused time step and update jobs per cell cost class.
+   *
+   * \see getJobCostClass
+   */
+  JobCostModel _jobCostModel;
+
+  /**
+   * @return the cost class of a solver patch: troubled if the patch
+   * is updated with the limiter, dry if it is inert.
+   */
+  int getJobCostClass(const SolverPatch& solverPatch) const;
+
   #ifdef Parallel
   std::vector<double> _receivedMax;
   std::vector<double> _receivedMin;
@@ -434,6 +447,18 @@ private:
       CellInfo&                                          cellInfo,
       const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers);
 
+  /**
+   * Keep the solution of an inactive solver patch, see ADERDGSolver::deactivateIfInert(...).
+   * Resets the minimum and maximum on the faces as the neighbour merges accumulate them,
+   * and contributes to the global observables.
+   *
+   * @param isAtRemoteBoundary if the cell is adjacent to a remote rank
+   */
+  void skipUpdateOfInactiveCell(
+      SolverPatch& solverPatch,
+      CellInfo&    cellInfo,
+      const bool   isAtRemoteBoundary);
+
  /**
    * Rollback to the previous time step, i.e,
    * overwrite the time step size and time stamp
@@ -579,6 +604,7 @@ private:
     const bool                                        _isLastTimeStepOfBatch;  // copy
     const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int> _boundaryMarkers;        // copy
     const bool                                        _isSkeletonJob;
+    const int                                         _costClass;
   public:
 
   /**
@@ -595,6 +621,8 @@ private:
    * @param isFirstTimeStepOfBatch if this is the first time step in a batch
    * @param isLastTimeStepOfBatch  if this is the last time step in a batch
    * @param isSkeletonJob          if this job was spawned in a cell belonging to the MPI or AMR skeleton
+   * @param costClass              the cost class of the solver patch, the measured time is attributed to it
+   * @param priority               the priority of the job
      */
     FusedTimeStepJob(
         LimitingADERDGSolver&                              solver,
@@ -605,7 +633,9 @@ private:
         const bool                                         isFirstTimeStepOfBatch,
         const bool                                         isLastTimeStepOfBatch,
         const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers,
-        const bool                                         isSkeletonJob);
+        const bool                                         isSkeletonJob,
+        const int                                          costClass,
+        const int                                          priority);
 
     bool run(bool runOnMasterThread) override;
   };
@@ -620,6 +650,7 @@ private:
    *
    * @note All update jobs have the same priority as their outcome is not directly
    * piped into an MPI send task. This is different to the result of the FusedTimeStepJob.
+   * Only the cost-aware job priorities raise the priority of expensive cells.
    */
   class UpdateJob: public tarch::multicore::jobs::Job {
     private:
@@ -627,6 +658,7 @@ private:
       SolverPatch&                                      _solverPatch;
       CellInfo                                          _cellInfo;
       const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int> _boundaryMarkers; // copy
+      const int                                         _costClass;
     public:
       /**
        * Construct an UpdateJob.
@@ -637,12 +669,16 @@ private:
        * @param     solverPatch     a cell description
        * @param     cellInfo        links to all cell descriptions associated with the cell
        * @param[in] boundaryMarkers per face, a flag indicating if the cell description is adjacent to a remote or domain boundary.
+       * @param     costClass       the cost class of the solver patch, the measured time is attributed to it
+       * @param     priority        a high priority, see getCostAwareTaskPriority(...)
        */
       UpdateJob(
           LimitingADERDGSolver&                              solver,
           SolverPatch&                                       solverPatch,
           CellInfo&                                          cellInfo,
-          const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers);
+          const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers,
+          const int                                          costClass,
+          const int                                          priority);
 
       bool run(bool runOnMasterThread) override;
       void prefetchData() override;
@@ -1059,6 +1095,27 @@ public:
     */
    void rollbackSolutionGlobally(const int  solverNumber,CellInfo&  cellInfo) const final override;
 
+  /**
+   * Stores the snapshots of the ADER-DG solver and the limiter.
+   */
+  void storeSnapshot() final override;
+
+  /**
+   * Stores the solver patch and, if allocated, the limiter patch.
+   */
+  void storeSnapshot(const int solverNumber,CellInfo& cellInfo) final override;
+
+  void restoreFromSnapshot() final override;
+
+  /**
+   * Restores the solver patch. Allocates a limiter patch if the snapshot has
+   * one and deallocates a limiter patch which was allocated after the snapshot
+   * was stored before the limiter patch is restored.
+   */
+  void restoreFromSnapshot(const int solverNumber,CellInfo& cellInfo) final override;
+
+  void deleteSnapshot() final override;
+
   /**
    * Reinitialises cells that have been subject to a limiter status change.
    * This method is invoked after the limiter status spreading.
@@ -1472,8 +1529,27 @@ public:
   // PROFILING
   ///////////////////////
 
+  /**
+   * Seeds the job cost model with the measured times.
+   */
   CellProcessingTimes measureCellProcessingTimes(const int numberOfRuns=100) override;
 
+  /**
+   * Log the estimated cost of the fused time step and update jobs per cell cost class.
+   *
+   * Does nothing if the cost-aware job scheduling is switched off.
+   * The estimates are rank-local.
+   */
+  void logJobCostModel() const;
+
+  /**
+   * The phases of the limiting solver are reported to
+   * the profiler of the ADER-DG solver.
+   */
+  profilers::Profiler& getProfiler() const final override;
+
+  void setProfiler(std::unique_ptr<profilers::Profiler> profiler) final override;
+
   /////////////////////////////////
   // USER HOOKS - Make inaccessible
   /////////////////////////////////
@@ -1,5 +1,7 @@
 #include "exahype/solvers/LimitingADERDGSolver.h"
 
+#include <chrono>
+
 #if defined(SharedTBB) && !defined(noTBBPrefetchesJobData)
 #include <immintrin.h>
 #endif
@@ -13,11 +15,11 @@ exahype::solvers::LimitingADERDGSolver::FusedTimeStepJob::FusedTimeStepJob(
   const bool                                         isFirstTimeStepOfBatch,
   const bool                                         isLastTimeStepOfBatch,
   const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers,
-  const bool                                         isSkeletonJob):
+  const bool                                         isSkeletonJob,
+  const int                                          costClass,
+  const int                                          priority):
   tarch::multicore::jobs::Job(
-      tarch::multicore::jobs::JobType::BackgroundTask,0,
-      getTaskPriority(isLastTimeStepOfBatch)
-  ),
+      tarch::multicore::jobs::JobType::BackgroundTask,0,priority),
   _solver(solver),
   _solverPatch(solverPatch),
   _cellInfo(cellInfo),
@@ -26,7 +28,8 @@ exahype::solvers::LimitingADERDGSolver::FusedTimeStepJob::FusedTimeStepJob(
   _isFirstTimeStepOfBatch(isFirstTimeStepOfBatch),
   _isLastTimeStepOfBatch (isLastTimeStepOfBatch),
   _boundaryMarkers(boundaryMarkers),
-  _isSkeletonJob(isSkeletonJob) {
+  _isSkeletonJob(isSkeletonJob),
+  _costClass(costClass) {
   NumberOfReductionJobs.fetch_add(1);
   if (_isSkeletonJob) {
     NumberOfSkeletonJobs.fetch_add(1);
@@ -36,12 +39,19 @@ exahype::solvers::LimitingADERDGSolver::FusedTimeStepJob::FusedTimeStepJob(
 }
 
 bool exahype::solvers::LimitingADERDGSolver::FusedTimeStepJob::run(bool runOnMasterThread) {
+  const std::chrono::steady_clock::time_point timeStart = std::chrono::steady_clock::now();
+
   _solver.fusedTimeStepBody(
       _solverPatch,_cellInfo,
       _predictionTimeStamp,_predictionTimeStepSize,
       _isFirstTimeStepOfBatch,_isLastTimeStepOfBatch,
       _boundaryMarkers,_isSkeletonJob,false/*mustBeDoneImmedetially*/);
 
+  if ( CostAwareJobScheduling ) {
+    const double time_sec = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-timeStart).count() * 1e-9;
+    _solver._jobCostModel.addMeasurement(JobCostModel::JobKind::FusedTimeStep,_costClass,time_sec);
+  }
+
   NumberOfReductionJobs.fetch_sub(1);
   assertion( NumberOfReductionJobs.load()>=0 );
   if (_isSkeletonJob) {
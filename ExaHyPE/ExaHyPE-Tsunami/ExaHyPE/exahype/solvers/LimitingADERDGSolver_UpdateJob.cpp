@@ -1,5 +1,7 @@
 #include "LimitingADERDGSolver.h"
 
+#include <chrono>
+
 #if defined(SharedTBB) && !defined(noTBBPrefetchesJobData)
 #include <immintrin.h>
 #endif
@@ -9,21 +11,30 @@ exahype::solvers::LimitingADERDGSolver::UpdateJob::UpdateJob(
   LimitingADERDGSolver&                              solver,
   SolverPatch&                                       solverPatch,
   CellInfo&                                          cellInfo,
-  const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers):
+  const tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>& boundaryMarkers,
+  const int                                          costClass,
+  const int                                          priority):
   tarch::multicore::jobs::Job(
-      tarch::multicore::jobs::JobType::BackgroundTask,0,
-      getHighPriorityTaskPriority()
+      tarch::multicore::jobs::JobType::BackgroundTask,0,priority
   ), // ! always high priority
   _solver(solver),
   _solverPatch(solverPatch),
   _cellInfo(cellInfo),
-  _boundaryMarkers(boundaryMarkers) {
+  _boundaryMarkers(boundaryMarkers),
+  _costClass(costClass) {
   NumberOfReductionJobs.fetch_add(1);
 }
 
 bool exahype::solvers::LimitingADERDGSolver::UpdateJob::run(bool runOnMasterThread) {
+  const std::chrono::steady_clock::time_point timeStart = std::chrono::steady_clock::now();
+
   _solver.updateBody(_solverPatch,_cellInfo,_boundaryMarkers);
 
+  if ( CostAwareJobScheduling ) {
+    const double time_sec = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-timeStart).count() * 1e-9;
+    _solver._jobCostModel.addMeasurement(JobCostModel::JobKind::Update,_costClass,time_sec);
+  }
+
   NumberOfReductionJobs.fetch_sub(1);
   assertion( NumberOfReductionJobs.load()>=0 );
 
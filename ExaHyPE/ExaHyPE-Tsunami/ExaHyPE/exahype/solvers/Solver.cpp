@@ -18,12 +18,15 @@
 #include "exahype/Cell.h"
 
 #include "tarch/multicore/Lock.h"
+#include "peano/datatraversal/TaskSet.h"
 #include "tarch/la/Scalar.h"
 
 #include "peano/heap/CompressedFloatingPointNumbers.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring> //memset
+#include <map>
 
 #include "../../../Peano/tarch/multicore/Jobs.h"
 #include "LimitingADERDGSolver.h"
@@ -81,8 +84,15 @@ void exahype::moveDataHeapEntries(
 
 double exahype::solvers::Solver::PipedUncompressedBytes = 0;
 double exahype::solvers::Solver::PipedCompressedBytes = 0;
+double exahype::solvers::Solver::DataHeapBytes = 0;
+double exahype::solvers::Solver::CompressedDataHeapBytes = 0;
 #endif
 
+namespace {
+  // same order as Solver::ProfilingPhase
+  constexpr const char* profilingPhases[]{"predictor","riemann","update","limiter","plotter"};
+}
+
 tarch::logging::Log exahype::solvers::Solver::_log( "exahype::solvers::Solver");
 
 std::atomic<bool> exahype::solvers::Solver::AllSolversAreStable = ATOMIC_VAR_INIT(false);
@@ -99,6 +109,7 @@ bool exahype::solvers::Solver::OnlyStaticLimiting                 = false;
 bool exahype::solvers::Solver::FuseAllADERDGPhases                = false;
 double exahype::solvers::Solver::FusedTimeSteppingRerunFactor     = 0.99;
 double exahype::solvers::Solver::FusedTimeSteppingDiffusionFactor = 0.99;
+int    exahype::solvers::Solver::LocalTimeSteppingLevels          = 2;
 
 bool exahype::solvers::Solver::DisableMetadataExchangeDuringTimeSteps = false;
 bool exahype::solvers::Solver::DisablePeanoNeighbourExchangeInTimeSteps = false;
@@ -125,6 +136,159 @@ std::atomic<int> exahype::solvers::Solver::NumberOfReductionJobs(0);
 std::atomic<int> exahype::solvers::Solver::NumberOfEnclaveJobs(0);
 std::atomic<int> exahype::solvers::Solver::NumberOfSkeletonJobs(0);
 
+bool   exahype::solvers::Solver::CostAwareJobScheduling = false;
+bool   exahype::solvers::Solver::CostAwareJobPriorities = false;
+double exahype::solvers::Solver::JobGrainTime           = 2e-4;
+
+namespace {
+  /**
+   * Runs a batch of cheap jobs one after another.
+   */
+  class JobBatch: public tarch::multicore::jobs::Job {
+    private:
+      std::vector<tarch::multicore::jobs::Job*> _jobs;
+    public:
+      JobBatch(std::vector<tarch::multicore::jobs::Job*>& jobs,const int priority):
+        tarch::multicore::jobs::Job(tarch::multicore::jobs::JobType::BackgroundTask,0,priority) {
+        _jobs.swap(jobs);
+      }
+
+      bool run(bool runOnMasterThread) override {
+        for (std::size_t i=0; i<_jobs.size(); i++) {
+          if ( i+1 < _jobs.size() ) {
+            _jobs[i+1]->prefetchData();
+          }
+          while ( _jobs[i]->run(runOnMasterThread) ) {} // a job might ask to be rerun
+          delete _jobs[i];
+        }
+        _jobs.clear();
+        return false;
+      }
+
+      void prefetchData() override {
+        if ( !_jobs.empty() ) {
+          _jobs[0]->prefetchData();
+        }
+      }
+  };
+
+  struct PendingJobBatch {
+    std::vector<tarch::multicore::jobs::Job*> jobs;
+    double                                    estimatedCost = 0.0;
+  };
+
+  tarch::multicore::BooleanSemaphore PendingJobBatchesSemaphore;
+  std::map<int,PendingJobBatch>      PendingJobBatches; // key: priority
+  std::atomic<int>                   NumberOfPendingBatchedJobs(0);
+}
+
+exahype::solvers::Solver::JobCostModel::JobCostModel() {
+  for (std::atomic<double>& estimate : _estimates) {
+    estimate.store(-1.0);
+  }
+}
+
+std::string exahype::solvers::Solver::JobCostModel::toString(const int costClass) {
+  switch (costClass) {
+    case 0:  return "wet";
+    case 1:  return "dry";
+    case 2:  return "troubled-wet";
+    case 3:  return "troubled-dry";
+    default:
+      logError("toString(const int)","Cost class not supported.");
+      std::abort();
+      return "";
+  }
+}
+
+void exahype::solvers::Solver::JobCostModel::seed(const JobKind& jobKind,const int costClass,const double seconds) {
+  assertion2(costClass>=0 && costClass<NumberOfCostClasses,costClass,seconds);
+  _estimates[static_cast<int>(jobKind)*NumberOfCostClasses+costClass].store(seconds);
+}
+
+void exahype::solvers::Solver::JobCostModel::addMeasurement(const JobKind& jobKind,const int costClass,const double seconds) {
+  assertion2(costClass>=0 && costClass<NumberOfCostClasses,costClass,seconds);
+  std::atomic<double>& estimate = _estimates[static_cast<int>(jobKind)*NumberOfCostClasses+costClass];
+  double oldEstimate = estimate.load();
+  double newEstimate;
+  do {
+    newEstimate = ( oldEstimate < 0.0 ) ? seconds : oldEstimate + MeasurementWeight * (seconds - oldEstimate);
+  } while ( !estimate.compare_exchange_weak(oldEstimate,newEstimate) );
+}
+
+double exahype::solvers::Solver::JobCostModel::getEstimate(const JobKind& jobKind,const int costClass) const {
+  assertion1(costClass>=0 && costClass<NumberOfCostClasses,costClass);
+  return _estimates[static_cast<int>(jobKind)*NumberOfCostClasses+costClass].load();
+}
+
+void exahype::solvers::Solver::JobCostModel::toString(std::ostream& out,const double conversion,const std::string& unit,const std::string& prefix) const {
+  const char* jobKinds[NumberOfJobKinds] = { "fused time step", "update" };
+  for (int jobKind=0; jobKind<NumberOfJobKinds; jobKind++) {
+    out << prefix << jobKinds[jobKind] << ":";
+    for (int costClass=0; costClass<NumberOfCostClasses; costClass++) {
+      const double estimate = _estimates[jobKind*NumberOfCostClasses+costClass].load();
+      out << " " << toString(costClass) << "=";
+      if ( estimate < 0.0 ) {
+        out << "n/a";
+      } else {
+        out << estimate*conversion << " " << unit;
+      }
+    }
+    out << std::endl;
+  }
+}
+
+int exahype::solvers::Solver::getCostAwareTaskPriority(const int priority,const double estimatedCost) {
+  if ( !CostAwareJobPriorities || estimatedCost < JobGrainTime ) {
+    return priority;
+  }
+  const int raise = 1 + static_cast<int>(std::log2(estimatedCost/JobGrainTime));
+  return priority + std::min(raise,tarch::multicore::DefaultPriority-1);
+}
+
+void exahype::solvers::Solver::spawnOrBatchBackgroundJob(
+    tarch::multicore::jobs::Job* job,const int priority,const double estimatedCost) {
+  if ( !CostAwareJobScheduling || estimatedCost < 0.0 || estimatedCost >= JobGrainTime ) {
+    peano::datatraversal::TaskSet spawn(job);
+    return;
+  }
+
+  std::vector<tarch::multicore::jobs::Job*> batch;
+  tarch::multicore::Lock lock(PendingJobBatchesSemaphore);
+  PendingJobBatch& pendingBatch = PendingJobBatches[priority];
+  pendingBatch.jobs.push_back(job);
+  pendingBatch.estimatedCost += estimatedCost;
+  NumberOfPendingBatchedJobs.fetch_add(1);
+  if ( pendingBatch.estimatedCost >= JobGrainTime ) {
+    batch.swap(pendingBatch.jobs);
+    pendingBatch.estimatedCost = 0.0;
+    NumberOfPendingBatchedJobs.fetch_sub(static_cast<int>(batch.size()));
+  }
+  lock.free();
+
+  if ( !batch.empty() ) {
+    peano::datatraversal::TaskSet spawn(new JobBatch(batch,priority));
+  }
+}
+
+void exahype::solvers::Solver::spawnPendingJobBatches() {
+  if ( NumberOfPendingBatchedJobs.load()==0 ) {
+    return;
+  }
+
+  std::map<int,PendingJobBatch> batches;
+  tarch::multicore::Lock lock(PendingJobBatchesSemaphore);
+  batches.swap(PendingJobBatches);
+  NumberOfPendingBatchedJobs.store(0);
+  lock.free();
+
+  for (auto& batch : batches) {
+    if ( !batch.second.jobs.empty() ) {
+      peano::datatraversal::TaskSet spawn(new JobBatch(batch.second.jobs,batch.first));
+    }
+  }
+}
+
 std::string exahype::solvers::Solver::toString(const JobType& jobType) {
   switch (jobType) {
     case JobType::AMRJob:       return "AMRJob";
@@ -156,6 +320,8 @@ void exahype::solvers::Solver::ensureAllJobsHaveTerminated(JobType jobType) {
   VT_begin(ensureAllJobsHaveTerminatedHandle);
   #endif
 
+  spawnPendingJobBatches();
+
   int queuedJobs = getNumberOfQueuedJobs(jobType);
   bool finishedWait = queuedJobs == 0;
 
@@ -225,7 +391,25 @@ exahype::solvers::Solver::Solver(
       _timeStepping(timeStepping),
       _coarsestMeshLevel(std::numeric_limits<int>::max()),
       _coarsestMeshSize(std::numeric_limits<double>::infinity()),
-      _profiler(std::move(profiler)) {}
+      _profiler(std::move(profiler)) {
+  Solver::registerProfilingTags();
+}
+
+void exahype::solvers::Solver::registerProfilingTags() {
+  for (const char* phase : profilingPhases) {
+    _profiler->addTag(phase);
+  }
+}
+
+exahype::profilers::Profiler& exahype::solvers::Solver::getProfiler() const {
+  return *_profiler;
+}
+
+void exahype::solvers::Solver::setProfiler(std::unique_ptr<profilers::Profiler> profiler) {
+  _profiler = std::move(profiler);
+  registerProfilingTags();
+  assertion1(_profiler->getTagId("predictor")==static_cast<int>(ProfilingPhase::Predictor),_identifier);
+}
 
 
 std::string exahype::solvers::Solver::getIdentifier() const {
@@ -245,6 +429,7 @@ std::string exahype::solvers::Solver::toString(const exahype::solvers::Solver::T
   switch (param) {
     case TimeStepping::Global:      return "global";
     case TimeStepping::GlobalFixed: return "globalfixed";
+    case TimeStepping::Local:       return "local";
   }
   return "undefined";
 }
@@ -32,6 +32,7 @@
 #include "tarch/la/Vector.h"
 #include "tarch/la/VectorVectorOperations.h"
 #include "tarch/multicore/BooleanSemaphore.h"
+#include "tarch/multicore/Jobs.h"
 
 #include "peano/utils/Globals.h"
 #include "peano/grid/VertexEnumerator.h"
@@ -588,6 +589,15 @@ public:
   #ifdef TrackGridStatistics
   static double PipedUncompressedBytes;
   static double PipedCompressedBytes;
+
+  /**
+   * Bytes currently held by the compressible cell arrays of the ADER-DG and
+   * finite volumes solvers (including the limiter patches) on the DataHeap and
+   * on the CompressedDataHeap, respectively.
+   * Guarded by exahype::HeapSemaphore.
+   */
+  static double DataHeapBytes;
+  static double CompressedDataHeapBytes;
   #endif
 
   /** @name Global profiling options
@@ -658,6 +668,14 @@ public:
    */
   static double FusedTimeSteppingDiffusionFactor;
 
+  /**
+   * The maximum level k of the local time stepping, i.e.
+   * the largest time step size ratio between two cells is 2^k.
+   *
+   * @see TimeStepping::Local
+   */
+  static int LocalTimeSteppingLevels;
+
   /**
    * The number of Prediction,PredictionRerun,PredictionOrLocalRecomputation<
    * and FusedTimeStep iterations we need to run per time step.
@@ -754,6 +772,90 @@ public:
    */
   static std::atomic<int> NumberOfSkeletonJobs;
 
+  /**
+   * Set to true if the solvers should spawn jobs according to the
+   * estimated cost of the cells they process.
+   *
+   * Jobs which are estimated to take less than JobGrainTime are not spawned
+   * one by one but collected into batches which are spawned as single job
+   * once their estimated cost reaches JobGrainTime. This keeps the scheduling
+   * overhead low for cheap cells.
+   *
+   * \see spawnOrBatchBackgroundJob
+   */
+  static bool CostAwareJobScheduling;
+  /**
+   * Set to true if the priority of jobs spawned one by one should
+   * grow with their estimated cost, so that expensive cells are started
+   * early and do not become stragglers.
+   *
+   * Is only switched on if the job system orders jobs by priority and does not
+   * wait for jobs of a particular priority.
+   *
+   * \see getCostAwareTaskPriority
+   */
+  static bool CostAwareJobPriorities;
+  /**
+   * The estimated time (sec) a job should take at least.
+   */
+  static double JobGrainTime;
+
+  /**
+   * Running estimates of the time (sec) a solver's jobs take
+   * to process a single cell, per job kind and cell cost class.
+   *
+   * The estimates are updated by every job with an exponential moving
+   * average. They can be seeded by the cell processing time measurements.
+   *
+   * All operations are thread-safe.
+   */
+  class JobCostModel {
+    public:
+      enum class JobKind { FusedTimeStep=0, Update=1 };
+
+      static constexpr int NumberOfJobKinds    = 2;
+      static constexpr int NumberOfCostClasses = 4;
+
+      /**
+       * @param isTroubled the cell is updated with the limiter
+       * @param isDry      the cell is inert, e.g. dry in a shallow water simulation
+       *
+       * @return the cost class of a cell.
+       */
+      static int getCostClass(const bool isTroubled,const bool isDry) {
+        return 2*static_cast<int>(isTroubled) + static_cast<int>(isDry);
+      }
+
+      static std::string toString(const int costClass);
+
+      JobCostModel();
+
+      /**
+       * Overwrite the estimate with @p seconds.
+       */
+      void seed(const JobKind& jobKind,const int costClass,const double seconds);
+
+      /**
+       * Blend @p seconds into the estimate.
+       */
+      void addMeasurement(const JobKind& jobKind,const int costClass,const double seconds);
+
+      /**
+       * @return the estimate (sec) or a negative value if nothing has been measured yet.
+       */
+      double getEstimate(const JobKind& jobKind,const int costClass) const;
+
+      void toString(std::ostream& out,const double conversion=1e6,const std::string& unit="\u00B5s",const std::string& prefix="") const;
+
+    private:
+      /**
+       * Weight of a new measurement.
+       */
+      static constexpr double MeasurementWeight = 0.1;
+
+      std::atomic<double> _estimates[NumberOfJobKinds*NumberOfCostClasses];
+  };
+
   /**
    * The type of a solver.
    */
@@ -771,10 +873,34 @@ public:
      * In the fixed time stepping mode, we assume that each cell advanced in
      * time with the prescribed time step size. No CFL condition is checked.
      */
-    GlobalFixed
-    // Local, Anarchic
+    GlobalFixed,
+    /**
+     * In the local time stepping mode, each cell advances with
+     * 2^k times the solver's (minimum) time step size where k is the largest
+     * level in [0,LocalTimeSteppingLevels] its admissible time step size allows.
+     * All cells are synchronised after 2^LocalTimeSteppingLevels time steps of the
+     * solver (a macro time step). The solver's time step size
+     * is adapted at the end of a macro time step. Within a macro time step, it is
+     * halved (and the remaining steps of the macro time step doubled) whenever it
+     * violates the CFL condition of one of the cells.
+     *
+     * Faces are merged whenever one of the adjacent cells completes its time step.
+     * The result is weighted with the face's time step size (the smaller of the two cells')
+     * and accumulated per face of the cells, which keeps the scheme conservative.
+     *
+     * Is only supported by the ADERDGSolver on a uniform mesh,
+     * without fusing all algorithmic steps, and without MPI.
+     */
+    Local
+    // Anarchic
   };
 
+  /**
+   * The algorithmic phases every solver reports to its profiler.
+   * They are registered first, so the values are the tag ids.
+   */
+  enum class ProfilingPhase { Predictor = 0, Riemann, Update, Limiter, Plotter };
+
   /**
    * The refinement control states
    * returned by the user functions.
@@ -1146,6 +1272,7 @@ public:
     #endif
 
     if ( !cellDescription.getHasCompletedLastStep() ) {
+      spawnPendingJobBatches();
       peano::datatraversal::TaskSet::startToProcessBackgroundJobs();
     }
     while ( !cellDescription.getHasCompletedLastStep() ) {
@@ -1199,6 +1326,38 @@ public:
     return tarch::multicore::DefaultPriority*8;
   }
 
+  /**
+   * @return @p priority raised by one level per doubling of @p estimatedCost beyond
+   * JobGrainTime if CostAwareJobPriorities is set. Otherwise, @p priority.
+   *
+   * The raise stays below tarch::multicore::DefaultPriority, so that a default
+   * priority job is never ranked as high as a high priority job.
+   *
+   * @param estimatedCost the estimated cost (sec) of the job; negative if unknown.
+   */
+  static int getCostAwareTaskPriority(const int priority,const double estimatedCost);
+
+  /**
+   * Spawn @p job as background job or, if CostAwareJobScheduling is set and the
+   * job is estimated to be cheaper than JobGrainTime, append it to the pending
+   * batch of jobs with the same priority. A pending batch is spawned as single
+   * job as soon as its estimated cost reaches JobGrainTime.
+   *
+   * The job must be constructed with @p priority. It must count itself in the job
+   * counters on construction, as the spawned jobs do, so that
+   * ensureAllJobsHaveTerminated(...) notices batched jobs.
+   *
+   * @param estimatedCost the estimated cost (sec) of the job; negative if unknown.
+   */
+  static void spawnOrBatchBackgroundJob(tarch::multicore::jobs::Job* job,const int priority,const double estimatedCost);
+
+  /**
+   * Spawn all pending batches of jobs.
+   *
+   * Must be called before waiting for a job which might have been batched.
+   */
+  static void spawnPendingJobBatches();
+
  /**
   * Return a string representation for the type @p param.
   */
@@ -1327,6 +1486,12 @@ public:
    */
   std::unique_ptr<profilers::Profiler> _profiler;
 
+  /**
+   * Registers the profiling phases with the profiler.
+   * Subclasses append their own tags.
+   */
+  virtual void registerProfilingTags();
+
  public:
   Solver(const std::string& identifier, exahype::solvers::Solver::Type type,
          int numberOfVariables, int numberOfParameters,
@@ -1409,6 +1574,20 @@ public:
    */
   Type getType() const;
 
+  /**
+   * Returns the profiler of this solver.
+   */
+  virtual profilers::Profiler& getProfiler() const;
+
+  /**
+   * Replaces the profiler of this solver, e.g. by the one
+   * selected in the specification file, and registers the
+   * solver's tags with it.
+   *
+   * Must be called before the first time step.
+   */
+  virtual void setProfiler(std::unique_ptr<profilers::Profiler> profiler);
+
   /**
    * Returns the time stepping algorithm this solver is using.
    */
@@ -1824,6 +2003,42 @@ public:
    */
   virtual void rollbackSolutionGlobally(const int solverNumber,CellInfo& cellInfo) const = 0;
 
+  /**
+   * Store the solver's time step data and global observables in a snapshot
+   * and discard the cells of a previous snapshot.
+   *
+   * A snapshot lets the compression benchmark run every threshold
+   * from the same state, see exahype::runners::Runner::runCompressionBenchmark(...).
+   */
+  virtual void storeSnapshot() = 0;
+
+  /**
+   * Store a copy of the arrays and the time stepping data of the solver's
+   * cell descriptions in the cell in the snapshot.
+   *
+   * @note Must be called in a serial traversal while no background jobs are running.
+   */
+  virtual void storeSnapshot(const int solverNumber,CellInfo& cellInfo) = 0;
+
+  /**
+   * Restore the time step data and global observables from the snapshot.
+   */
+  virtual void restoreFromSnapshot() = 0;
+
+  /**
+   * Restore the arrays and the time stepping data of the solver's cell
+   * descriptions in the cell from the snapshot. Cells which have been
+   * refined or erased since the snapshot was stored are not restored.
+   *
+   * @note Must be called in a serial traversal while no background jobs are running.
+   */
+  virtual void restoreFromSnapshot(const int solverNumber,CellInfo& cellInfo) = 0;
+
+  /**
+   * Free the memory held by the snapshot.
+   */
+  virtual void deleteSnapshot() = 0;
+
   /**
    * Explicitly ask the solver to compress
    * a cell description.
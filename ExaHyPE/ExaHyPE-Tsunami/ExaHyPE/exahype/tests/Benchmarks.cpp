@@ -0,0 +1,36 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/Benchmarks.h"
+
+#include "exahype/tests/kernels/c/FiniteVolumesSWETest.h"
+#include "exahype/tests/kernels/c/LimiterKernelTest.h"
+#include "exahype/tests/kernels/c/SpaceTimePredictorAoSoATest.h"
+
+int exahype::tests::runBenchmarks() {
+  int numberOfErrors = 0;
+
+  exahype::tests::c::LimiterKernelTest limiterKernelTest;
+  limiterKernelTest.runBenchmarks();
+  numberOfErrors += limiterKernelTest.getNumberOfErrors();
+
+  exahype::tests::c::SpaceTimePredictorAoSoATest spaceTimePredictorAoSoATest;
+  spaceTimePredictorAoSoATest.runBenchmarks();
+  numberOfErrors += spaceTimePredictorAoSoATest.getNumberOfErrors();
+
+  exahype::tests::c::FiniteVolumesSWETest finiteVolumesSWETest;
+  finiteVolumesSWETest.runBenchmarks();
+  numberOfErrors += finiteVolumesSWETest.getNumberOfErrors();
+
+  return numberOfErrors;
+}
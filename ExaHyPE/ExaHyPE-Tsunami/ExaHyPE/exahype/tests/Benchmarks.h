@@ -0,0 +1,34 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_BENCHMARKS_H_
+#define _EXAHYPE_TESTS_BENCHMARKS_H_
+
+namespace exahype {
+namespace tests {
+
+/**
+ * Run the kernel micro-benchmarks (command line option --benchmarks).
+ *
+ * The benchmarks time kernels against the implementations they replaced.
+ * They reuse the fixtures of the corresponding unit tests but are not
+ * part of the unit test suite (--tests), which only checks correctness.
+ *
+ * @return the number of failed sanity checks of the benchmarked kernels.
+ */
+int runBenchmarks();
+
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_BENCHMARKS_H_
@@ -55,6 +55,8 @@ class ElasticityKernelTest : public tarch::tests::TestCase {
   static constexpr int Order              = 4;
   static constexpr int MaxPicardIterations     = -1;
   static constexpr bool UseMaxPicardIterations = false;
+  static constexpr double PicardTolerance      = 1e-7;
+  static constexpr bool UseTaylorInitialGuess  = false;
   static constexpr double CFL             = 0.9;
 
   static constexpr bool UseLobattoBasis = true;
@@ -0,0 +1,183 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/kernels/c/FiniteVolumesSWETest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "tarch/la/Vector.h"
+#include "tarch/tests/TestCaseFactory.h"
+#include "tarch/timing/Watch.h"
+
+#if DIMENSIONS == 2
+#include "kernels/finitevolumes/swe/c/swe.h"
+
+#include "exahype/tests/kernels/c/SWETestSolver.h"
+#endif
+
+#ifndef ALIGNMENT
+registerTest(exahype::tests::c::FiniteVolumesSWETest)
+#endif
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::c::FiniteVolumesSWETest::_log( "exahype::tests::c::FiniteVolumesSWETest" );
+
+#if DIMENSIONS == 2
+
+namespace {
+
+typedef exahype::tests::c::SWETestSolver<> TestSolver;
+
+constexpr int CellsPerRow = TestSolver::PatchSize+2*TestSolver::GhostLayerWidth;
+
+/**
+ * Rough bathymetry with about a fifth of the cells dry or nearly dry.
+ * With @p lakeAtRest, the free surface h+b is flat and the water still.
+ */
+std::vector<double> initialPatch(const bool lakeAtRest) {
+  std::vector<double> luh(CellsPerRow*CellsPerRow*TestSolver::NumberOfVariables);
+  for (int j = 0; j < CellsPerRow; j++) {
+    for (int k = 0; k < CellsPerRow; k++) {
+      double* Q = luh.data() + (j*CellsPerRow+k)*TestSolver::NumberOfVariables;
+      const double wave = std::sin(1.3*j+0.7*k);
+      Q[3] = 0.3*std::abs(std::cos(0.9*j*k+0.4*k));
+      if ( lakeAtRest ) {
+        Q[0] = std::max(0.0, 0.5-Q[3]);
+        Q[1] = 0.0;
+        Q[2] = 0.0;
+      } else {
+        Q[0] = (j+2*k)%5==0 ? 0.002*(k%2) : 0.5+0.4*wave;
+        Q[1] = Q[0]*0.3*std::cos(2.1*j);
+        Q[2] = -Q[0]*0.2*wave;
+      }
+    }
+  }
+  return luh;
+}
+
+template <bool useVectPDE>
+double solutionUpdate(TestSolver& solver, std::vector<double>& luh) {
+  const tarch::la::Vector<DIMENSIONS, double> cellCentre(0.5, 0.5);
+  const tarch::la::Vector<DIMENSIONS, double> cellSize(1.0, 1.0);
+  return kernels::finitevolumes::swe::c::solutionUpdate<
+      false, false, true, false, false, kernels::finitevolumes::commons::c::minmod,
+      TestSolver, useVectPDE>(solver, luh.data(), cellCentre, cellSize, 0.0, 0.05);
+}
+
+}  // namespace
+
+#endif  // DIMENSIONS == 2
+
+namespace exahype {
+namespace tests {
+namespace c {
+
+FiniteVolumesSWETest::FiniteVolumesSWETest()
+    : tarch::tests::TestCase("exahype::tests::c::FiniteVolumesSWETest") {}
+
+FiniteVolumesSWETest::~FiniteVolumesSWETest() {}
+
+void FiniteVolumesSWETest::run() {
+  #if DIMENSIONS == 2
+  testMethod(testStreamedAgreesWithReference);
+  testMethod(testLakeAtRest);
+  #endif
+}
+
+void FiniteVolumesSWETest::runBenchmarks() {
+  #if DIMENSIONS == 2
+  benchmark();
+  #endif
+}
+
+#if DIMENSIONS == 2
+
+void FiniteVolumesSWETest::testStreamedAgreesWithReference() {
+  logInfo("testStreamedAgreesWithReference()", "Test swe finite volumes, face-by-face vs row-streamed, DIM=2");
+
+  TestSolver solver;
+  std::vector<double> reference = initialPatch(false);
+  std::vector<double> streamed  = reference;
+
+  const double dtReference = solutionUpdate<false>(solver, reference);
+  const double dtStreamed  = solutionUpdate<true>(solver, streamed);
+
+  // bitwise
+  validateNumericalEqualsWithEpsWithParams1(dtStreamed, dtReference, 0.0, dtReference);
+  for (size_t i = 0; i < reference.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(streamed[i], reference[i], 0.0, i);
+  }
+}
+
+void FiniteVolumesSWETest::testLakeAtRest() {
+  logInfo("testLakeAtRest()", "Test swe finite volumes well-balancedness, DIM=2");
+
+  TestSolver solver;
+  const std::vector<double> initial = initialPatch(true);
+  std::vector<double> luh = initial;
+  solutionUpdate<true>(solver, luh);
+
+  for (int j = TestSolver::GhostLayerWidth; j < CellsPerRow-TestSolver::GhostLayerWidth; j++) {
+    for (int k = TestSolver::GhostLayerWidth; k < CellsPerRow-TestSolver::GhostLayerWidth; k++) {
+      for (int l = 0; l < TestSolver::NumberOfVariables; l++) {
+        const int i = (j*CellsPerRow+k)*TestSolver::NumberOfVariables+l;
+        validateNumericalEqualsWithParams4(luh[i], initial[i], j, k, l, luh[i]-initial[i]);
+      }
+    }
+  }
+}
+
+void FiniteVolumesSWETest::benchmark() {
+  const int iterations = 20000;
+  TestSolver solver;
+  const std::vector<double> initial = initialPatch(false);
+  std::vector<double> luh = initial;
+  tarch::timing::Watch watch("exahype::tests::c::FiniteVolumesSWETest", "benchmark()", false);
+
+  solutionUpdate<false>(solver, luh); // warm up
+  watch.startTimer();
+  for (int i = 0; i < iterations; i++) {
+    std::copy(initial.begin(), initial.end(), luh.begin());
+    solutionUpdate<false>(solver, luh);
+  }
+  watch.stopTimer();
+  const double reference = watch.getCalendarTime() / iterations;
+
+  solutionUpdate<true>(solver, luh);
+  watch.startTimer();
+  for (int i = 0; i < iterations; i++) {
+    std::copy(initial.begin(), initial.end(), luh.begin());
+    solutionUpdate<true>(solver, luh);
+  }
+  watch.stopTimer();
+  const double streamed = watch.getCalendarTime() / iterations;
+
+  logInfo("benchmark()", "PatchSize=" << TestSolver::PatchSize <<
+          ": face-by-face " << reference*1e6 << " us, row-streamed " << streamed*1e6 <<
+          " us (" << reference/streamed << "x)");
+}
+
+#endif  // DIMENSIONS == 2
+
+}  // namespace c
+}  // namespace tests
+}  // namespace exahype
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", on)
+#endif
@@ -0,0 +1,57 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_FINITE_VOLUMES_SWE_TEST_H_
+#define _EXAHYPE_TESTS_FINITE_VOLUMES_SWE_TEST_H_
+
+#include "peano/utils/Globals.h"
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace tests {
+namespace c {
+
+/**
+ * Tests the 2D swe finite volumes scheme: the row-streamed face sweep
+ * has to reproduce the per-face reference mode bit by bit, and a lake at
+ * rest over rough bathymetry with dry cells has to stay at rest.
+ * 2D only.
+ */
+class FiniteVolumesSWETest : public tarch::tests::TestCase {
+ public:
+  FiniteVolumesSWETest();
+  virtual ~FiniteVolumesSWETest();
+
+  void run() override;
+
+  /**
+   * Times all modes of the face sweep.
+   * Not part of run(), cf. exahype::tests::runBenchmarks().
+   */
+  void runBenchmarks();
+
+ private:
+  static tarch::logging::Log _log;
+
+  void testStreamedAgreesWithReference();
+  void testLakeAtRest();
+
+  void benchmark();
+};
+
+}  // namespace c
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_FINITE_VOLUMES_SWE_TEST_H_
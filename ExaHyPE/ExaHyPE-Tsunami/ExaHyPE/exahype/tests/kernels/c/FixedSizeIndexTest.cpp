@@ -0,0 +1,89 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/kernels/c/FixedSizeIndexTest.h"
+
+#include "tarch/tests/TestCaseFactory.h"
+
+#include "kernels/KernelUtils.h"
+
+registerTest(exahype::tests::c::FixedSizeIndexTest)
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::c::FixedSizeIndexTest::_log( "exahype::tests::c::FixedSizeIndexTest" );
+
+exahype::tests::c::FixedSizeIndexTest::FixedSizeIndexTest()
+    : tarch::tests::TestCase("exahype::tests::c::FixedSizeIndexTest") {}
+
+exahype::tests::c::FixedSizeIndexTest::~FixedSizeIndexTest() {}
+
+void exahype::tests::c::FixedSizeIndexTest::run() {
+  testMethod(testAgreesWithRuntimeIndex);
+}
+
+void exahype::tests::c::FixedSizeIndexTest::testAgreesWithRuntimeIndex() {
+  kernels::idx2 idx2(3, 5);
+  kernels::cidx2<3, 5> cidx2;
+  validateEquals(cidx2.size, 3 * 5);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 5; j++) {
+      validateEquals(cidx2(i, j), idx2(i, j));
+    }
+  }
+
+  kernels::idx3 idx3(2, 3, 4);
+  kernels::cidx3<2, 3, 4> cidx3;
+  validateEquals(cidx3.size, 2 * 3 * 4);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 4; k++) {
+        validateEquals(cidx3(i, j, k), idx3(i, j, k));
+      }
+    }
+  }
+
+  kernels::idx4 idx4(2, 3, 4, 5);
+  kernels::cidx4<2, 3, 4, 5> cidx4;
+  validateEquals(cidx4.size, 2 * 3 * 4 * 5);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 4; k++) {
+        for (int l = 0; l < 5; l++) {
+          validateEquals(cidx4(i, j, k, l), idx4(i, j, k, l));
+        }
+      }
+    }
+  }
+
+  kernels::idx5 idx5(2, 3, 4, 3, 5);
+  kernels::cidx5<2, 3, 4, 3, 5> cidx5;
+  validateEquals(cidx5.size, 2 * 3 * 4 * 3 * 5);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 4; k++) {
+        for (int l = 0; l < 3; l++) {
+          for (int m = 0; m < 5; m++) {
+            validateEquals(cidx5(i, j, k, l, m), idx5(i, j, k, l, m));
+          }
+        }
+      }
+    }
+  }
+}
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", on)
+#endif
@@ -0,0 +1,45 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_FIXED_SIZE_INDEX_TEST_H_
+#define _EXAHYPE_TESTS_FIXED_SIZE_INDEX_TEST_H_
+
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace tests {
+namespace c {
+
+/**
+ * Checks that the compile-time index functors kernels::cidx2 to cidx5
+ * enumerate the same offsets as their run-time counterparts idx2 to idx5.
+ */
+class FixedSizeIndexTest : public tarch::tests::TestCase {
+ public:
+  FixedSizeIndexTest();
+  virtual ~FixedSizeIndexTest();
+
+  void run() override;
+
+ private:
+  static tarch::logging::Log _log;
+
+  void testAgreesWithRuntimeIndex();
+};
+
+}  // namespace c
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_FIXED_SIZE_INDEX_TEST_H_
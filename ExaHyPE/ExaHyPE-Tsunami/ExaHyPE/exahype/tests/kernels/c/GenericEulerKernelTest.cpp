@@ -21,6 +21,9 @@
 
 #include "kernels/aderdg/generic/Kernels.h"
 
+#include <algorithm>
+#include <vector>
+
 bool exahype::tests::c::GenericEulerKernelTest::_setNcpAndMatrixBToZero(false);
 
 // TODO: Do not conclude macro definitions with a semicolon?!
@@ -79,10 +82,56 @@ void GenericEulerKernelTest::run() {
   testMethod(testFaceUnknownsProjection);
   testMethod(testVolumeUnknownsProjection);
   testMethod(testEquidistantGridProjection);
+  testMethod(testStableTimeStepSizeFromSpaceTimePredictor);
 
   testMethod(testSolutionUpdate);
 }
 
+void GenericEulerKernelTest::testStableTimeStepSizeFromSpaceTimePredictor() {
+  logInfo( "testStableTimeStepSizeFromSpaceTimePredictor()", "Test time step size from the space-time predictor, ORDER=3" );
+
+  constexpr int numberOfData = NumberOfVariables+NumberOfParameters;
+  constexpr int basisSize    = Order+1;
+  const int     spaceNodes   = tarch::la::aPowI(basisSize,DIMENSIONS);
+
+  tarch::la::Vector<DIMENSIONS,double> dx(0.1);
+  dx[0] = 0.05;
+
+  std::vector<double> luh(spaceNodes*numberOfData);
+  for (int node=0; node < spaceNodes; node++) {
+    double* Q = luh.data() + node*numberOfData;
+    Q[0] = 1.0 + 0.01*node;
+    Q[1] = 0.1*Q[0];
+    Q[2] = -0.05*Q[0];
+    Q[3] = 0.0;
+    Q[4] = 2.5 + 0.02*(node % 5);
+    Q[5] = 0.0;
+  }
+
+  // a predictor that is constant in time is bounded like the solution
+  std::vector<double> lQi(basisSize*luh.size());
+  for (int t=0; t < basisSize; t++) {
+    std::copy(luh.begin(), luh.end(), lQi.begin()+t*luh.size());
+  }
+  const double nodal = kernels::aderdg::generic::c::stableTimeStepSize<GenericEulerKernelTest,false>(*this,luh.data(),dx);
+  double fromPredictor = kernels::aderdg::generic::c::stableTimeStepSizeFromSpaceTimePredictor<GenericEulerKernelTest,false>(*this,lQi.data(),dx);
+  validateNumericalEqualsWithParams1(fromPredictor,nodal,fromPredictor-nodal);
+
+  // a faster flow at an interior node of the last time node, i.e. neither
+  // on a face nor in the solution, lowers the bound
+  int interiorNode = 1 + basisSize;
+  #if DIMENSIONS==3
+  interiorNode += basisSize*basisSize;
+  #endif
+  luh[interiorNode*numberOfData+1] = 2.0*luh[interiorNode*numberOfData];
+  lQi[(basisSize-1)*luh.size()+interiorNode*numberOfData+1] = luh[interiorNode*numberOfData+1];
+
+  const double nodalWithFasterFlow = kernels::aderdg::generic::c::stableTimeStepSize<GenericEulerKernelTest,false>(*this,luh.data(),dx);
+  fromPredictor = kernels::aderdg::generic::c::stableTimeStepSizeFromSpaceTimePredictor<GenericEulerKernelTest,false>(*this,lQi.data(),dx);
+  validateWithParams2(nodalWithFasterFlow < nodal,nodalWithFasterFlow,nodal);
+  validateNumericalEqualsWithParams1(fromPredictor,nodalWithFasterFlow,fromPredictor-nodalWithFasterFlow);
+}
+
 void GenericEulerKernelTest::testEquidistantGridProjection() {
   logInfo( "testEquidistantGridProjection()", "Test equidistant grid projection, ORDER=2, DIM=2" );
 
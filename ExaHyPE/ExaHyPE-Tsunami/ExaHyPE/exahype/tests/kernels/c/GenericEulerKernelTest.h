@@ -34,8 +34,11 @@ class GenericEulerKernelTest : public tarch::tests::TestCase {
   static constexpr int Order                   = 3;
   static constexpr int MaxPicardIterations     = -1;
   static constexpr bool UseMaxPicardIterations = false;
+  static constexpr double PicardTolerance      = 1e-7;
+  static constexpr bool UseTaylorInitialGuess  = false;
 
   static constexpr double CFL             = 0.9;
+  static constexpr double PNPM            = 1.0/7.0;
 
   static constexpr bool UseLobattoBasis = false;
   static double**   weights;
@@ -73,6 +76,7 @@ class GenericEulerKernelTest : public tarch::tests::TestCase {
   void testVolumeUnknownsProjection();
   void testFaceUnknownsProjection();
   void testEquidistantGridProjection();
+  void testStableTimeStepSizeFromSpaceTimePredictor();
 
  public:
   static void flux(const double* const Q, double** F);
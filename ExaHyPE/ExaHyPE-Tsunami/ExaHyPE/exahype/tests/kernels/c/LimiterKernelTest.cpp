@@ -13,6 +13,12 @@
 
 #include "exahype/tests/kernels/c/LimiterKernelTest.h"
 
+#include <cstdlib>
+#include <limits>
+
+#include "kernels/LimiterProjectionMatrices.h"
+#include "tarch/timing/Watch.h"
+
 // TODO(Dominic): JM, please fix the segfaults before you register
 // the test again.
 
@@ -26,6 +32,65 @@ registerTest(exahype::tests::c::LimiterKernelTest)
 
 tarch::logging::Log exahype::tests::c::LimiterKernelTest::_log( "exahype::tests::c::LimiterKernelTest" );
 
+namespace {
+
+#if DIMENSIONS == 3
+constexpr int dimensionsTimes(int n) { return n*n*n; }
+#else
+constexpr int dimensionsTimes(int n) { return n*n; }
+#endif
+
+/**
+ * The direct tensor loops the sum-factorised kernels replaced.
+ * Only ghost-free limiter patches are needed for the comparison.
+ */
+template <int numberOfVariables, int basisSize, int basisSizeOut>
+void projectDirect(const double* const in, const double (&op) [basisSize*basisSizeOut], double* const out) {
+  #if DIMENSIONS == 3
+  constexpr int basisSize3D    = basisSize;
+  constexpr int basisSizeOut3D = basisSizeOut;
+  #else
+  constexpr int basisSize3D    = 1;
+  constexpr int basisSizeOut3D = 1;
+  #endif
+
+  idx4 idxIn(basisSize3D, basisSize, basisSize, numberOfVariables);
+  idx4 idxOut(basisSizeOut3D, basisSizeOut, basisSizeOut, numberOfVariables);
+  idx2 idxConv(basisSize, basisSizeOut);
+
+  for(int z=0; z<basisSizeOut3D; z++) {
+    for(int y=0; y<basisSizeOut; y++) {
+      for(int x=0; x<basisSizeOut; x++) {
+        for(int v=0; v<numberOfVariables; v++) {
+          out[idxOut(z,y,x,v)] = 0;
+          for(int iz=0; iz<basisSize3D; iz++) {
+            for(int iy=0; iy<basisSize; iy++) {
+              for(int ix=0; ix<basisSize; ix++) {
+                out[idxOut(z,y,x,v)] += in[idxIn(iz,iy,ix,v)]
+                                        #if DIMENSIONS == 3
+                                        * op[idxConv(iz,z)]
+                                        #endif
+                                        * op[idxConv(iy,y)]
+                                        * op[idxConv(ix,x)];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+template <int size>
+void fillRandom(double (&data) [size]) {
+  std::srand(42);
+  for (int i=0; i<size; i++) {
+    data[i] = static_cast<double>(std::rand()) / RAND_MAX - 0.5;
+  }
+}
+
+}  // namespace
+
 namespace exahype {
 namespace tests {
 namespace c {
@@ -60,58 +125,166 @@ void LimiterKernelTest::run() {
 
 void LimiterKernelTest::testGetGaussLobattoData() {
   logInfo("LimiterKernelTest::testGetGaussLobattoData()",
-          "Test luh -> lob, ORDER=4, DIM="+dim);
+          "Test luh -> lob min/max, sum-factorised vs. direct, ORDER=3, DIM="+dim);
+
+  constexpr int order = 3;
+  constexpr int V = 5;
+  constexpr int N = order+1;
 
-  // TODO(Dominic): Assess
+  double leg2lob[N*N] = {0.0};
+  kernels::computeLegendre2LobattoProjector<order>(leg2lob);
 
-//  double* lob = kernels::limiter::generic::c::getGaussLobattoData(exahype::tests::testdata::limiter::testFromLuhConversion::luh_in, numberOfVariables, basisSize);
-//
-//  for(int i=0; i<exahype::tests::testdata::limiter::sizeLuh; i++) {
-//    validateNumericalEqualsWithEps(lob[i], exahype::tests::testdata::limiter::testFromLuhConversion::lob_out[i], eps);
-//  }
+  double luh[dimensionsTimes(N)*V];
+  fillRandom(luh);
+  double lob[dimensionsTimes(N)*V];
+  projectDirect<V,N,N>(luh,leg2lob,lob);
 
-//  delete[] lob;
+  double min[V], max[V];
+  std::fill_n(min,V,+std::numeric_limits<double>::infinity());
+  std::fill_n(max,V,-std::numeric_limits<double>::infinity());
+  kernels::limiter::generic::c::computeMinimumAndMaximumValueAtGaussLobattoNodes<V,N>(luh,leg2lob,min,max);
+
+  for (int v=0; v<V; v++) {
+    double expectedMin = lob[v], expectedMax = lob[v];
+    for (int i=1; i<dimensionsTimes(N); i++) {
+      expectedMin = std::min(expectedMin, lob[i*V+v]);
+      expectedMax = std::max(expectedMax, lob[i*V+v]);
+    }
+    validateNumericalEqualsWithEps(min[v], expectedMin, eps);
+    validateNumericalEqualsWithEps(max[v], expectedMax, eps);
+  }
 }
 
 void LimiterKernelTest::testGetFVMData() {
   logInfo("LimiterKernelTest::testGetFVMData()",
-          "Test luh -> lim, ORDER=4, DIM="+dim);
-
-  // TODO(Dominic): Assess
-
-//  const int calcBasisSizeLim = kernels::limiter::generic::c::getBasisSizeLim(basisSize);
-//#ifdef Dim2
-//  const int size = calcBasisSizeLim*calcBasisSizeLim*numberOfVariables;
-//#endif
-//#ifdef Dim3
-//  const int size = calcBasisSizeLim*calcBasisSizeLim*calcBasisSizeLim*numberOfVariables;
-//#endif
-//  double* lim = new double[size];
-//
-//  kernels::limiter::generic::c::projectOnFVLimiterSpace(exahype::tests::testdata::limiter::testFromLuhConversion::luh_in, numberOfVariables, basisSize, calcBasisSizeLim, lim);
-//
-//  validateEquals(calcBasisSizeLim, basisSizeLim)
-//  for(int i=0; i<exahype::tests::testdata::limiter::sizeLim; i++) {
-//    validateNumericalEqualsWithEps(lim[i], exahype::tests::testdata::limiter::testFromLuhConversion::lim_out[i], eps);
-//  }
-//
-//  delete[] lim;
+          "Test luh -> lim, sum-factorised vs. direct, ORDER=3, DIM="+dim);
+
+  constexpr int order = 3;
+  constexpr int V = 5;
+  constexpr int N = order+1;
+  constexpr int M = 2*order+1;
+  constexpr int ghostLayerWidth = 1;
+  constexpr int MPadded = M+2*ghostLayerWidth;
+
+  double dg2fv[N*M] = {0.0};
+  kernels::computeDG2FVProjector<order,M>(dg2fv);
+
+  double luh[dimensionsTimes(N)*V];
+  fillRandom(luh);
+  double expected[dimensionsTimes(M)*V];
+  projectDirect<V,N,M>(luh,dg2fv,expected);
+
+  double lim[dimensionsTimes(MPadded)*V];
+  std::fill_n(lim,dimensionsTimes(MPadded)*V,-1.0);
+  kernels::limiter::generic::c::projectOnFVLimiterSpace<V,N,M,ghostLayerWidth>(luh,dg2fv,lim);
+
+  #if DIMENSIONS == 3
+  constexpr int M3D = M;
+  constexpr int ghostLayerWidth3D = ghostLayerWidth;
+  #else
+  constexpr int M3D = 1;
+  constexpr int ghostLayerWidth3D = 0;
+  #endif
+  idx4 idxLim(M3D+2*ghostLayerWidth3D, MPadded, MPadded, V);
+  idx4 idxExpected(M3D, M, M, V);
+  for (int z=0; z<M3D; z++) {
+    for (int y=0; y<M; y++) {
+      for (int x=0; x<M; x++) {
+        for (int v=0; v<V; v++) {
+          validateNumericalEqualsWithEps(
+              lim[idxLim(z+ghostLayerWidth3D,y+ghostLayerWidth,x+ghostLayerWidth,v)],
+              expected[idxExpected(z,y,x,v)], eps);
+        }
+      }
+    }
+  }
+  // ghost layers are left untouched
+  validateNumericalEquals(lim[0], -1.0);
 }
 
 void LimiterKernelTest::testUpdateSubcellWithLimiterData(){
   logInfo("LimiterKernelTest::testUpdateSubcellWithLimiterData()",
-          "Test lim -> luh, ORDER=4, DIM="+dim);
+          "Test lim -> luh, sum-factorised vs. direct, ORDER=3, DIM="+dim);
 
-  // TODO(Dominic): Assess
+  constexpr int order = 3;
+  constexpr int V = 5;
+  constexpr int N = order+1;
+  constexpr int M = 2*order+1;
 
-//  double* luh = new double[exahype::tests::testdata::limiter::sizeLuh]();
-//  kernels::limiter::generic::c::projectOnADERDGSpace(exahype::tests::testdata::limiter::testToLuhConversion::lim_in, numberOfVariables, basisSizeLim, basisSize, luh);
-//
-//  for(int i=0; i<exahype::tests::testdata::limiter::sizeLuh; i++) {
-//    validateNumericalEqualsWithEps(luh[i], exahype::tests::testdata::limiter::testToLuhConversion::luh_out[i], eps);
-//  }
-  
-//  delete[] luh;
+  double dg2fv[N*M] = {0.0};
+  double fv2dg[N*M] = {0.0};
+  kernels::computeDG2FVProjector<order,M>(dg2fv);
+  kernels::computeFV2DGProjector<order,M>(fv2dg,dg2fv);
+
+  // without ghost layers, the direct loops can be reused with the FV -> DG operator
+  double lim[dimensionsTimes(M)*V];
+  fillRandom(lim);
+  double expected[dimensionsTimes(N)*V];
+  projectDirect<V,M,N>(lim,fv2dg,expected);
+
+  double luh[dimensionsTimes(N)*V];
+  kernels::limiter::generic::c::projectOnDGSpace<V,N,M,0>(lim,fv2dg,luh);
+
+  for(int i=0; i<dimensionsTimes(N)*V; i++) {
+    validateNumericalEqualsWithEps(luh[i], expected[i], eps);
+  }
+
+  // DG -> FV -> DG reproduces the DG polynomial
+  double roundTrip[dimensionsTimes(N)*V];
+  kernels::limiter::generic::c::projectOnFVLimiterSpace<V,N,M,0>(expected,dg2fv,lim);
+  kernels::limiter::generic::c::projectOnDGSpace<V,N,M,0>(lim,fv2dg,roundTrip);
+  for(int i=0; i<dimensionsTimes(N)*V; i++) {
+    validateNumericalEqualsWithEps(roundTrip[i], expected[i], 1e-10);
+  }
+}
+
+void LimiterKernelTest::runBenchmarks() {
+  constexpr int order = 8;
+  constexpr int V = 4;
+  constexpr int N = order+1;
+  constexpr int M = 2*order+1;
+  constexpr int iterations = DIMENSIONS == 3 ? 20 : 1000;
+
+  static double dg2fv[N*M] = {0.0};
+  static double fv2dg[N*M] = {0.0};
+  std::fill_n(dg2fv,N*M,0.0);
+  kernels::computeDG2FVProjector<order,M>(dg2fv);
+  kernels::computeFV2DGProjector<order,M>(fv2dg,dg2fv);
+
+  static double luh[dimensionsTimes(N)*V];
+  static double lim[dimensionsTimes(M)*V];
+  static double reference[dimensionsTimes(M)*V];
+  fillRandom(luh);
+
+  tarch::timing::Watch watch("exahype::tests::c::LimiterKernelTest", "runBenchmarks()", false);
+
+  watch.startTimer();
+  for (int i=0; i<iterations; i++) projectDirect<V,N,M>(luh,dg2fv,reference);
+  watch.stopTimer();
+  const double directDG2FV = watch.getCalendarTime() / iterations;
+
+  watch.startTimer();
+  for (int i=0; i<iterations; i++) kernels::limiter::generic::c::projectOnFVLimiterSpace<V,N,M,0>(luh,dg2fv,lim);
+  watch.stopTimer();
+  const double factorisedDG2FV = watch.getCalendarTime() / iterations;
+
+  for(int i=0; i<dimensionsTimes(M)*V; i++) {
+    validateNumericalEqualsWithEps(lim[i], reference[i], 1e-11);
+  }
+
+  watch.startTimer();
+  for (int i=0; i<iterations; i++) projectDirect<V,M,N>(lim,fv2dg,luh);
+  watch.stopTimer();
+  const double directFV2DG = watch.getCalendarTime() / iterations;
+
+  watch.startTimer();
+  for (int i=0; i<iterations; i++) kernels::limiter::generic::c::projectOnDGSpace<V,N,M,0>(lim,fv2dg,luh);
+  watch.stopTimer();
+  const double factorisedFV2DG = watch.getCalendarTime() / iterations;
+
+  logInfo("runBenchmarks()", "ORDER=8, PATCH=17, DIM="+dim <<
+          ": DG->FV direct " << directDG2FV*1e6 << " us, sum-factorised " << factorisedDG2FV*1e6 << " us" <<
+          "; FV->DG direct " << directFV2DG*1e6 << " us, sum-factorised " << factorisedFV2DG*1e6 << " us");
 }
 
 void LimiterKernelTest::testFindCellLocallocalMinlocalMax(){
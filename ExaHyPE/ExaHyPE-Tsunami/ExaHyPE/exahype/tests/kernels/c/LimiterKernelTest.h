@@ -35,6 +35,13 @@ class LimiterKernelTest : public tarch::tests::TestCase {
 
   void run() override;
 
+  /**
+   * Times the sum-factorised projections against the direct
+   * tensor loops at the sandbox's order (8) and patch size (17).
+   * Not part of run(), cf. exahype::tests::runBenchmarks().
+   */
+  void runBenchmarks();
+
  private:
   static tarch::logging::Log _log;
   static const double eps;  // for quick adaption of the test cases
@@ -0,0 +1,150 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_SWE_TEST_SOLVER_H_
+#define _EXAHYPE_TESTS_SWE_TEST_SOLVER_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "peano/utils/Globals.h"
+#include "tarch/la/Vector.h"
+
+#include "kernels/GaussLegendreBasis.h"
+
+namespace exahype {
+namespace tests {
+namespace c {
+
+/**
+ * Minimal solver for the shallow water equations as in SWE_sandbox,
+ * Q = (h, hu, hv, b), shared by the 2D kernel tests.
+ *
+ * For the ADER-DG kernels, the hydrostatic pressure and the bathymetry are
+ * in the non-conservative product. With @p fixedPicardIterations, the
+ * Picard loop always does order+1 iterations so that two kernels do the same
+ * amount of work and can be compared to round-off. Otherwise it stops on a
+ * tight tolerance so that iteration counts can be compared.
+ *
+ * For the swe finite volumes scheme, the solver provides the gravity, the
+ * dry tolerance and the patch scratch; the fluxes are then computed by the
+ * scheme's own Riemann solver.
+ */
+template <int order=0, bool taylor=false, bool fixedPicardIterations=false>
+struct SWETestSolver {
+  static constexpr int NumberOfVariables       = 4;
+  static constexpr int NumberOfParameters      = 0;
+  static constexpr int Order                   = order;
+  static constexpr int MaxPicardIterations     = fixedPicardIterations ? order+1 : 4*(order+1);
+  static constexpr bool UseMaxPicardIterations = fixedPicardIterations;
+  static constexpr double PicardTolerance      = fixedPicardIterations ? 1e-7 : 1e-12;
+  static constexpr bool UseTaylorInitialGuess  = taylor;
+
+  static constexpr int PatchSize               = 16;
+  static constexpr int GhostLayerWidth         = 1;
+
+  static constexpr double grav = 9.81e-3;
+
+  static double**  weights;
+  static double**  nodes;
+  static double*** Kxi;
+  static double*** dudx;
+  static double*** iK1;
+  static double*** FCoeff;
+
+  double getGravity() const { return grav; }
+  double getDryTolerance() const { return 1e-2; }
+
+  static double* getPatchScratch(const int size) {
+    static std::vector<double> scratch;
+    if ( static_cast<int>(scratch.size()) < size ) {
+      scratch.resize(size);
+    }
+    return scratch.data();
+  }
+
+  void flux(const double* const Q, double** F) {
+    const double ih = 1./Q[0];
+    F[0][0] = Q[1];
+    F[0][1] = Q[1]*Q[1]*ih;
+    F[0][2] = Q[1]*Q[2]*ih;
+    F[0][3] = 0.0;
+
+    F[1][0] = Q[2];
+    F[1][1] = Q[1]*Q[2]*ih;
+    F[1][2] = Q[2]*Q[2]*ih;
+    F[1][3] = 0.0;
+  }
+
+  void nonConservativeProduct(const double* const Q, const double* const gradQ, double* BgradQ) {
+    BgradQ[0] = 0.0;
+    BgradQ[1] = grav*Q[0]*(gradQ[0*NumberOfVariables+3] + gradQ[0*NumberOfVariables+0]);
+    BgradQ[2] = grav*Q[0]*(gradQ[1*NumberOfVariables+3] + gradQ[1*NumberOfVariables+0]);
+    BgradQ[3] = 0.0;
+  }
+
+  // not called, the kernels are instantiated without viscous flux
+  void viscousFlux(const double* const Q, const double* const gradQ, double** F) {
+    flux(Q, F);
+  }
+
+  void algebraicSource(const tarch::la::Vector<DIMENSIONS, double>& x, double t, const double* const Q, double* S) {
+    std::fill_n(S, NumberOfVariables, 0.0);
+  }
+
+  void flux_vect(const double* const* const Q, double* const* const* const F, const int s) {
+    #pragma omp simd
+    for (int i = 0; i < s; i++) {
+      const double ih = 1./Q[0][i];
+      F[0][0][i] = Q[1][i];
+      F[0][1][i] = Q[1][i]*Q[1][i]*ih;
+      F[0][2][i] = Q[1][i]*Q[2][i]*ih;
+      F[0][3][i] = 0.0;
+
+      F[1][0][i] = Q[2][i];
+      F[1][1][i] = Q[1][i]*Q[2][i]*ih;
+      F[1][2][i] = Q[2][i]*Q[2][i]*ih;
+      F[1][3][i] = 0.0;
+    }
+  }
+
+  void nonConservativeProduct_vect(const double* const* const Q, const double* const* const* const gradQ,
+                                   double* const* const BgradQ, const int s) {
+    #pragma omp simd
+    for (int i = 0; i < s; i++) {
+      BgradQ[0][i] = 0.0;
+      BgradQ[1][i] = grav*Q[0][i]*(gradQ[0][3][i] + gradQ[0][0][i]);
+      BgradQ[2][i] = grav*Q[0][i]*(gradQ[1][3][i] + gradQ[1][0][i]);
+      BgradQ[3][i] = 0.0;
+    }
+  }
+};
+
+template <int order, bool taylor, bool fixedPicardIterations>
+double**  SWETestSolver<order,taylor,fixedPicardIterations>::weights = kernels::legendre::weights;
+template <int order, bool taylor, bool fixedPicardIterations>
+double**  SWETestSolver<order,taylor,fixedPicardIterations>::nodes   = kernels::legendre::nodes;
+template <int order, bool taylor, bool fixedPicardIterations>
+double*** SWETestSolver<order,taylor,fixedPicardIterations>::Kxi     = kernels::legendre::Kxi;
+template <int order, bool taylor, bool fixedPicardIterations>
+double*** SWETestSolver<order,taylor,fixedPicardIterations>::dudx    = kernels::legendre::dudx;
+template <int order, bool taylor, bool fixedPicardIterations>
+double*** SWETestSolver<order,taylor,fixedPicardIterations>::iK1     = kernels::legendre::iK1;
+template <int order, bool taylor, bool fixedPicardIterations>
+double*** SWETestSolver<order,taylor,fixedPicardIterations>::FCoeff  = kernels::legendre::FCoeff;
+
+}  // namespace c
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_SWE_TEST_SOLVER_H_
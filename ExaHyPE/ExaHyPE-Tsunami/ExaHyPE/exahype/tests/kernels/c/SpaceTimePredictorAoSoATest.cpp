@@ -0,0 +1,217 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/kernels/c/SpaceTimePredictorAoSoATest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "tarch/la/Vector.h"
+#include "tarch/tests/TestCaseFactory.h"
+#include "tarch/timing/Watch.h"
+
+#include "kernels/GaussLegendreBasis.h"
+#include "kernels/aderdg/generic/Kernels.h"
+
+#include "exahype/tests/kernels/c/SWETestSolver.h"
+
+#ifndef ALIGNMENT
+registerTest(exahype::tests::c::SpaceTimePredictorAoSoATest)
+#endif
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::c::SpaceTimePredictorAoSoATest::_log( "exahype::tests::c::SpaceTimePredictorAoSoATest" );
+
+#if DIMENSIONS == 2
+
+namespace {
+
+/**
+ * The number of Picard iterations is fixed so that both kernels do the same
+ * amount of work and can be compared to round-off.
+ */
+template <int order>
+using TestSolver = exahype::tests::c::SWETestSolver<order,false,true>;
+
+/**
+ * Buffers of the generic predictor plus a smooth wave over a bump,
+ * scaled so that dt is a typical CFL step of the cell.
+ */
+template <int order>
+struct PredictorData {
+  static constexpr int nVar       = TestSolver<order>::NumberOfVariables;
+  static constexpr int basisSize  = order+1;
+  static constexpr int basisSize2 = basisSize*basisSize;
+  static constexpr int basisSize3 = basisSize2*basisSize;
+
+  std::vector<double> luh, lQi, rhs, lFi, gradQ, lQhi, lFhi, lQhbnd, lFhbnd;
+  tarch::la::Vector<DIMENSIONS, double> center, invDx;
+  double t  = 0.0;
+  double dt = 0.0;
+
+  PredictorData() :
+    luh(nVar*basisSize2), lQi(nVar*basisSize3), rhs(nVar*basisSize3),
+    lFi((DIMENSIONS+1)*nVar*basisSize3), gradQ(DIMENSIONS*nVar*basisSize2),
+    lQhi(nVar*basisSize2), lFhi((DIMENSIONS+1)*nVar*basisSize2),
+    lQhbnd(2*DIMENSIONS*nVar*basisSize), lFhbnd(2*DIMENSIONS*nVar*basisSize),
+    center(0.5, 0.5) {
+    const double dx = 0.1;
+    invDx = tarch::la::Vector<DIMENSIONS, double>(1./dx, 1./dx);
+    for (int j = 0; j < basisSize; j++) {
+      for (int k = 0; k < basisSize; k++) {
+        const double x = center[0] + dx * (kernels::legendre::nodes[order][k] - 0.5);
+        const double y = center[1] + dx * (kernels::legendre::nodes[order][j] - 0.5);
+        double* Q = luh.data() + (j*basisSize+k)*nVar;
+        Q[0] = 1.0 + 0.2*std::sin(2.0*x) + 0.1*std::cos(3.0*y);
+        Q[1] = 0.3*Q[0];
+        Q[2] = -0.1*Q[0];
+        Q[3] = 0.05*std::cos(x+y);
+      }
+    }
+    dt = 0.9 * dx / (std::sqrt(TestSolver<order>::grav*1.3) + 0.3) / (2*order+1);
+  }
+};
+
+template <int order>
+void runScalar(TestSolver<order>& solver, PredictorData<order>& d) {
+  kernels::aderdg::generic::c::spaceTimePredictorNonlinear<false,true,false,true,false,TestSolver<order>>(
+      solver, d.lQhbnd.data(), nullptr, d.lFhbnd.data(),
+      d.lQi.data(), d.rhs.data(), d.lFi.data(), d.gradQ.data(), d.lQhi.data(), d.lFhi.data(),
+      d.luh.data(), d.center, d.invDx, d.t, d.dt);
+}
+
+template <int order, bool useVectPDE>
+void runAoSoA(TestSolver<order>& solver, PredictorData<order>& d) {
+  static kernels::aderdg::generic::c::AoSoAPredictorScratch<TestSolver<order>> scratch;
+  kernels::aderdg::generic::c::spaceTimePredictorNonlinearAoSoA<false,true,true,useVectPDE,false,TestSolver<order>>(
+      solver, scratch, d.lQhbnd.data(), d.lFhbnd.data(),
+      d.lQi.data(), d.lFi.data(), d.lQhi.data(), d.lFhi.data(),
+      d.luh.data(), d.center, d.invDx, d.t, d.dt);
+}
+
+}  // namespace
+
+#endif  // DIMENSIONS == 2
+
+namespace exahype {
+namespace tests {
+namespace c {
+
+SpaceTimePredictorAoSoATest::SpaceTimePredictorAoSoATest()
+    : tarch::tests::TestCase("exahype::tests::c::SpaceTimePredictorAoSoATest") {}
+
+SpaceTimePredictorAoSoATest::~SpaceTimePredictorAoSoATest() {}
+
+void SpaceTimePredictorAoSoATest::run() {
+  #if DIMENSIONS == 2
+  testMethod(testAgreesWithScalarKernel);
+  #endif
+}
+
+void SpaceTimePredictorAoSoATest::runBenchmarks() {
+  #if DIMENSIONS == 2
+  benchmark<3>();
+  benchmark<4>();
+  benchmark<5>();
+  benchmark<6>();
+  benchmark<7>();
+  benchmark<8>();
+  benchmark<9>();
+  #endif
+}
+
+#if DIMENSIONS == 2
+
+template <int order>
+void SpaceTimePredictorAoSoATest::compareWithScalarKernel() {
+  constexpr double eps = 1e-9;
+  TestSolver<order> solver;
+
+  PredictorData<order> scalar;
+  runScalar<order>(solver, scalar);
+
+  PredictorData<order> pointwise;
+  runAoSoA<order,false>(solver, pointwise);
+
+  PredictorData<order> row;
+  runAoSoA<order,true>(solver, row);
+
+  for (size_t i = 0; i < scalar.lQhi.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(pointwise.lQhi[i], scalar.lQhi[i], eps, i);
+    validateNumericalEqualsWithEpsWithParams1(row.lQhi[i], scalar.lQhi[i], eps, i);
+  }
+  for (size_t i = 0; i < scalar.lFhi.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(pointwise.lFhi[i], scalar.lFhi[i], eps, i);
+    validateNumericalEqualsWithEpsWithParams1(row.lFhi[i], scalar.lFhi[i], eps, i);
+  }
+  for (size_t i = 0; i < scalar.lQhbnd.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(pointwise.lQhbnd[i], scalar.lQhbnd[i], eps, i);
+    validateNumericalEqualsWithEpsWithParams1(row.lQhbnd[i], scalar.lQhbnd[i], eps, i);
+  }
+  for (size_t i = 0; i < scalar.lFhbnd.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(pointwise.lFhbnd[i], scalar.lFhbnd[i], eps, i);
+    validateNumericalEqualsWithEpsWithParams1(row.lFhbnd[i], scalar.lFhbnd[i], eps, i);
+  }
+}
+
+void SpaceTimePredictorAoSoATest::testAgreesWithScalarKernel() {
+  logInfo("testAgreesWithScalarKernel()", "Test AoSoA space time predictor nonlinear, ORDER=3,8, DIM=2");
+  compareWithScalarKernel<3>();
+  compareWithScalarKernel<8>();
+}
+
+template <int order>
+void SpaceTimePredictorAoSoATest::benchmark() {
+  constexpr int basisSize  = order+1;
+  const int iterations = std::max(20, 100000 / (basisSize*basisSize*basisSize));
+
+  TestSolver<order> solver;
+  PredictorData<order> d;
+  tarch::timing::Watch watch("exahype::tests::c::SpaceTimePredictorAoSoATest", "benchmark()", false);
+
+  runScalar<order>(solver, d); // warm up
+  watch.startTimer();
+  for (int i = 0; i < iterations; i++) runScalar<order>(solver, d);
+  watch.stopTimer();
+  const double scalar = watch.getCalendarTime() / iterations;
+
+  runAoSoA<order,false>(solver, d);
+  watch.startTimer();
+  for (int i = 0; i < iterations; i++) runAoSoA<order,false>(solver, d);
+  watch.stopTimer();
+  const double pointwise = watch.getCalendarTime() / iterations;
+
+  runAoSoA<order,true>(solver, d);
+  watch.startTimer();
+  for (int i = 0; i < iterations; i++) runAoSoA<order,true>(solver, d);
+  watch.stopTimer();
+  const double row = watch.getCalendarTime() / iterations;
+
+  logInfo("benchmark()", "ORDER=" << order <<
+          ": scalar " << scalar*1e6 << " us, AoSoA " << pointwise*1e6 << " us (" << scalar/pointwise << "x)" <<
+          ", AoSoA+flux_vect " << row*1e6 << " us (" << scalar/row << "x)");
+}
+
+#endif  // DIMENSIONS == 2
+
+}  // namespace c
+}  // namespace tests
+}  // namespace exahype
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", on)
+#endif
@@ -0,0 +1,60 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_SPACE_TIME_PREDICTOR_AOSOA_TEST_H_
+#define _EXAHYPE_TESTS_SPACE_TIME_PREDICTOR_AOSOA_TEST_H_
+
+#include "peano/utils/Globals.h"
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace tests {
+namespace c {
+
+/**
+ * Checks the AoSoA nonlinear space-time predictor against the scalar
+ * generic kernel on a shallow water test solver (flux + NCP, as in the
+ * sandbox), with pointwise and with row (flux_vect) PDE callbacks.
+ * 2D only.
+ */
+class SpaceTimePredictorAoSoATest : public tarch::tests::TestCase {
+ public:
+  SpaceTimePredictorAoSoATest();
+  virtual ~SpaceTimePredictorAoSoATest();
+
+  void run() override;
+
+  /**
+   * Times the scalar and both AoSoA variants at orders 3 to 9.
+   * Not part of run(), cf. exahype::tests::runBenchmarks().
+   */
+  void runBenchmarks();
+
+ private:
+  static tarch::logging::Log _log;
+
+  void testAgreesWithScalarKernel();
+
+  template <int order>
+  void compareWithScalarKernel();
+
+  template <int order>
+  void benchmark();
+};
+
+}  // namespace c
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_SPACE_TIME_PREDICTOR_AOSOA_TEST_H_
@@ -0,0 +1,188 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/kernels/c/SpaceTimePredictorInitialGuessTest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "tarch/la/Vector.h"
+#include "tarch/tests/TestCaseFactory.h"
+
+#include "kernels/GaussLegendreBasis.h"
+#include "kernels/aderdg/generic/Kernels.h"
+
+#include "exahype/tests/kernels/c/SWETestSolver.h"
+
+#ifndef ALIGNMENT
+registerTest(exahype::tests::c::SpaceTimePredictorInitialGuessTest)
+#endif
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::c::SpaceTimePredictorInitialGuessTest::_log( "exahype::tests::c::SpaceTimePredictorInitialGuessTest" );
+
+#if DIMENSIONS == 2
+
+namespace {
+
+/**
+ * The Picard loop stops on the (tight) tolerance so that the iteration
+ * counts of both initial guesses can be compared.
+ */
+template <int order, bool taylor>
+using TestSolver = exahype::tests::c::SWETestSolver<order,taylor,false>;
+
+/**
+ * Buffers of the generic predictor plus a smooth wave over a bump
+ * (or a lake at rest), scaled so that dt is a typical CFL step of the cell.
+ */
+template <int order>
+struct PredictorData {
+  static constexpr int nVar       = 4;
+  static constexpr int basisSize  = order+1;
+  static constexpr int basisSize2 = basisSize*basisSize;
+  static constexpr int basisSize3 = basisSize2*basisSize;
+
+  std::vector<double> luh, lQi, rhs, lFi, gradQ, lQhi, lFhi, lQhbnd, lFhbnd;
+  tarch::la::Vector<DIMENSIONS, double> center, invDx;
+  double t  = 0.0;
+  double dt = 0.0;
+
+  explicit PredictorData(const bool atRest) :
+    luh(nVar*basisSize2), lQi(nVar*basisSize3), rhs(nVar*basisSize3),
+    lFi((DIMENSIONS+1)*nVar*basisSize3), gradQ(DIMENSIONS*nVar*basisSize2),
+    lQhi(nVar*basisSize2), lFhi((DIMENSIONS+1)*nVar*basisSize2),
+    lQhbnd(2*DIMENSIONS*nVar*basisSize), lFhbnd(2*DIMENSIONS*nVar*basisSize),
+    center(0.5, 0.5) {
+    const double dx = 0.1;
+    invDx = tarch::la::Vector<DIMENSIONS, double>(1./dx, 1./dx);
+    for (int j = 0; j < basisSize; j++) {
+      for (int k = 0; k < basisSize; k++) {
+        const double x = center[0] + dx * (kernels::legendre::nodes[order][k] - 0.5);
+        const double y = center[1] + dx * (kernels::legendre::nodes[order][j] - 0.5);
+        double* Q = luh.data() + (j*basisSize+k)*nVar;
+        Q[3] = 0.05*std::cos(x+y);
+        if (atRest) {
+          Q[0] = 1.0 - Q[3];
+          Q[1] = 0.0;
+          Q[2] = 0.0;
+        } else {
+          Q[0] = 1.0 + 0.2*std::sin(2.0*x) + 0.1*std::cos(3.0*y);
+          Q[1] = 0.3*Q[0];
+          Q[2] = -0.1*Q[0];
+        }
+      }
+    }
+    dt = 0.9 * dx / (std::sqrt(TestSolver<order,false>::grav*1.3) + 0.3) / (2*order+1);
+  }
+};
+
+template <int order, bool taylor>
+int runPredictor(PredictorData<order>& d) {
+  TestSolver<order,taylor> solver;
+  return kernels::aderdg::generic::c::spaceTimePredictorNonlinear<false,true,false,true,false,TestSolver<order,taylor>>(
+      solver, d.lQhbnd.data(), nullptr, d.lFhbnd.data(),
+      d.lQi.data(), d.rhs.data(), d.lFi.data(), d.gradQ.data(), d.lQhi.data(), d.lFhi.data(),
+      d.luh.data(), d.center, d.invDx, d.t, d.dt);
+}
+
+}  // namespace
+
+#endif  // DIMENSIONS == 2
+
+namespace exahype {
+namespace tests {
+namespace c {
+
+SpaceTimePredictorInitialGuessTest::SpaceTimePredictorInitialGuessTest()
+    : tarch::tests::TestCase("exahype::tests::c::SpaceTimePredictorInitialGuessTest") {}
+
+SpaceTimePredictorInitialGuessTest::~SpaceTimePredictorInitialGuessTest() {}
+
+void SpaceTimePredictorInitialGuessTest::run() {
+  #if DIMENSIONS == 2
+  testMethod(testTaylorGuessAgreesWithTrivialGuess);
+  testMethod(testLakeAtRest);
+  #endif
+}
+
+#if DIMENSIONS == 2
+
+template <int order>
+void SpaceTimePredictorInitialGuessTest::compareInitialGuesses() {
+  constexpr double eps = 1e-9;
+  constexpr int maxIterations = TestSolver<order,false>::MaxPicardIterations;
+
+  PredictorData<order> trivial(false);
+  const int trivialIterations = runPredictor<order,false>(trivial);
+
+  PredictorData<order> taylor(false);
+  const int taylorIterations = runPredictor<order,true>(taylor);
+
+  logInfo("compareInitialGuesses()", "ORDER=" << order << ": Picard iterations with trivial guess " <<
+          trivialIterations << ", with Taylor guess " << taylorIterations);
+
+  validateWithParams2(trivialIterations >= 1 && trivialIterations < maxIterations, trivialIterations, maxIterations);
+  validateWithParams2(taylorIterations >= 1 && taylorIterations < trivialIterations, taylorIterations, trivialIterations);
+
+  for (size_t i = 0; i < trivial.lQhi.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(taylor.lQhi[i], trivial.lQhi[i], eps, i);
+  }
+  for (size_t i = 0; i < trivial.lFhi.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(taylor.lFhi[i], trivial.lFhi[i], eps, i);
+  }
+  for (size_t i = 0; i < trivial.lQhbnd.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(taylor.lQhbnd[i], trivial.lQhbnd[i], eps, i);
+  }
+  for (size_t i = 0; i < trivial.lFhbnd.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(taylor.lFhbnd[i], trivial.lFhbnd[i], eps, i);
+  }
+}
+
+void SpaceTimePredictorInitialGuessTest::testTaylorGuessAgreesWithTrivialGuess() {
+  logInfo("testTaylorGuessAgreesWithTrivialGuess()", "Test Taylor initial guess of space time predictor nonlinear, ORDER=3,5,8, DIM=2");
+  compareInitialGuesses<3>();
+  compareInitialGuesses<5>();
+  compareInitialGuesses<8>();
+}
+
+void SpaceTimePredictorInitialGuessTest::testLakeAtRest() {
+  // the well-balanced state has a vanishing time derivative: the Taylor
+  // guess is already the fixed point and the trivial one is a round-off away
+  constexpr int order = 5;
+
+  PredictorData<order> trivial(true);
+  const int trivialIterations = runPredictor<order,false>(trivial);
+  PredictorData<order> taylor(true);
+  const int taylorIterations = runPredictor<order,true>(taylor);
+
+  validateWithParams1(trivialIterations <= 2, trivialIterations);
+  validateWithParams1(taylorIterations <= 2, taylorIterations);
+  for (size_t i = 0; i < trivial.lQhi.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(taylor.lQhi[i], trivial.luh[i], 1e-12, i);
+  }
+}
+
+#endif  // DIMENSIONS == 2
+
+}  // namespace c
+}  // namespace tests
+}  // namespace exahype
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", on)
+#endif
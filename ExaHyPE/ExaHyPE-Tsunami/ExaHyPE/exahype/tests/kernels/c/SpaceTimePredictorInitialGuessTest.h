@@ -0,0 +1,52 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_SPACE_TIME_PREDICTOR_INITIAL_GUESS_TEST_H_
+#define _EXAHYPE_TESTS_SPACE_TIME_PREDICTOR_INITIAL_GUESS_TEST_H_
+
+#include "peano/utils/Globals.h"
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace tests {
+namespace c {
+
+/**
+ * Runs the generic nonlinear space-time predictor with a convergence
+ * tolerance instead of a fixed number of Picard iterations on a shallow
+ * water test solver and checks that the Taylor initial guess converges to
+ * the same predictor as the trivial one in fewer iterations. 2D only.
+ */
+class SpaceTimePredictorInitialGuessTest : public tarch::tests::TestCase {
+ public:
+  SpaceTimePredictorInitialGuessTest();
+  virtual ~SpaceTimePredictorInitialGuessTest();
+
+  void run() override;
+
+ private:
+  static tarch::logging::Log _log;
+
+  void testTaylorGuessAgreesWithTrivialGuess();
+  void testLakeAtRest();
+
+  template <int order>
+  void compareInitialGuesses();
+};
+
+}  // namespace c
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_SPACE_TIME_PREDICTOR_INITIAL_GUESS_TEST_H_
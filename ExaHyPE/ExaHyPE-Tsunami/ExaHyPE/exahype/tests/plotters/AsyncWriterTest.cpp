@@ -0,0 +1,142 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/plotters/AsyncWriterTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tarch/tests/TestCaseFactory.h"
+
+#include "exahype/plotters/AsyncWriter.h"
+
+#ifndef ALIGNMENT
+registerTest(exahype::tests::plotters::AsyncWriterTest)
+#endif
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::plotters::AsyncWriterTest::_log( "exahype::tests::plotters::AsyncWriterTest" );
+
+namespace exahype {
+namespace tests {
+namespace plotters {
+
+AsyncWriterTest::AsyncWriterTest()
+    : tarch::tests::TestCase("exahype::tests::plotters::AsyncWriterTest") {}
+
+AsyncWriterTest::~AsyncWriterTest() {}
+
+void AsyncWriterTest::run() {
+  testMethod(testSynchronous);
+  testMethod(testBackPressure);
+  testMethod(testFailure);
+}
+
+void AsyncWriterTest::testSynchronous() {
+  logInfo("testSynchronous()", "Test AsyncWriter without writer thread");
+
+  exahype::plotters::AsyncWriter writer(0);
+  validate(!writer.isAsynchronous());
+
+  bool hasRun = false;
+  writer.submit([&hasRun] () { hasRun = true; });
+  validate(hasRun);
+  writer.waitUntilAllJobsHaveBeenProcessed();
+}
+
+void AsyncWriterTest::testBackPressure() {
+  logInfo("testBackPressure()", "Test AsyncWriter: submitting to a full queue blocks");
+
+  constexpr int MaxQueueLength = 2;
+  exahype::plotters::AsyncWriter writer(MaxQueueLength);
+  validate(writer.isAsynchronous());
+
+  std::vector<int> order; // only written by the writer thread
+
+  // the first job keeps the writer thread busy until the gate is opened
+  std::mutex              gateMutex;
+  std::condition_variable gate;
+  bool                    isGateOpen = false;
+  std::atomic<bool>       hasFirstJobStarted(false);
+  writer.submit([&] () {
+    hasFirstJobStarted = true;
+    std::unique_lock<std::mutex> lock(gateMutex);
+    gate.wait(lock, [&isGateOpen] { return isGateOpen; });
+    order.push_back(0);
+  });
+  while (!hasFirstJobStarted) {
+    std::this_thread::yield();
+  }
+
+  // fill the queue
+  for (int job = 1; job <= MaxQueueLength; job++) {
+    writer.submit([&order,job] () { order.push_back(job); });
+  }
+
+  // the next submission has to wait for the writer thread
+  std::atomic<bool> hasSubmitted(false);
+  std::thread producer([&] () {
+    writer.submit([&order] () { order.push_back(MaxQueueLength+1); });
+    hasSubmitted = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  validate(!hasSubmitted);
+
+  {
+    std::lock_guard<std::mutex> lock(gateMutex);
+    isGateOpen = true;
+  }
+  gate.notify_all();
+  producer.join();
+  validate(hasSubmitted);
+
+  writer.waitUntilAllJobsHaveBeenProcessed();
+  validateEquals(static_cast<int>(order.size()),MaxQueueLength+2);
+  for (int job = 0; job < static_cast<int>(order.size()); job++) {
+    validateEqualsWithParams1(order[job],job,job);
+  }
+}
+
+void AsyncWriterTest::testFailure() {
+  logInfo("testFailure()", "Test AsyncWriter: a failed job is reported to the submitting thread (an error message is expected)");
+
+  exahype::plotters::AsyncWriter writer(1);
+  validate(!writer.hasFailed());
+
+  std::thread::id jobThread;
+  writer.submit([&] () {
+    jobThread = std::this_thread::get_id();
+    writer.reportFailure("AsyncWriterTest: failure of a job");
+  });
+
+  // waitUntilAllJobsHaveBeenProcessed() and submit(...) would exit now
+  while (!writer.hasFailed()) {
+    std::this_thread::yield();
+  }
+  validate(jobThread!=std::this_thread::get_id());
+}
+
+}  // namespace plotters
+}  // namespace tests
+}  // namespace exahype
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", on)
+#endif
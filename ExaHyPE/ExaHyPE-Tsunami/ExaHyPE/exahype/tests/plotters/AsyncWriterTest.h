@@ -0,0 +1,49 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_ASYNC_WRITER_TEST_H_
+#define _EXAHYPE_TESTS_ASYNC_WRITER_TEST_H_
+
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace tests {
+namespace plotters {
+
+/**
+ * Tests the bounded queue of the AsyncWriter: a submit(...) to a full queue
+ * blocks until the writer thread has finished a job, and the jobs run in
+ * the order of their submission. A failure reported by a job on the writer
+ * thread has to be visible to the submitting thread.
+ */
+class AsyncWriterTest : public tarch::tests::TestCase {
+ public:
+  AsyncWriterTest();
+  virtual ~AsyncWriterTest();
+
+  void run() override;
+
+ private:
+  static tarch::logging::Log _log;
+
+  void testSynchronous();
+  void testBackPressure();
+  void testFailure();
+};
+
+}  // namespace plotters
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_ASYNC_WRITER_TEST_H_
@@ -0,0 +1,203 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/plotters/CompressedSnapshotWriterTest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "tarch/tests/TestCaseFactory.h"
+
+#include "exahype/plotters/compressed/CompressedSnapshotReader.h"
+#include "exahype/plotters/compressed/CompressedSnapshotWriter.h"
+
+#ifndef ALIGNMENT
+registerTest(exahype::tests::plotters::CompressedSnapshotWriterTest)
+#endif
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::plotters::CompressedSnapshotWriterTest::_log( "exahype::tests::plotters::CompressedSnapshotWriterTest" );
+
+namespace {
+
+const std::string FileName = "CompressedSnapshotWriterTest.exz";
+
+// value the writer clamps to if a value cannot be represented (2^61 quantisation steps)
+const double MaxQuantised = 2305843009213693952.0;
+
+typedef exahype::plotters::compressedsnapshot::Snapshot Snapshot;
+
+/**
+ * Decodes the chunks in reverse order, as a stand-in for the front end's
+ * thread pool which may run them in any order.
+ */
+struct ReverseFor {
+  template <typename Body>
+  void operator()(const int tasks, Body&& body) const {
+    for (int task = tasks-1; task >= 0; task--) body(task);
+  }
+};
+
+bool readFile(const std::string& fileName, std::string& data) {
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  if (!file) return false;
+  data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+}  // namespace
+
+namespace exahype {
+namespace tests {
+namespace plotters {
+
+CompressedSnapshotWriterTest::CompressedSnapshotWriterTest()
+    : tarch::tests::TestCase("exahype::tests::plotters::CompressedSnapshotWriterTest") {}
+
+CompressedSnapshotWriterTest::~CompressedSnapshotWriterTest() {}
+
+void CompressedSnapshotWriterTest::run() {
+  testMethod(testRoundTrip);
+  testMethod(testSizeOfSyntheticData);
+}
+
+void CompressedSnapshotWriterTest::testRoundTrip() {
+  logInfo("testRoundTrip()", "Test compressed snapshot, encode and decode with several chunks");
+
+  constexpr int Dimensions    = 2;
+  constexpr int Patches       = 3;
+  constexpr int CellsPerAxis  = 4;
+  constexpr int CellsPerPatch = CellsPerAxis*CellsPerAxis;
+  constexpr int CellsPerChunk = 7; // the last chunk is only partially filled
+  const std::vector<double> errorBounds = {1e-4, 1e-2, 0.5};
+  const int quantities = errorBounds.size();
+
+  std::vector<double> values(Patches*CellsPerPatch*quantities);
+  for (int cell = 0; cell < Patches*CellsPerPatch; cell++) {
+    values[cell*quantities+0] = 1.0 + 0.3*std::sin(0.7*cell);
+    values[cell*quantities+1] = -25.0*std::cos(1.9*cell) + 1e-3*cell;
+    values[cell*quantities+2] = 1e4*std::sin(0.01*cell*cell);
+  }
+  // values which cannot be represented; the ones in the middle of a chunk
+  // must not spoil the differences of their successors
+  values[3*quantities+0]  = std::numeric_limits<double>::quiet_NaN();
+  values[10*quantities+1] = std::numeric_limits<double>::infinity();
+  values[20*quantities+2] = -1e300;
+  values[21*quantities+0] = 2.0*MaxQuantised; // too large for the bound 1e-4
+
+  std::vector<double> geometry;
+  exahype::plotters::CompressedSnapshotWriter writer(Dimensions, errorBounds, CellsPerChunk);
+  for (int patch = 0; patch < Patches; patch++) {
+    const double offset[Dimensions] = {1.0*patch, -0.5};
+    const double size[Dimensions]   = {1.0, 0.25};
+    geometry.insert(geometry.end(), offset, offset+Dimensions);
+    geometry.insert(geometry.end(), size,   size+Dimensions);
+    writer.addPatch(offset, size, CellsPerAxis);
+    for (int cell = 0; cell < CellsPerPatch; cell++) {
+      writer.addCell(values.data() + (patch*CellsPerPatch+cell)*quantities);
+    }
+  }
+  validate(writer.writeToFile(FileName, 0.125));
+
+  std::string data;
+  validate(readFile(FileName, data));
+  std::remove(FileName.c_str());
+
+  Snapshot snapshot;
+  validate(exahype::plotters::compressedsnapshot::readSnapshot(data, snapshot));
+  Snapshot reverse;
+  validate(exahype::plotters::compressedsnapshot::readSnapshot(data, reverse, ReverseFor()));
+  validate(reverse.values==snapshot.values);
+  validateEquals(snapshot.dimensions, Dimensions);
+  validateEquals(snapshot.quantities, quantities);
+  validateEquals(snapshot.cells, Patches*CellsPerPatch);
+  validateWithParams1(snapshot.chunks > 1, snapshot.chunks);
+  validateNumericalEqualsWithEpsWithParams1(snapshot.time, 0.125, 0.0, snapshot.time);
+  validateEquals(snapshot.patchGeometry.size(), geometry.size());
+  for (unsigned int i = 0; i < geometry.size() && i < snapshot.patchGeometry.size(); i++) {
+    validateNumericalEqualsWithEpsWithParams1(snapshot.patchGeometry[i], geometry[i], 0.0, i);
+  }
+  for (unsigned int patch = 0; patch < snapshot.cellsPerAxis.size(); patch++) {
+    validateEquals(snapshot.cellsPerAxis[patch], CellsPerAxis);
+  }
+
+  if (snapshot.values.size()==values.size()) {
+    for (int cell = 0; cell < Patches*CellsPerPatch; cell++) {
+      for (int q = 0; q < quantities; q++) {
+        const double v       = values[cell*quantities+q];
+        const double decoded = snapshot.values[cell*quantities+q];
+        const double clamped = 2.0*errorBounds[q]*MaxQuantised;
+        if (std::isnan(v)) {
+          validateNumericalEqualsWithEpsWithParams2(decoded, 0.0, 0.0, cell, q);
+        } else if (!(std::abs(v) < clamped)) {
+          validateNumericalEqualsWithEpsWithParams2(decoded, v > 0.0 ? clamped : -clamped, 0.0, cell, q);
+        } else {
+          // allow for the round-off of v/(2e) and of the decoding
+          validateNumericalEqualsWithEpsWithParams2(decoded, v, errorBounds[q]*(1.0+1e-9), cell, q);
+        }
+      }
+    }
+  }
+}
+
+void CompressedSnapshotWriterTest::testSizeOfSyntheticData() {
+  constexpr int Dimensions    = 2;
+  constexpr int Patches       = 64;
+  constexpr int CellsPerAxis  = 16;
+  constexpr int CellsPerPatch = CellsPerAxis*CellsPerAxis;
+  const std::vector<double> errorBounds = {1e-4, 1e-4, 1e-4, 1e-4};
+  const int quantities = errorBounds.size();
+
+  // smooth water height, momenta and bathymetry on 8x8 patches
+  exahype::plotters::CompressedSnapshotWriter writer(Dimensions, errorBounds);
+  std::vector<double> cellValues(quantities);
+  for (int patch = 0; patch < Patches; patch++) {
+    const double offset[Dimensions] = {1.0*(patch%8), 1.0*(patch/8)};
+    const double size[Dimensions]   = {1.0, 1.0};
+    writer.addPatch(offset, size, CellsPerAxis);
+    for (int cell = 0; cell < CellsPerPatch; cell++) {
+      const double x = offset[0] + (cell%CellsPerAxis+0.5)/CellsPerAxis;
+      const double y = offset[1] + (cell/CellsPerAxis+0.5)/CellsPerAxis;
+      cellValues[3] = -1.0 + 0.2*std::sin(0.5*x)*std::cos(0.3*y);
+      cellValues[0] = 0.1*std::exp(-0.1*((x-4)*(x-4)+(y-4)*(y-4))) - cellValues[3];
+      cellValues[1] = 0.05*cellValues[0]*std::sin(x);
+      cellValues[2] = 0.05*cellValues[0]*std::cos(y);
+      writer.addCell(cellValues.data());
+    }
+  }
+  validate(writer.writeToFile(FileName, 0.0));
+
+  std::string data;
+  validate(readFile(FileName, data));
+  std::remove(FileName.c_str());
+
+  const double rawBytes = static_cast<double>(Patches)*CellsPerPatch*quantities*sizeof(double);
+  logInfo("testSizeOfSyntheticData()", "synthetic smooth data, " << Patches*CellsPerPatch << " cells, " <<
+      quantities << " quantities, error bound " << errorBounds[0] << ": " << data.size() << " bytes vs. " <<
+      rawBytes << " bytes of raw doubles (ratio " << rawBytes/data.size() << "); real snapshots with shocks compress less");
+  validateWithParams1(data.size() < rawBytes, data.size());
+}
+
+}  // namespace plotters
+}  // namespace tests
+}  // namespace exahype
@@ -0,0 +1,50 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_COMPRESSED_SNAPSHOT_WRITER_TEST_H_
+#define _EXAHYPE_TESTS_COMPRESSED_SNAPSHOT_WRITER_TEST_H_
+
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace tests {
+namespace plotters {
+
+/**
+ * Writes snapshots with the CompressedSnapshotWriter and decodes them with
+ * the CompressedSnapshotReader the front end uses, serially and with the
+ * chunks in reverse order: every decoded value has to lie within the error bound of its quantity,
+ * also across chunk borders; NaN and values which cannot be represented
+ * have to be clamped. Also reports the size of a snapshot of smooth
+ * synthetic data compared to the raw doubles.
+ */
+class CompressedSnapshotWriterTest : public tarch::tests::TestCase {
+ public:
+  CompressedSnapshotWriterTest();
+  virtual ~CompressedSnapshotWriterTest();
+
+  void run() override;
+
+ private:
+  static tarch::logging::Log _log;
+
+  void testRoundTrip();
+  void testSizeOfSyntheticData();
+};
+
+}  // namespace plotters
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_COMPRESSED_SNAPSHOT_WRITER_TEST_H_
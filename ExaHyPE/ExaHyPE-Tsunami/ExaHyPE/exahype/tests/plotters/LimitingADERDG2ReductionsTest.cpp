@@ -0,0 +1,227 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/plotters/LimitingADERDG2ReductionsTest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tarch/parallel/Node.h"
+#include "tarch/tests/TestCaseFactory.h"
+
+#include "peano/utils/Loop.h"
+
+#include "kernels/GaussLegendreBasis.h"
+
+#include "exahype/parser/ParserView.h"
+#include "exahype/plotters/LimitingADERDG2Reductions.h"
+
+#ifndef ALIGNMENT
+registerTest(exahype::tests::plotters::LimitingADERDG2ReductionsTest)
+#endif
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::plotters::LimitingADERDG2ReductionsTest::_log( "exahype::tests::plotters::LimitingADERDG2ReductionsTest" );
+
+namespace {
+
+const std::string FileName = "LimitingADERDG2ReductionsTest";
+
+constexpr int Order           = 1;
+constexpr int Unknowns        = 2;
+constexpr int GhostLayerWidth = 1;
+constexpr int CellsPerAxis    = 2;
+
+/**
+ * Writes the solution unchanged.
+ */
+class IdentityPostProcessing : public exahype::plotters::Plotter::UserOnTheFlyPostProcessing {
+ public:
+  void startPlotting(double time) override {}
+  void finishPlotting() override {}
+
+  void mapQuantities(
+      const tarch::la::Vector<DIMENSIONS, double>& offsetOfPatch,
+      const tarch::la::Vector<DIMENSIONS, double>& sizeOfPatch,
+      const tarch::la::Vector<DIMENSIONS, double>& x,
+      const tarch::la::Vector<DIMENSIONS, int>&    pos,
+      double* const Q,
+      double* const outputQuantities,
+      double timeStamp) override {
+    std::copy_n(Q, Unknowns, outputQuantities);
+  }
+};
+
+template <typename T>
+bool read(const char*& in, const char* end, T& value) {
+  if (end-in < static_cast<std::ptrdiff_t>(sizeof(T))) {
+    return false;
+  }
+  std::memcpy(&value, in, sizeof(T));
+  in += sizeof(T);
+  return true;
+}
+
+bool readFile(const std::string& fileName, std::string& data) {
+  std::ifstream in(fileName, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  return true;
+}
+
+}  // namespace
+
+namespace exahype {
+namespace tests {
+namespace plotters {
+
+LimitingADERDG2ReductionsTest::LimitingADERDG2ReductionsTest()
+    : tarch::tests::TestCase("exahype::tests::plotters::LimitingADERDG2ReductionsTest") {}
+
+LimitingADERDG2ReductionsTest::~LimitingADERDG2ReductionsTest() {}
+
+void LimitingADERDG2ReductionsTest::run() {
+  testMethod(testReductionsAndTransect);
+}
+
+void LimitingADERDG2ReductionsTest::testReductionsAndTransect() {
+  logInfo("testReductionsAndTransect()", "Test reductions::binary plotter on an ADER-DG and a finite volumes patch, ORDER=1");
+
+  // the ADER-DG patch [0,1]^d and the finite volumes patch [1,2]x[0,1]^(d-1) hold u=(x,2)
+  std::vector<double> aderdgSolution(Unknowns*static_cast<int>(std::pow(Order+1,DIMENSIONS)));
+  dfor(i,Order+1) {
+    const int node = peano::utils::dLinearisedWithoutLookup(i,Order+1);
+    aderdgSolution[node*Unknowns+0] = kernels::legendre::nodes[Order][i(0)];
+    aderdgSolution[node*Unknowns+1] = 2.0;
+  }
+  const tarch::la::Vector<DIMENSIONS,double> aderdgOffset(0.0);
+
+  const int cellsPerAxisWithGhostLayers = CellsPerAxis+2*GhostLayerWidth;
+  std::vector<double> finiteVolumesSolution(Unknowns*static_cast<int>(std::pow(cellsPerAxisWithGhostLayers,DIMENSIONS)),1e3); // ghost cells are ignored
+  dfor(i,CellsPerAxis) {
+    const int cell = peano::utils::dLinearisedWithoutLookup(i+GhostLayerWidth,cellsPerAxisWithGhostLayers);
+    finiteVolumesSolution[cell*Unknowns+0] = 1.0 + (i(0)+0.5)/CellsPerAxis;
+    finiteVolumesSolution[cell*Unknowns+1] = 2.0;
+  }
+  tarch::la::Vector<DIMENSIONS,double> finiteVolumesOffset(0.0);
+  finiteVolumesOffset(0) = 1.0;
+
+  const tarch::la::Vector<DIMENSIONS,double> size(1.0);
+
+  IdentityPostProcessing postProcessing;
+  {
+    exahype::plotters::LimitingADERDG2Reductions plotter(&postProcessing,GhostLayerWidth);
+    plotter.init(FileName,Order+1,Unknowns,Unknowns,exahype::parser::ParserView());
+
+    // one sample in each patch
+    exahype::plotters::LimitingADERDG2Reductions::Transect transect;
+    transect.from    = tarch::la::Vector<DIMENSIONS,double>(0.5);
+    transect.to      = tarch::la::Vector<DIMENSIONS,double>(0.5);
+    transect.from(0) = 0.25;
+    transect.to(0)   = 1.25;
+    transect.samples = 2;
+    plotter.addTransect(transect);
+
+    plotter.startPlotting(0.5);
+    auto& reductions = plotter.getPartialReductions();
+    plotter.reduceADERDGPatch(reductions,aderdgOffset,size,aderdgSolution.data(),0.5);
+    plotter.reduceFiniteVolumesPatch(reductions,finiteVolumesOffset,size,finiteVolumesSolution.data(),CellsPerAxis,0.5);
+    plotter.finishPlotting();
+  }
+
+  std::ostringstream fileName;
+  fileName << FileName
+           #ifdef Parallel
+           << "-rank-" << tarch::parallel::Node::getInstance().getRank()
+           #endif
+           << ".reductions";
+  std::string data;
+  validate(readFile(fileName.str(), data));
+  std::remove(fileName.str().c_str());
+
+  const char* in  = data.data();
+  const char* end = data.data() + data.size();
+
+  // header
+  char    magic[8];
+  int32_t writtenUnknowns = 0, dimensions = 0, transects = 0, samples = 0;
+  double  from[DIMENSIONS], to[DIMENSIONS];
+  for (char& c : magic) {
+    validate(read(in,end,c));
+  }
+  validate(std::string(magic,8)=="EXARED01");
+  validate(read(in,end,writtenUnknowns));
+  validate(read(in,end,dimensions));
+  validate(read(in,end,transects));
+  validateEquals(writtenUnknowns,Unknowns);
+  validateEquals(dimensions,DIMENSIONS);
+  validateEquals(transects,1);
+  for (double& x : from) { validate(read(in,end,x)); }
+  for (double& x : to)   { validate(read(in,end,x)); }
+  validate(read(in,end,samples));
+  validateNumericalEquals(from[0],0.25);
+  validateNumericalEquals(to[0],1.25);
+  validateEquals(samples,2);
+
+  // snapshot; the 2-point quadrature integrates x^2 exactly
+  double time = 0.0, volume = 0.0;
+  validate(read(in,end,time));
+  validate(read(in,end,volume));
+  validateNumericalEquals(time,0.5);
+  validateNumericalEquals(volume,2.0);
+
+  const double expectedMin[Unknowns] = { kernels::legendre::nodes[Order][0], 2.0 };
+  const double expectedMax[Unknowns] = { 1.75, 2.0 };
+  const double expectedL2[Unknowns]  = { std::sqrt(1.0/3.0 + 0.5*(1.25*1.25+1.75*1.75)), std::sqrt(8.0) };
+  for (int unknown=0; unknown<Unknowns; unknown++) {
+    double min = 0.0, max = 0.0, l2 = 0.0;
+    validate(read(in,end,min));
+    validate(read(in,end,max));
+    validate(read(in,end,l2));
+    validateNumericalEqualsWithParams1(min,expectedMin[unknown],unknown);
+    validateNumericalEqualsWithParams1(max,expectedMax[unknown],unknown);
+    validateNumericalEqualsWithParams1(l2,expectedL2[unknown],unknown);
+  }
+
+  // the ADER-DG polynomial is linear; the finite volumes sample is the cell value
+  const double expectedSamples[2][Unknowns] = { { 0.25, 2.0 }, { 1.25, 2.0 } };
+  for (int sample=0; sample<2; sample++) {
+    for (int unknown=0; unknown<Unknowns; unknown++) {
+      double value = 0.0;
+      validate(read(in,end,value));
+      validateNumericalEqualsWithParams2(value,expectedSamples[sample][unknown],sample,unknown);
+    }
+  }
+  validate(in==end);
+}
+
+}  // namespace plotters
+}  // namespace tests
+}  // namespace exahype
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", on)
+#endif
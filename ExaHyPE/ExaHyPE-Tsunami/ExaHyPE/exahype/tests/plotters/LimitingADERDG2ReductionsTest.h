@@ -0,0 +1,48 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_LIMITING_ADERDG_2_REDUCTIONS_TEST_H_
+#define _EXAHYPE_TESTS_LIMITING_ADERDG_2_REDUCTIONS_TEST_H_
+
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace tests {
+namespace plotters {
+
+/**
+ * Reduces a hand-built ADER-DG patch and a hand-built finite volumes patch,
+ * both with a linear solution, with the LimitingADERDG2Reductions plotter and
+ * reads the snapshot back: minimum, maximum and L2 norm are exact for
+ * the quadrature and the cell averages, and the transect samples the
+ * ADER-DG polynomial and the finite volumes cell containing the point.
+ */
+class LimitingADERDG2ReductionsTest : public tarch::tests::TestCase {
+ public:
+  LimitingADERDG2ReductionsTest();
+  virtual ~LimitingADERDG2ReductionsTest();
+
+  void run() override;
+
+ private:
+  static tarch::logging::Log _log;
+
+  void testReductionsAndTransect();
+};
+
+}  // namespace plotters
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_LIMITING_ADERDG_2_REDUCTIONS_TEST_H_
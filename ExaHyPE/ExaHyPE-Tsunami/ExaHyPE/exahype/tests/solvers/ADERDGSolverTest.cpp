@@ -0,0 +1,471 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/solvers/ADERDGSolverTest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "tarch/la/Vector.h"
+#include "tarch/tests/TestCaseFactory.h"
+
+#include "exahype/solvers/ADERDGSolver.h"
+#include "exahype/solvers/FiniteVolumesSolver.h"
+#include "exahype/mappings/LevelwiseAdjacencyBookkeeping.h"
+
+#include "exahype/tests/solvers/ADERDGTestSolver.h"
+
+#ifndef ALIGNMENT
+registerTest(exahype::tests::solvers::ADERDGSolverTest)
+#endif
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::solvers::ADERDGSolverTest::_log( "exahype::tests::solvers::ADERDGSolverTest" );
+
+namespace {
+
+typedef exahype::solvers::ADERDGSolver    ADERDGSolver;
+typedef ADERDGSolver::CellDescription     CellDescription;
+typedef exahype::solvers::Solver::TimeStepping TimeStepping;
+
+}  // namespace
+
+namespace exahype {
+namespace tests {
+namespace solvers {
+
+ADERDGSolverTest::ADERDGSolverTest()
+    : tarch::tests::TestCase("exahype::tests::solvers::ADERDGSolverTest") {}
+
+ADERDGSolverTest::~ADERDGSolverTest() {}
+
+void ADERDGSolverTest::run() {
+  testMethod(testRefineLocalTimeStepSize);
+  testMethod(testAccumulatedFluctuations);
+  testMethod(testDetermineIfCellIsInert);
+  testMethod(testSkipFacesOfInactiveCells);
+  testMethod(testReactivation);
+  testMethod(testCompressionRoundTrip);
+}
+
+int ADERDGSolverTest::createLeaf(ADERDGTestSolver& solver,const int solverNumber,const double offsetX) {
+  const int cellDescriptionsIndex = ADERDGSolver::Heap::getInstance().createData(0,1);
+  exahype::solvers::FiniteVolumesSolver::Heap::getInstance().createDataForIndex(cellDescriptionsIndex,0,1);
+  exahype::solvers::Solver::CellInfo cellInfo(cellDescriptionsIndex);
+  tarch::la::Vector<DIMENSIONS,double> offset(0.0);
+  offset[0] = offsetX;
+  ADERDGSolver::addNewCellDescription(
+      solverNumber,cellInfo,CellDescription::Type::Leaf,1,-1,
+      tarch::la::Vector<DIMENSIONS,double>(1.0),offset);
+  CellDescription& cellDescription = cellInfo._ADERDGCellDescriptions[0];
+  solver.ensureNecessaryMemoryIsAllocated(cellDescription);
+  cellDescription.setRefinementStatus(ADERDGSolver::Keep);
+  cellDescription.setTimeStamp(0.0);
+  cellDescription.setTimeStepSize(0.0);
+  std::fill_n(static_cast<double*>(cellDescription.getSolution()),solver.getDataPerCell(),1.0);
+  std::fill_n(static_cast<double*>(cellDescription.getPreviousSolution()),solver.getDataPerCell(),0.0);
+  std::fill_n(static_cast<double*>(cellDescription.getUpdate()),solver.getUpdateSize(),0.0);
+  std::fill_n(static_cast<double*>(cellDescription.getExtrapolatedPredictor()),solver.getBndTotalSize(),0.0);
+  std::fill_n(static_cast<double*>(cellDescription.getFluctuation()),solver.getBndFluxTotalSize(),0.0);
+  return cellDescriptionsIndex;
+}
+
+void ADERDGSolverTest::integrateFaces(ADERDGTestSolver& solver,CellDescription& cellDescription) {
+  std::fill_n(solver.faceIntegrals,DIMENSIONS_TIMES_TWO,0.0);
+  cellDescription.setNeighbourMergePerformed(static_cast<signed char>(true));
+  solver.surfaceIntegral(cellDescription,tarch::la::Vector<DIMENSIONS_TIMES_TWO,int>(0),true);
+}
+
+void ADERDGSolverTest::testRefineLocalTimeStepSize() {
+  logInfo("testRefineLocalTimeStepSize()", "Test local time stepping: halving the time step size within a macro time step");
+
+  const int localTimeSteppingLevels = exahype::solvers::Solver::LocalTimeSteppingLevels;
+  exahype::solvers::Solver::LocalTimeSteppingLevels = 2;
+
+  ADERDGTestSolver solver(TimeStepping::Local);
+  solver._minTimeStamp            = 0.0;
+  solver._minTimeStepSize         = 1.0;
+  solver._localTimeStep           = 1;
+  solver._localTimeSteppingLevels = 2;
+
+  // the time step size is still admissible
+  solver._admissibleTimeStepSize = 1.5;
+  solver.refineLocalTimeStepSize();
+  validateNumericalEquals(solver._minTimeStepSize,1.0);
+  validateEquals(solver._localTimeStep,1);
+  validateEquals(solver._localTimeSteppingLevels,2);
+
+  // halved twice: the remaining 3 of 4 time steps become 12 of 16, the macro time step still ends at 4.0
+  solver._admissibleTimeStepSize = 0.3;
+  solver.refineLocalTimeStepSize();
+  validateNumericalEquals(solver._minTimeStepSize,0.25);
+  validateEquals(solver._localTimeStep,4);
+  validateEquals(solver._localTimeSteppingLevels,4);
+  validateNumericalEquals(((1<<solver._localTimeSteppingLevels)-solver._localTimeStep)*solver._minTimeStepSize,3.0);
+
+  // the last time step ends the macro time step, which restores the levels and takes over the admissible time step size
+  solver._minTimeStamp = 1.0;
+  for (int step = 4; step < 16; step++) {
+    solver._admissibleTimeStepSize = 0.3;
+    solver.wrapUpTimeStep(true,true);
+    validateNumericalEqualsWithParams1(solver._minTimeStepSize,step<15 ? 0.25 : 0.3,step);
+  }
+  validateNumericalEquals(solver._minTimeStamp,4.0);
+  validateEquals(solver._localTimeStep,0);
+  validateEquals(solver._localTimeSteppingLevels,2);
+
+  exahype::solvers::Solver::LocalTimeSteppingLevels = localTimeSteppingLevels;
+}
+
+void ADERDGSolverTest::testAccumulatedFluctuations() {
+  logInfo("testAccumulatedFluctuations()", "Test local time stepping: fluctuations accumulated at an interface");
+
+  ADERDGTestSolver solver(TimeStepping::Local);
+  exahype::solvers::RegisteredSolvers.push_back(&solver);
+  const int solverNumber = exahype::solvers::RegisteredSolvers.size()-1;
+  const int dofsPerFace  = solver.getBndFluxSize();
+
+  const double dt = 0.1;
+  solver._minTimeStamp    = 0.0;
+  solver._minTimeStepSize = dt;
+
+  const int largeIndex = createLeaf(solver,solverNumber,0.0);
+  const int smallIndex = createLeaf(solver,solverNumber,1.0);
+  CellDescription& large = ADERDGSolver::getCellDescription(largeIndex,0); // left
+  CellDescription& small = ADERDGSolver::getCellDescription(smallIndex,0); // right
+  large.setTimeStamp(0.0);
+  large.setTimeStepSize(2*dt);
+  small.setTimeStamp(0.0);
+  small.setTimeStepSize(dt);
+
+  const tarch::la::Vector<DIMENSIONS,int> pos1(0);
+  tarch::la::Vector<DIMENSIONS,int> pos2(0);
+  pos2[0] = 1;
+  exahype::solvers::Solver::InterfaceInfo face(pos1,pos2);
+  const double* const accumulatedLarge = static_cast<double*>(large.getAccumulatedFluctuation()) + dofsPerFace * face._faceIndexLeft;
+  const double* const accumulatedSmall = static_cast<double*>(small.getAccumulatedFluctuation()) + dofsPerFace * face._faceIndexRight;
+  const double* const fluctuationLarge = static_cast<double*>(large.getFluctuation()) + dofsPerFace * face._faceIndexLeft;
+
+  // first time step of the small cell: the large cell gets the fluctuation weighted with 1/2
+  solver.solveRiemannProblemAtInterface(large,small,face);
+  for (int i = 0; i < dofsPerFace; i++) {
+    validateNumericalEqualsWithParams1(accumulatedLarge[i],0.5*ADERDGTestSolver::FluctuationLeft,i);
+    validateNumericalEqualsWithParams1(accumulatedSmall[i],ADERDGTestSolver::FluctuationRight,i);
+    validateNumericalEqualsWithParams1(fluctuationLarge[i],0.0,i); // the predictor fluxes are required by the next merge
+  }
+  integrateFaces(solver,small);
+  validateNumericalEquals(solver.faceIntegrals[face._faceIndexRight],dt*ADERDGTestSolver::FluctuationRight);
+  for (int i = 0; i < dofsPerFace; i++) {
+    validateNumericalEqualsWithParams1(accumulatedSmall[i],0.0,i);
+  }
+
+  // second time step of the small cell
+  solver._minTimeStamp = dt;
+  small.setTimeStamp(dt);
+  solver.solveRiemannProblemAtInterface(large,small,face);
+  for (int i = 0; i < dofsPerFace; i++) {
+    validateNumericalEqualsWithParams1(accumulatedLarge[i],ADERDGTestSolver::FluctuationLeft,i);
+    validateNumericalEqualsWithParams1(accumulatedSmall[i],ADERDGTestSolver::FluctuationRight,i);
+  }
+  integrateFaces(solver,small);
+  validateNumericalEquals(solver.faceIntegrals[face._faceIndexRight],dt*ADERDGTestSolver::FluctuationRight);
+
+  // the large cell integrates the flux of both merges over its time step: conservative
+  integrateFaces(solver,large);
+  validateNumericalEquals(solver.faceIntegrals[face._faceIndexLeft],2*dt*ADERDGTestSolver::FluctuationLeft);
+  for (int i = 0; i < dofsPerFace; i++) {
+    validateNumericalEqualsWithParams1(accumulatedLarge[i],0.0,i);
+  }
+
+  // clean up
+  exahype::solvers::RegisteredSolvers.pop_back();
+  exahype::DataHeap::getInstance().deleteAllData();
+  ADERDGSolver::Heap::getInstance().deleteAllData();
+  exahype::solvers::FiniteVolumesSolver::Heap::getInstance().deleteAllData();
+}
+
+void ADERDGSolverTest::testDetermineIfCellIsInert() {
+  logInfo("testDetermineIfCellIsInert()", "Test inert cells: detection and deactivation");
+
+  ADERDGTestSolver solver(TimeStepping::Global);
+  exahype::solvers::RegisteredSolvers.push_back(&solver);
+  const int solverNumber = exahype::solvers::RegisteredSolvers.size()-1;
+
+  CellDescription& cellDescription = ADERDGSolver::getCellDescription(createLeaf(solver,solverNumber,0.0),0);
+  tarch::la::Vector<DIMENSIONS_TIMES_TWO,int> boundaryMarkers(0);
+
+  // the user hook decides for interior cells
+  solver.inert = true;
+  solver.determineIfCellIsInert(cellDescription,boundaryMarkers);
+  validate(cellDescription.getIsInert());
+  solver.inert = false;
+  solver.determineIfCellIsInert(cellDescription,boundaryMarkers);
+  validate(!cellDescription.getIsInert());
+
+  // never at the domain boundary or in the neighbourhood of troubled cells
+  solver.inert = true;
+  boundaryMarkers[1] = exahype::mappings::LevelwiseAdjacencyBookkeeping::DomainBoundaryAdjacencyIndex;
+  solver.determineIfCellIsInert(cellDescription,boundaryMarkers);
+  validate(!cellDescription.getIsInert());
+  boundaryMarkers[1] = 0;
+  cellDescription.setRefinementStatus(solver._minRefinementStatusForTroubledCell-2);
+  solver.determineIfCellIsInert(cellDescription,boundaryMarkers);
+  validate(!cellDescription.getIsInert());
+  cellDescription.setRefinementStatus(ADERDGSolver::Keep);
+
+  // never with local time stepping
+  ADERDGTestSolver localSolver(TimeStepping::Local);
+  localSolver.inert = true;
+  localSolver.determineIfCellIsInert(cellDescription,boundaryMarkers);
+  validate(!cellDescription.getIsInert());
+
+  // deactivated only if no neighbour was non-inert; the neighbour flag is reset
+  solver.determineIfCellIsInert(cellDescription,boundaryMarkers);
+  validate(cellDescription.getIsInert());
+  cellDescription.setHasNonInertNeighbour(true);
+  validate(!solver.deactivateIfInert(cellDescription));
+  validate(!cellDescription.getIsInactive());
+  validate(!cellDescription.getHasNonInertNeighbour());
+  validate(solver.deactivateIfInert(cellDescription));
+  validate(cellDescription.getIsInactive());
+
+  // clean up
+  exahype::solvers::RegisteredSolvers.pop_back();
+  exahype::DataHeap::getInstance().deleteAllData();
+  ADERDGSolver::Heap::getInstance().deleteAllData();
+  exahype::solvers::FiniteVolumesSolver::Heap::getInstance().deleteAllData();
+}
+
+void ADERDGSolverTest::testSkipFacesOfInactiveCells() {
+  logInfo("testSkipFacesOfInactiveCells()", "Test inert cells: zero flux between an inactive and an inert cell");
+
+  ADERDGTestSolver solver(TimeStepping::Global);
+  exahype::solvers::RegisteredSolvers.push_back(&solver);
+  const int solverNumber = exahype::solvers::RegisteredSolvers.size()-1;
+  const int dofsPerFace  = solver.getBndFluxSize();
+
+  const int inactiveIndex = createLeaf(solver,solverNumber,0.0);
+  const int inertIndex    = createLeaf(solver,solverNumber,1.0);
+  solver._minTimeStamp    = 0.0;
+  solver._minTimeStepSize = 0.1;
+  exahype::solvers::Solver::CellInfo inactiveCellInfo(inactiveIndex);
+  exahype::solvers::Solver::CellInfo inertCellInfo(inertIndex);
+  CellDescription& inactive = inactiveCellInfo._ADERDGCellDescriptions[0]; // left
+  CellDescription& inert    = inertCellInfo._ADERDGCellDescriptions[0];    // right
+  inactive.setIsInert(true);
+  inactive.setIsInactive(true);
+  inert.setIsInert(true);
+  inert.setTimeStepSize(0.1);
+  std::fill_n(static_cast<double*>(inert.getFluctuation()),solver.getBndFluxTotalSize(),1.0);
+
+  const tarch::la::Vector<DIMENSIONS,int> pos1(0);
+  tarch::la::Vector<DIMENSIONS,int> pos2(0);
+  pos2[0] = 1;
+  exahype::solvers::Solver::InterfaceInfo face(pos1,pos2);
+
+  // no Riemann solve; the face is marked as skipped in both cells
+  solver.mergeNeighboursData(solverNumber,inactiveCellInfo,inertCellInfo,pos1,pos2);
+  validateEquals(inactive.getSkippedFaces(),1 << face._faceIndexLeft);
+  validateEquals(inert.getSkippedFaces(),1 << face._faceIndexRight);
+  validate(!inactive.getHasNonInertNeighbour());
+  validate(!inert.getHasNonInertNeighbour());
+  validate(inactive.getIsInactive());
+  validateEquals(solver.predictions,0);
+  for (int i = 0; i < dofsPerFace; i++) {
+    validateNumericalEqualsWithParams1(static_cast<double*>(inert.getFluctuation())[dofsPerFace*face._faceIndexRight+i],1.0,i);
+  }
+
+  // the inert cell does not integrate the skipped face
+  integrateFaces(solver,inert);
+  for (int faceIndex = 0; faceIndex < DIMENSIONS_TIMES_TWO; faceIndex++) {
+    validateNumericalEqualsWithParams1(solver.faceIntegrals[faceIndex],faceIndex==face._faceIndexRight ? 0.0 : 0.1,faceIndex);
+  }
+  validateEquals(inert.getSkippedFaces(),0);
+
+  // the inactive cell keeps its solution
+  solver.skipUpdateOfInactiveCell(inactive);
+  for (int i = 0; i < solver.getDataPerCell(); i++) {
+    validateNumericalEqualsWithParams1(static_cast<double*>(inactive.getPreviousSolution())[i],1.0,i);
+  }
+  validateEquals(inactive.getSkippedFaces(),0);
+  validate(tarch::la::equals(inactive.getNeighbourMergePerformed(),static_cast<signed char>(false)));
+
+  // clean up
+  exahype::solvers::RegisteredSolvers.pop_back();
+  exahype::DataHeap::getInstance().deleteAllData();
+  ADERDGSolver::Heap::getInstance().deleteAllData();
+  exahype::solvers::FiniteVolumesSolver::Heap::getInstance().deleteAllData();
+}
+
+void ADERDGSolverTest::testReactivation() {
+  logInfo("testReactivation()", "Test inert cells: reactivation by a merge with a non-inert neighbour");
+
+  ADERDGTestSolver solver(TimeStepping::Global);
+  exahype::solvers::RegisteredSolvers.push_back(&solver);
+  const int solverNumber = exahype::solvers::RegisteredSolvers.size()-1;
+  const int dofsPerFace  = solver.getBndFluxSize();
+  const int dataPerFace  = solver.getBndFaceSize();
+
+  const int inactiveIndex = createLeaf(solver,solverNumber,0.0);
+  const int activeIndex   = createLeaf(solver,solverNumber,1.0);
+  solver._minTimeStamp    = 0.0;
+  solver._minTimeStepSize = 0.1;
+  exahype::solvers::Solver::CellInfo inactiveCellInfo(inactiveIndex);
+  exahype::solvers::Solver::CellInfo activeCellInfo(activeIndex);
+  CellDescription& inactive = inactiveCellInfo._ADERDGCellDescriptions[0]; // left
+  CellDescription& active   = activeCellInfo._ADERDGCellDescriptions[0];   // right
+  inactive.setIsInert(true);
+  inactive.setIsInactive(true);
+  inactive.setTimeStepSize(0.1);
+  active.setIsInert(false);
+  active.setTimeStepSize(0.1);
+
+  const tarch::la::Vector<DIMENSIONS,int> pos1(0);
+  tarch::la::Vector<DIMENSIONS,int> pos2(0);
+  pos2[0] = 1;
+  exahype::solvers::Solver::InterfaceInfo face(pos1,pos2);
+
+  // the merge computes the prediction of the inactive cell before the Riemann solve
+  solver.mergeNeighboursData(solverNumber,inactiveCellInfo,activeCellInfo,pos1,pos2);
+  validateEquals(solver.predictions,1);
+  validate(!inactive.getIsInactive());
+  validate(inactive.getHasNonInertNeighbour());
+  validateEquals(inactive.getSkippedFaces(),0);
+  for (int i = 0; i < dataPerFace; i++) {
+    validateNumericalEqualsWithParams1(static_cast<double*>(inactive.getExtrapolatedPredictor())[dataPerFace*face._faceIndexLeft+i],1.0,i);
+  }
+  for (int i = 0; i < dofsPerFace; i++) {
+    validateNumericalEqualsWithParams1(static_cast<double*>(inactive.getFluctuation())[dofsPerFace*face._faceIndexLeft+i],ADERDGTestSolver::FluctuationLeft,i);
+    validateNumericalEqualsWithParams1(static_cast<double*>(active.getFluctuation())[dofsPerFace*face._faceIndexRight+i],ADERDGTestSolver::FluctuationRight,i);
+  }
+
+  // later merges find the cell active; the claim was released
+  solver.reactivate(inactive);
+  validateEquals(solver.predictions,1);
+  validate(inactive.tryToClaimReactivation());
+  inactive.releaseReactivation();
+
+  // clean up
+  exahype::solvers::RegisteredSolvers.pop_back();
+  exahype::DataHeap::getInstance().deleteAllData();
+  ADERDGSolver::Heap::getInstance().deleteAllData();
+  exahype::solvers::FiniteVolumesSolver::Heap::getInstance().deleteAllData();
+}
+
+void ADERDGSolverTest::testCompressionRoundTrip() {
+  logInfo("testCompressionRoundTrip()", "Test data compression: compress two cells and uncompress them in a neighbour merge");
+
+  const double compressionAccuracy             = exahype::solvers::Solver::CompressionAccuracy;
+  const bool   spawnCompressionAsBackgroundJob = exahype::solvers::Solver::SpawnCompressionAsBackgroundJob;
+  exahype::solvers::Solver::CompressionAccuracy             = 1e-6;
+  exahype::solvers::Solver::SpawnCompressionAsBackgroundJob = false;
+
+  ADERDGTestSolver solver(TimeStepping::Global);
+  exahype::solvers::RegisteredSolvers.push_back(&solver);
+  const int solverNumber = exahype::solvers::RegisteredSolvers.size()-1;
+  const int dataPerCell  = solver.getDataPerCell();
+
+  const int leftIndex  = createLeaf(solver,solverNumber,0.0);
+  const int rightIndex = createLeaf(solver,solverNumber,1.0);
+  solver._minTimeStamp    = 0.0;
+  solver._minTimeStepSize = 0.1;
+  exahype::solvers::Solver::CellInfo leftCellInfo(leftIndex);
+  exahype::solvers::Solver::CellInfo rightCellInfo(rightIndex);
+  CellDescription& left  = leftCellInfo._ADERDGCellDescriptions[0];
+  CellDescription& right = rightCellInfo._ADERDGCellDescriptions[0];
+  left.setTimeStepSize(0.1);
+  right.setTimeStepSize(0.1);
+
+  // distinct solutions per cell so that mixed up cells are detected
+  std::vector<double> leftSolution(dataPerCell), rightSolution(dataPerCell), rightPreviousSolution(dataPerCell,3.0);
+  for (int i = 0; i < dataPerCell; i++) {
+    leftSolution[i]  = 1.0 + 0.25*i;
+    rightSolution[i] = -2.0 + 0.5*i;
+  }
+  std::copy(leftSolution.begin(),leftSolution.end(),static_cast<double*>(left.getSolution()));
+  std::copy(rightSolution.begin(),rightSolution.end(),static_cast<double*>(right.getSolution()));
+  std::copy(rightPreviousSolution.begin(),rightPreviousSolution.end(),static_cast<double*>(right.getPreviousSolution()));
+  const double leftMean  = 1.0 + 0.25*(dataPerCell-1)/2.0;
+  const double rightMean = -2.0 + 0.5*(dataPerCell-1)/2.0;
+
+  // the job sets the state; the averages initialised with NaNs are zeroed before summation
+  const int enclaveJobs = exahype::solvers::Solver::NumberOfEnclaveJobs.load();
+  left.setCompressionState(CellDescription::CurrentlyProcessed);
+  ADERDGSolver::CompressionJob job(solver,left,false);
+  validateEquals(exahype::solvers::Solver::NumberOfEnclaveJobs.load(),enclaveJobs+1);
+  job.run(false);
+  validateEquals(exahype::solvers::Solver::NumberOfEnclaveJobs.load(),enclaveJobs);
+  validateEquals(left.getCompressionState(),CellDescription::Compressed);
+  validateNumericalEquals(static_cast<double*>(left.getSolutionAverages())[0],leftMean);
+  validateNumericalEquals(static_cast<double*>(left.getPreviousSolutionAverages())[0],0.0);
+  validate(!std::isnan(static_cast<double*>(left.getUpdateAverages())[0]));
+  validate(!std::isnan(static_cast<double*>(left.getExtrapolatedPredictorAverages())[0]));
+  validate(!std::isnan(static_cast<double*>(left.getFluctuationAverages())[0]));
+
+  solver.compress(right,false);
+  validateEquals(right.getCompressionState(),CellDescription::Compressed);
+  validateNumericalEquals(static_cast<double*>(right.getSolutionAverages())[0],rightMean);
+  validateNumericalEquals(static_cast<double*>(right.getPreviousSolutionAverages())[0],3.0);
+  validate(right.getBytesPerDoFInPreviousSolution()<7); // a constant is compressed
+  #if !defined(ValidateCompressedVsUncompressedData)
+  validateEquals(right.getPreviousSolutionIndex(),-1);
+  #endif
+
+  // the merge uncompresses both cells; the arrays are recreated and the pointers reset
+  const tarch::la::Vector<DIMENSIONS,int> pos1(0);
+  tarch::la::Vector<DIMENSIONS,int> pos2(0);
+  pos2[0] = 1;
+  solver.mergeNeighboursData(solverNumber,leftCellInfo,rightCellInfo,pos1,pos2);
+  validateEquals(left.getCompressionState(),CellDescription::Uncompressed);
+  validateEquals(right.getCompressionState(),CellDescription::Uncompressed);
+  for (CellDescription* cellDescription : {&left,&right}) {
+    validate(cellDescription->getPreviousSolution()==exahype::getDataHeapEntries(cellDescription->getPreviousSolutionIndex()).data());
+    validate(cellDescription->getSolution()==exahype::getDataHeapEntries(cellDescription->getSolutionIndex()).data());
+    validate(cellDescription->getUpdate()==exahype::getDataHeapEntries(cellDescription->getUpdateIndex()).data());
+    validateEquals(cellDescription->getSolutionCompressedIndex(),-1);
+    validateEquals(cellDescription->getPreviousSolutionCompressedIndex(),-1);
+  }
+  for (int i = 0; i < dataPerCell; i++) {
+    validateNumericalEqualsWithEpsWithParams1(static_cast<double*>(left.getSolution())[i],leftSolution[i],1e-6,i);
+    validateNumericalEqualsWithEpsWithParams1(static_cast<double*>(left.getPreviousSolution())[i],0.0,1e-6,i);
+    validateNumericalEqualsWithEpsWithParams1(static_cast<double*>(right.getSolution())[i],rightSolution[i],1e-6,i);
+    validateNumericalEqualsWithEpsWithParams1(static_cast<double*>(right.getPreviousSolution())[i],3.0,1e-6,i);
+  }
+
+  // compressing again replaces the previous averages
+  solver.compress(left,false);
+  validateNumericalEquals(static_cast<double*>(left.getSolutionAverages())[0],leftMean);
+  solver.uncompress(left);
+  validateEquals(left.getCompressionState(),CellDescription::Uncompressed);
+
+  // clean up
+  exahype::solvers::Solver::CompressionAccuracy             = compressionAccuracy;
+  exahype::solvers::Solver::SpawnCompressionAsBackgroundJob = spawnCompressionAsBackgroundJob;
+  exahype::solvers::RegisteredSolvers.pop_back();
+  exahype::DataHeap::getInstance().deleteAllData();
+  exahype::CompressedDataHeap::getInstance().deleteAllData();
+  ADERDGSolver::Heap::getInstance().deleteAllData();
+  exahype::solvers::FiniteVolumesSolver::Heap::getInstance().deleteAllData();
+}
+
+}  // namespace solvers
+}  // namespace tests
+}  // namespace exahype
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", on)
+#endif
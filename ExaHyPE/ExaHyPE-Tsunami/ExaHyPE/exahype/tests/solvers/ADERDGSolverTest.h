@@ -0,0 +1,74 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_ADERDG_SOLVER_TEST_H_
+#define _EXAHYPE_TESTS_ADERDG_SOLVER_TEST_H_
+
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace records {
+class ADERDGCellDescription;
+}  // namespace records
+
+namespace tests {
+namespace solvers {
+
+class ADERDGTestSolver;
+
+/**
+ * Tests the cell and face bookkeeping of ADERDGSolver on leaf cells of an
+ * ADERDGTestSolver: the time step refinement within a macro time step of the
+ * local time stepping, the accumulation of the fluctuations at an
+ * interface between cells with different time step sizes, the
+ * deactivation and reactivation of inert cells, and the compression of the
+ * cell arrays.
+ */
+class ADERDGSolverTest : public tarch::tests::TestCase {
+ public:
+  ADERDGSolverTest();
+  virtual ~ADERDGSolverTest();
+
+  void run() override;
+
+ private:
+  static tarch::logging::Log _log;
+
+  /**
+   * Add a leaf of @p solver at @p offsetX on the x axis to a new heap index.
+   * The solution is set to one; update and face data are zeroed.
+   *
+   * @return the cell descriptions index of the leaf.
+   */
+  int createLeaf(ADERDGTestSolver& solver,const int solverNumber,const double offsetX);
+
+  /**
+   * Surface integral of a cell whose neighbour merges have all been performed.
+   * Resets the face integrals recorded by @p solver first.
+   */
+  void integrateFaces(ADERDGTestSolver& solver,exahype::records::ADERDGCellDescription& cellDescription);
+
+  void testRefineLocalTimeStepSize();
+  void testAccumulatedFluctuations();
+  void testDetermineIfCellIsInert();
+  void testSkipFacesOfInactiveCells();
+  void testReactivation();
+  void testCompressionRoundTrip();
+};
+
+}  // namespace solvers
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_ADERDG_SOLVER_TEST_H_
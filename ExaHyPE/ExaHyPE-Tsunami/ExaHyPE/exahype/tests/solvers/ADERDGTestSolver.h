@@ -0,0 +1,216 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_ADERDG_TEST_SOLVER_H_
+#define _EXAHYPE_TESTS_ADERDG_TEST_SOLVER_H_
+
+#include <algorithm>
+
+#include "exahype/solvers/ADERDGSolver.h"
+
+namespace exahype {
+namespace tests {
+namespace solvers {
+
+/**
+ * ADER-DG solver with a single variable and trivial kernels, shared by the
+ * tests of the solver's cell and face bookkeeping.
+ *
+ * The predictor counts its calls and extrapolates the first solution value
+ * onto all faces. The Riemann solver writes the fixed fluctuations
+ * FluctuationLeft and FluctuationRight. The face integral records
+ * dt times the first integrated fluctuation per face in faceIntegrals.
+ */
+class ADERDGTestSolver : public exahype::solvers::ADERDGSolver {
+ public:
+  static constexpr int    NumberOfVariables = 1;
+  static constexpr int    Order             = 1;
+  static constexpr double FluctuationLeft   = 3.0;
+  static constexpr double FluctuationRight  = -2.0;
+
+  /** Result of the user hook isInert(...). */
+  bool   inert = false;
+  /** Number of predictor evaluations. */
+  int    predictions = 0;
+  /** dt times the first fluctuation per face, summed over all face integrals. */
+  double faceIntegrals[DIMENSIONS_TIMES_TWO];
+
+  explicit ADERDGTestSolver(const exahype::solvers::Solver::TimeStepping timeStepping) :
+    exahype::solvers::ADERDGSolver(
+        "ADERDGTestSolver",NumberOfVariables,0/*parameters*/,0/*global observables*/,Order+1,
+        1.0/*maximum mesh size*/,0/*maximum adaptive mesh depth*/,
+        0/*halo cells*/,0/*halo buffer cells*/,0/*limiter buffer cells*/,0/*regularised fine grid levels*/,
+        timeStepping,0/*DMP observables*/) {
+    std::fill_n(faceIntegrals,DIMENSIONS_TIMES_TWO,0.0);
+  }
+
+  bool isLinear() const override { return false; }
+  bool isUseViscousFlux() const override { return false; }
+
+  void init(const std::vector<std::string>& cmdlineargs,const exahype::parser::ParserView& constants) override {}
+
+  void addUpdateToSolution(double* const luh,const double* const luhOld,const double* const lduh,const double dt) override {
+    for (int i = 0; i < getUpdateSize(); i++) {
+      luh[i] = luhOld[i] + dt * lduh[i];
+    }
+  }
+
+  void faceIntegral(
+      double* const                                lduh,
+      double* const                                lFhbnd,
+      const int                                    direction,
+      const int                                    orientation,
+      const tarch::la::Vector<DIMENSIONS-1,int>&   subfaceIndex,
+      const int                                    levelDelta,
+      const tarch::la::Vector<DIMENSIONS, double>& cellSize,
+      const double                                 dt,
+      const bool                                   addToUpdate) override {
+    faceIntegrals[2*direction+orientation] += dt * lFhbnd[0];
+  }
+
+  void riemannSolver(
+      double* const        FL,
+      double* const        FR,
+      const double* const  QL,
+      const double* const  QR,
+      const double         t,
+      const double         dt,
+      const tarch::la::Vector<DIMENSIONS, double>& lengthScale,
+      const int            direction,
+      bool                 isBoundaryFace,
+      int                  faceIndex) override {
+    for (int i = 0; i < getBndFluxSize(); i++) {
+      FL[i] = FluctuationLeft;
+      FR[i] = FluctuationRight;
+    }
+  }
+
+  void boundaryConditions(
+      double* const                                fluxIn,
+      const double* const                          stateIn,
+      const double* const                          gradStateIn,
+      const double* const                          luh,
+      const tarch::la::Vector<DIMENSIONS, double>& cellCentre,
+      const tarch::la::Vector<DIMENSIONS,double>&  cellSize,
+      const double                                 t,
+      const double                                 dt,
+      const int                                    direction,
+      const int                                    orientation) override {}
+
+  int fusedSpaceTimePredictorVolumeIntegral(
+      double* const                                lduh,
+      double* const                                lQhbnd,
+      double*                                      lGradQhbnd,
+      double* const                                lFhbnd,
+      double* const                                luh,
+      const tarch::la::Vector<DIMENSIONS, double>& center,
+      const tarch::la::Vector<DIMENSIONS, double>& dx,
+      const double                                 t,
+      const double                                 dt,
+      const bool                                   addVolumeIntegralResultToUpdate,
+      double* const                                admissibleTimeStepSize) override {
+    predictions++;
+    std::fill_n(lduh,getUpdateSize(),0.0);
+    std::fill_n(lQhbnd,getBndTotalSize(),luh[0]);
+    std::fill_n(lFhbnd,getBndFluxTotalSize(),0.0);
+    return 1;
+  }
+
+  double stableTimeStepSize(const double* const luh,const tarch::la::Vector<DIMENSIONS, double>& dx) override {
+    return 1.0;
+  }
+
+  void adjustSolution(
+      double* const                                luh,
+      const tarch::la::Vector<DIMENSIONS, double>& cellCentre,
+      const tarch::la::Vector<DIMENSIONS, double>& dx,
+      const double                                 t,
+      const double                                 dtOld) override {}
+
+  exahype::solvers::Solver::RefinementControl refinementCriterion(
+      const double* const                          luh,
+      const tarch::la::Vector<DIMENSIONS, double>& cellCentre,
+      const tarch::la::Vector<DIMENSIONS, double>& cellSize,
+      const double                                 time,
+      const int                                    level) override {
+    return exahype::solvers::Solver::RefinementControl::Keep;
+  }
+
+  void faceUnknownsProlongation(
+      double* const                                 lQhbndFine,
+      double* const                                 lFhbndFine,
+      const double* const                           lQhbndCoarse,
+      const double* const                           lFhbndCoarse,
+      const int                                     coarseGridLevel,
+      const int                                     fineGridLevel,
+      const tarch::la::Vector<DIMENSIONS - 1, int>& subfaceIndex) override {}
+
+  void volumeUnknownsRestriction(
+      double* const                             luhCoarse,
+      const double* const                       luhFine,
+      const int                                 coarseGridLevel,
+      const int                                 fineGridLevel,
+      const tarch::la::Vector<DIMENSIONS, int>& subcellIndex) override {}
+
+  void volumeUnknownsProlongation(
+      double* const                             luhFine,
+      const double* const                       luhCoarse,
+      const int                                 coarseGridLevel,
+      const int                                 fineGridLevel,
+      const tarch::la::Vector<DIMENSIONS, int>& subcellIndex) override {}
+
+  bool isPhysicallyAdmissible(
+      const double* const                         solution,
+      const double* const                         localObservablesMin,
+      const double* const                         localObservablesMax,
+      const bool                                  wasTroubledInPreviousTimeStep,
+      const tarch::la::Vector<DIMENSIONS,double>& center,
+      const tarch::la::Vector<DIMENSIONS,double>& dx,
+      const double                                timeStamp) const override { return true; }
+
+  bool vetoDiscreteMaximumPrincipleDecision(
+      const double* const                         solution,
+      const double* const                         localObservablesMin,
+      const double* const                         localObservablesMax,
+      const bool                                  wasTroubledInPreviousTimeStep,
+      const tarch::la::Vector<DIMENSIONS,double>& center,
+      const tarch::la::Vector<DIMENSIONS,double>& dx,
+      const double                                timeStamp) const override { return false; }
+
+  void mapDiscreteMaximumPrincipleObservables(double* const observables,const double* const Q) const override {}
+
+  bool isInert(
+      const double* const                         luh,
+      const tarch::la::Vector<DIMENSIONS,double>& cellCentre,
+      const tarch::la::Vector<DIMENSIONS,double>& cellSize) override { return inert; }
+
+  void resetGlobalObservables(double* const globalObservables) override {}
+
+  void updateGlobalObservables(
+      double* const                               globalObservables,
+      const double* const                         luh,
+      const tarch::la::Vector<DIMENSIONS,double>& cellCentre,
+      const tarch::la::Vector<DIMENSIONS,double>& cellSize,
+      const double                                t,
+      const double                                dtOld) override {}
+
+  void mergeGlobalObservables(double* const globalObservables,const double* const otherObservables) override {}
+
+  void wrapUpGlobalObservables(double* const globalObservables) override {}
+};
+
+}  // namespace solvers
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_ADERDG_TEST_SOLVER_H_
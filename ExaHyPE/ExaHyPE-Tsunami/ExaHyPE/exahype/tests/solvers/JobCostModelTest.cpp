@@ -0,0 +1,165 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#include "exahype/tests/solvers/JobCostModelTest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "tarch/multicore/Jobs.h"
+#include "tarch/tests/TestCaseFactory.h"
+
+#include "exahype/solvers/Solver.h"
+
+#ifndef ALIGNMENT
+registerTest(exahype::tests::solvers::JobCostModelTest)
+#endif
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("", off)
+#endif
+
+tarch::logging::Log exahype::tests::solvers::JobCostModelTest::_log( "exahype::tests::solvers::JobCostModelTest" );
+
+namespace {
+
+typedef exahype::solvers::Solver::JobCostModel JobCostModel;
+
+std::atomic<int> ProcessedJobs(0);
+
+/**
+ * Counts itself in the enclave job counter on construction,
+ * as the solvers' jobs do.
+ */
+class CountingJob: public tarch::multicore::jobs::Job {
+  public:
+    CountingJob(const int priority):
+      tarch::multicore::jobs::Job(tarch::multicore::jobs::JobType::BackgroundTask,0,priority) {
+      exahype::solvers::Solver::NumberOfEnclaveJobs.fetch_add(1);
+    }
+
+    bool run(bool runOnMasterThread) override {
+      ProcessedJobs.fetch_add(1);
+      exahype::solvers::Solver::NumberOfEnclaveJobs.fetch_sub(1);
+      return false;
+    }
+};
+
+}  // namespace
+
+namespace exahype {
+namespace tests {
+namespace solvers {
+
+JobCostModelTest::JobCostModelTest()
+    : tarch::tests::TestCase("exahype::tests::solvers::JobCostModelTest") {}
+
+JobCostModelTest::~JobCostModelTest() {}
+
+void JobCostModelTest::run() {
+  testMethod(testExponentialMovingAverage);
+  testMethod(testBatchesAreSpawnedOnWaits);
+}
+
+void JobCostModelTest::testExponentialMovingAverage() {
+  logInfo("testExponentialMovingAverage()", "Test job cost model estimates");
+
+  validateEquals(JobCostModel::getCostClass(false,false),0);
+  validateEquals(JobCostModel::getCostClass(false,true), 1);
+  validateEquals(JobCostModel::getCostClass(true,false), 2);
+  validateEquals(JobCostModel::getCostClass(true,true),  3);
+
+  JobCostModel model;
+  for (int costClass = 0; costClass < JobCostModel::NumberOfCostClasses; costClass++) {
+    validateWithParams1(model.getEstimate(JobCostModel::JobKind::FusedTimeStep,costClass) < 0.0, costClass);
+    validateWithParams1(model.getEstimate(JobCostModel::JobKind::Update,costClass) < 0.0, costClass);
+  }
+
+  // the first measurement is taken as it is, later ones are blended in with weight 0.1
+  model.addMeasurement(JobCostModel::JobKind::Update,2,1e-3);
+  validateNumericalEqualsWithEps(model.getEstimate(JobCostModel::JobKind::Update,2),1e-3,1e-15);
+  model.addMeasurement(JobCostModel::JobKind::Update,2,2e-3);
+  validateNumericalEqualsWithEps(model.getEstimate(JobCostModel::JobKind::Update,2),1.1e-3,1e-15);
+  model.addMeasurement(JobCostModel::JobKind::Update,2,0.0);
+  validateNumericalEqualsWithEps(model.getEstimate(JobCostModel::JobKind::Update,2),0.99e-3,1e-15);
+
+  // other job kinds and cost classes are not affected
+  validate(model.getEstimate(JobCostModel::JobKind::FusedTimeStep,2) < 0.0);
+  validate(model.getEstimate(JobCostModel::JobKind::Update,3) < 0.0);
+
+  // seeding overwrites the estimate
+  model.seed(JobCostModel::JobKind::Update,2,5e-4);
+  validateNumericalEqualsWithEps(model.getEstimate(JobCostModel::JobKind::Update,2),5e-4,1e-15);
+
+  // the estimate converges to a constant run time
+  model.seed(JobCostModel::JobKind::FusedTimeStep,1,1.0);
+  for (int i = 0; i < 200; i++) {
+    model.addMeasurement(JobCostModel::JobKind::FusedTimeStep,1,2e-4);
+  }
+  validateNumericalEqualsWithEps(model.getEstimate(JobCostModel::JobKind::FusedTimeStep,1),2e-4,1e-9);
+
+  // concurrent measurements of the same run time must not corrupt the estimate
+  model.seed(JobCostModel::JobKind::FusedTimeStep,0,3e-4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&model] () -> void {
+      for (int i = 0; i < 1000; i++) {
+        model.addMeasurement(JobCostModel::JobKind::FusedTimeStep,0,3e-4);
+      }
+    }));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  validateNumericalEqualsWithEps(model.getEstimate(JobCostModel::JobKind::FusedTimeStep,0),3e-4,1e-15);
+}
+
+void JobCostModelTest::testBatchesAreSpawnedOnWaits() {
+  logInfo("testBatchesAreSpawnedOnWaits()", "Test batching of cheap jobs");
+
+  const bool   costAwareJobScheduling = exahype::solvers::Solver::CostAwareJobScheduling;
+  const double jobGrainTime           = exahype::solvers::Solver::JobGrainTime;
+  exahype::solvers::Solver::CostAwareJobScheduling = true;
+  exahype::solvers::Solver::JobGrainTime           = 1.0;
+  const int priority = tarch::multicore::DefaultPriority;
+  ProcessedJobs = 0;
+
+  // cheap jobs wait in the pending batch until it reaches the grain time
+  for (int i = 0; i < 3; i++) {
+    exahype::solvers::Solver::spawnOrBatchBackgroundJob(new CountingJob(priority),priority,0.3);
+  }
+  validateEqualsWithParams1(ProcessedJobs.load(),0,exahype::solvers::Solver::NumberOfEnclaveJobs.load());
+  exahype::solvers::Solver::spawnOrBatchBackgroundJob(new CountingJob(priority),priority,0.3); // spawns the batch of four
+
+  // expensive jobs and jobs without an estimate are not batched
+  exahype::solvers::Solver::spawnOrBatchBackgroundJob(new CountingJob(priority),priority,2.0);
+  exahype::solvers::Solver::spawnOrBatchBackgroundJob(new CountingJob(priority),priority,-1.0);
+
+  // these stay pending; batches of different priorities are kept apart
+  exahype::solvers::Solver::spawnOrBatchBackgroundJob(new CountingJob(priority),priority,0.1);
+  exahype::solvers::Solver::spawnOrBatchBackgroundJob(new CountingJob(priority-1),priority-1,0.1);
+  validateWithParams1(ProcessedJobs.load() <= 6,ProcessedJobs.load());
+
+  // the wait must spawn the pending batches, it would not terminate otherwise
+  exahype::solvers::Solver::ensureAllJobsHaveTerminated(exahype::solvers::Solver::JobType::EnclaveJob);
+  validateEquals(ProcessedJobs.load(),8);
+  validateEquals(exahype::solvers::Solver::NumberOfEnclaveJobs.load(),0);
+
+  exahype::solvers::Solver::CostAwareJobScheduling = costAwareJobScheduling;
+  exahype::solvers::Solver::JobGrainTime           = jobGrainTime;
+}
+
+}  // namespace solvers
+}  // namespace tests
+}  // namespace exahype
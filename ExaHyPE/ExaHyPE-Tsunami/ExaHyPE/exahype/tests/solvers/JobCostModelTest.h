@@ -0,0 +1,48 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+
+#ifndef _EXAHYPE_TESTS_JOB_COST_MODEL_TEST_H_
+#define _EXAHYPE_TESTS_JOB_COST_MODEL_TEST_H_
+
+#include "tarch/logging/Log.h"
+#include "tarch/tests/TestCase.h"
+
+namespace exahype {
+namespace tests {
+namespace solvers {
+
+/**
+ * Tests the exponential moving average of Solver::JobCostModel and the
+ * batching of cheap jobs by Solver::spawnOrBatchBackgroundJob(...):
+ * a batch is spawned once its estimated cost reaches the grain time, and
+ * pending batches are spawned when the solver waits for its jobs.
+ */
+class JobCostModelTest : public tarch::tests::TestCase {
+ public:
+  JobCostModelTest();
+  virtual ~JobCostModelTest();
+
+  void run() override;
+
+ private:
+  static tarch::logging::Log _log;
+
+  void testExponentialMovingAverage();
+  void testBatchesAreSpawnedOnWaits();
+};
+
+}  // namespace solvers
+}  // namespace tests
+}  // namespace exahype
+
+#endif  // _EXAHYPE_TESTS_JOB_COST_MODEL_TEST_H_
@@ -351,6 +351,70 @@ struct idx6 {
   const int I_, J_, K_, L_, M_, N_, size, line_;
 };
 
+/**
+ * Compile-time counterparts of idx2 ... idx5 for the kernels whose extents
+ * are known at compile time (all generic kernels take them from SolverType).
+ *
+ * The strides are constant expressions, so the offsets fold into the
+ * addressing of the loads and stores and the loops over the fastest index
+ * have literal trip counts the compiler can unroll and vectorise. The objects
+ * are empty; bounds are still checked in Asserts mode.
+ */
+template <int I, int J>
+struct cidx2 {
+  static constexpr int size = I*J;
+
+  int operator()(int i, int j) const {
+    assertion2(i < I, i, I);
+    assertion2(j < J, j, J);
+    return i * J + j;
+  }
+};
+
+template <int I, int J, int K>
+struct cidx3 {
+  static constexpr int size = I*J*K;
+
+  int operator()(int i, int j, int k) const {
+    assertion2(i < I, i, I);
+    assertion2(j < J, j, J);
+    assertion2(k < K, k, K);
+    return i * (J * K) + j * K + k;
+  }
+};
+
+template <int I, int J, int K, int L>
+struct cidx4 {
+  static constexpr int size = I*J*K*L;
+
+  int operator()(int i, int j, int k, int l) const {
+    assertion2(i < I, i, I);
+    assertion2(j < J, j, J);
+    assertion2(k < K, k, K);
+    assertion2(l < L, l, L);
+    return i * (J * K * L) + j * (K * L) + k * L + l;
+  }
+};
+
+template <int I, int J, int K, int L, int M>
+struct cidx5 {
+  static constexpr int size = I*J*K*L*M;
+
+  int operator()(int i, int j, int k, int l, int m) const {
+    assertion2(i < I, i, I);
+    assertion2(j < J, j, J);
+    assertion2(k < K, k, K);
+    assertion2(l < L, l, L);
+    assertion2(m < M, m, M);
+    return i * (J * K * L * M) + j * (K * L * M) + k * (L * M) + l * M + m;
+  }
+};
+
+template <int I, int J>                             constexpr int cidx2<I,J>::size;
+template <int I, int J, int K>                      constexpr int cidx3<I,J,K>::size;
+template <int I, int J, int K, int L>               constexpr int cidx4<I,J,K,L>::size;
+template <int I, int J, int K, int L, int M>        constexpr int cidx5<I,J,K,L,M>::size;
+
 }  // namespace kernels
 
 #endif  // _EXAHYPE_KERNELS_KERNEL_UTILS_H_
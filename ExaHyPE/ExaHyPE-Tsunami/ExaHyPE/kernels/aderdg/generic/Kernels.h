@@ -74,6 +74,16 @@ void spaceTimePredictorLinear(SolverType& solver,
     const tarch::la::Vector<DIMENSIONS, double>& invDx,
     const double dt);
 
+/**
+ * Nonlinear space-time predictor. The Picard iterations stop once the
+ * squared change of lQi drops below SolverType::PicardTolerance squared,
+ * or run exactly SolverType::MaxPicardIterations times with
+ * SolverType::UseMaxPicardIterations. With SolverType::UseTaylorInitialGuess
+ * (2D, no viscous flux), the iterations start from the first-order Taylor
+ * expansion of luh in time instead of from luh.
+ *
+ * @return the number of Picard iterations done.
+ */
 template <bool useSource, bool useFlux, bool useNCP, bool noTimeAveraging, typename SolverType>
 int spaceTimePredictorNonlinear(
     SolverType& solver,
@@ -83,6 +93,31 @@ int spaceTimePredictorNonlinear(
     const tarch::la::Vector<DIMENSIONS, double>& invDx,
     const double dt);
 
+template <typename SolverType>
+struct AoSoAPredictorScratch;
+
+/**
+ * Variant of spaceTimePredictorNonlinear (2D only) that runs the Picard loop on
+ * an AoSoA layout ([t][y][x][numberOfData padded to the SIMD width]) with the
+ * derivative and stiffness products done as small GEMMs. Fluxes and NCP are
+ * evaluated a row of nodes at a time; with useVectPDE the solver has to provide
+ * flux_vect and nonConservativeProduct_vect (SoA, see the optimised kernels).
+ * Viscous fluxes are not supported. Results are returned in the layouts of the
+ * scalar kernel.
+ *
+ * @param scratch zero-initialised working set of the calling thread, owned by the solver.
+ */
+template <bool useSource, bool useFlux, bool useNCP, bool useVectPDE, bool noTimeAveraging, typename SolverType>
+int spaceTimePredictorNonlinearAoSoA(
+    SolverType& solver, AoSoAPredictorScratch<SolverType>& scratch,
+    double* lQhbnd, double* lFhbnd,
+    double* lQi, double* lFi, double* lQhi, double* lFhi,
+    const double* const luh,
+    const tarch::la::Vector<DIMENSIONS, double>& cellCenter,
+    const tarch::la::Vector<DIMENSIONS, double>& invDx,
+    double t,
+    double dt);
+
 template <typename SolverType>
 void solutionUpdate(SolverType& solver, double* luh, const double* const luhOld, const double* const lduh, const double dt);
 
@@ -207,10 +242,30 @@ void boundaryConditions(
     const int faceIndex,
     const int direction);
 
-template <typename SolverType,bool useViscousFlux>
+/**
+ * With \p useVectPDE (2D, no viscous flux) the eigenvalues of a whole row of
+ * nodes are obtained by one call to
+ *
+ *   void eigenvalues_vect(const double* const* const Q, const int d, double* const* const lambda, const int s);
+ *
+ * with Q[data][node] and lambda[var][node], instead of one eigenvalues call
+ * per node.
+ */
+template <typename SolverType,bool useViscousFlux,bool useVectPDE=false>
 double stableTimeStepSize(SolverType& solver, const double* const luh,
                           const tarch::la::Vector<DIMENSIONS, double>& dx);
 
+/**
+ * Estimates a stable time step size from the space-time predictor \p lQi of
+ * the step just predicted: the CFL bound of stableTimeStepSize is taken over
+ * all (N+1)^(DIMENSIONS+1) space-time nodes. The predictor covers the whole
+ * time slab, so the result bounds the time step size it was computed with;
+ * the fused time stepping reruns the step if it does not.
+ */
+template <typename SolverType,bool useViscousFlux>
+double stableTimeStepSizeFromSpaceTimePredictor(SolverType& solver, const double* const lQi,
+                                                const tarch::la::Vector<DIMENSIONS, double>& dx);
+
 /**
  * \note We need to consider material parameters in
  * lQhbndFine and lQhbndCoarse.
@@ -287,6 +342,7 @@ void deltaDistribution(
 }  // namespace kernels
 
 #include "kernels/aderdg/generic/c/generalisedOsherSolomon.cpph"
+#include "kernels/aderdg/generic/c/stableTimeStepSizeFromSpaceTimePredictor.cpph"
 
 #if DIMENSIONS == 2
 #include "kernels/aderdg/generic/c/2d/boundaryConditions.cpph"
@@ -296,6 +352,7 @@ void deltaDistribution(
 #include "kernels/aderdg/generic/c/2d/solutionUpdate.cpph"
 #include "kernels/aderdg/generic/c/2d/spaceTimePredictorLinear.cpph"
 #include "kernels/aderdg/generic/c/2d/spaceTimePredictorNonlinear.cpph"
+#include "kernels/aderdg/generic/c/2d/spaceTimePredictorNonlinearAoSoA.cpph"
 #include "kernels/aderdg/generic/c/2d/stableTimeStepSize.cpph"
 #include "kernels/aderdg/generic/c/2d/deltaDistribution.cpph"
 #include "kernels/aderdg/generic/c/2d/faceIntegralLinear.cpph"
@@ -36,6 +36,16 @@ namespace c {
    *
    * @note robustDiagonalLimiting has no effect on the algorithm.
    *
+   * With @p useVectPDE (2D, no viscous flux) the Riemann problems are solved a
+   * row of faces at a time by the solver's batched Riemann solver
+   *
+   *   double riemannSolver_vect(double* const* const fL, double* const* const fR,
+   *       const double* const* const qL, const double* const* const qR,
+   *       const double* const cellSize, const int direction, const int s);
+   *
+   * which gets the s face states as qL[data][face], qR[data][face], writes
+   * fL[var][face], fR[var][face] and returns the largest wave speed of the batch.
+   *
    * @param solver     a user solver implementing the PDE kernels.
    * @param solution   the current (and then new) solution.
    * @param cellCentre the centre of the cell holding the FV subgrid.
@@ -48,7 +58,8 @@ namespace c {
     bool useSource, bool useNCP, bool useFlux, bool useViscousFlux,
     bool robustDiagonalLimiting, // not used in 1st order Godunov
     kernels::finitevolumes::commons::c::slope_limiter slope_limiter, // not used in 1st order Godunov
-    typename SolverType
+    typename SolverType,
+    bool useVectPDE=false
   >
   double solutionUpdate(
       SolverType&                                  solver,
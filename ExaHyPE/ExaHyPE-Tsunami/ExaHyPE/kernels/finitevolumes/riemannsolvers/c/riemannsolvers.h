@@ -14,6 +14,7 @@
 #define KERNELS_FINITEVOLUMES_RIEMANNSOLVERS_C_RIEMANNSOLVERS_H_
 
 #include "kernels/KernelUtils.h"
+#include "tarch/la/Scalar.h"
 #include <iomanip>
 #include <iostream>
 #include <algorithm> // copy_n
@@ -57,6 +58,51 @@ double generalisedOsherSolomon(
     const double* const qL,
     const double* const qR,
     const int           direction);
+
+/**
+ * Rusanov flux with hydrostatic reconstruction for the Shallow Water
+ * Equations with bathymetry. Unlike rusanov, this is well-balanced: a lake
+ * at rest (h+b constant, no velocity) produces no fluxes.
+ *
+ * The data must be ordered as (h, hu, hv, b) with the bathymetry b stored
+ * as a (constant) variable. Velocities are taken with the desingularised
+ * depth inverse sqrt(2) h / sqrt(h^4 + max(h,eps)^4) of Kurganov and
+ * Petrova. @p solver has to provide
+ *
+ *   double getGravity() const;
+ *   double getDryTolerance() const;  // eps
+ *
+ * The flux of b is zero. The bathymetry jump enters through the momentum
+ * fluxes, which is why fL and fR differ there.
+ *
+ * @return the largest wave speed |u_n| + c of both states.
+ */
+template <typename SolverType>
+double hydrostaticRusanov(
+    SolverType&         solver,
+    double* const       fL,
+    double* const       fR,
+    const double* const qL,
+    const double* const qR,
+    const int           direction);
+
+/**
+ * hydrostaticRusanov for @p s faces at once, with the face states given as
+ * qL[data][face], qR[data][face] and the fluxes written to fL[var][face],
+ * fR[var][face]. Yields exactly the same fluxes as hydrostaticRusanov,
+ * which is implemented on top of it.
+ *
+ * @return the largest wave speed of all @p s faces.
+ */
+template <typename SolverType>
+double hydrostaticRusanov_vect(
+    SolverType&                 solver,
+    double* const* const        fL,
+    double* const* const        fR,
+    const double* const* const  qL,
+    const double* const* const  qR,
+    const int                   direction,
+    const int                   s);
 } // namespace c
 } // namespace riemansolvers
 } // namespace finitevolumes
@@ -64,5 +110,6 @@ double generalisedOsherSolomon(
 
 #include "rusanov.cpph"
 #include "generalisedOsherSolomon.cpph"
+#include "hydrostaticRusanov.cpph"
 
 #endif /* KERNELS_FINITEVOLUMES_RIEMANNSOLVERS_C_RIEMANNSOLVERS_H_ */
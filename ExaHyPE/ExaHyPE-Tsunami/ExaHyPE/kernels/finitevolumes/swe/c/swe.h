@@ -0,0 +1,68 @@
+/**
+ * This file is part of the ExaHyPE project.
+ * Copyright (c) 2016  http://exahype.eu
+ * All rights reserved.
+ *
+ * The project has received funding from the European Union's Horizon
+ * 2020 research and innovation programme under grant agreement
+ * No 671698. For copyrights and licensing, please consult the webpage.
+ *
+ * Released under the BSD 3 Open Source License.
+ * For the full license text, see LICENSE.txt
+ **/
+#ifndef KERNELS_FINITEVOLUMES_C_SWE_H_
+#define KERNELS_FINITEVOLUMES_C_SWE_H_
+
+#include "tarch/la/Vector.h"
+
+#include "kernels/finitevolumes/commons/c/slope-limiters.h"
+
+#if DIMENSIONS != 2
+#error "The swe finite volumes scheme is only available in 2D."
+#endif
+
+namespace kernels {
+namespace finitevolumes {
+namespace swe {
+namespace c {
+
+  /**
+   * First-order Godunov scheme for the Shallow Water Equations which solves
+   * the Riemann problems with riemannsolvers::c::hydrostaticRusanov instead
+   * of the solver's riemannSolver. It is well-balanced and does not call
+   * into the user solver per face; see hydrostaticRusanov for the variable
+   * layout and the constants @p solver has to provide.
+   *
+   * Without @p useVectPDE, every face is solved on its own (reference mode).
+   * With @p useVectPDE, a whole row of x faces, then a whole row of y faces,
+   * is streamed through hydrostaticRusanov_vect. Both modes give exactly
+   * the same results.
+   *
+   * @note useNCP, useFlux, useViscousFlux, robustDiagonalLimiting and
+   * slope_limiter have no effect; the bathymetry enters through the Riemann
+   * solver.
+   *
+   * @return the admissible time step size obtained from the Riemann solves.
+   */
+  template <
+    bool useSource, bool useNCP, bool useFlux, bool useViscousFlux,
+    bool robustDiagonalLimiting,
+    kernels::finitevolumes::commons::c::slope_limiter slope_limiter,
+    typename SolverType,
+    bool useVectPDE=false
+  >
+  double solutionUpdate(
+      SolverType&                                  solver,
+      double* const                                solution,
+      const tarch::la::Vector<DIMENSIONS, double>& cellCentre,
+      const tarch::la::Vector<DIMENSIONS, double>& cellSize,
+      const double                                 t,
+      const double                                 dt);
+}  // namespace c
+}  // namespace swe
+}  // namespace finitevolumes
+}  // namespace kernels
+
+#include "kernels/finitevolumes/swe/c/2d/swe.cpph"
+
+#endif // KERNELS_FINITEVOLUMES_C_SWE_H_
@@ -42,6 +42,9 @@ namespace c {
  * Projects the ADERDG solution onto
  * the finite volumes limiter space.
  *
+ * The tensor-product operator is applied one dimension at a time (sum factorisation),
+ * which costs O(N^3) instead of O(N^4) operations in 2D and O(N^4) instead of O(N^6) in 3D.
+ *
  * \param[in] basisSize The size of the ADER-DG basis per coordinate axis (order+1).
  * \param[in] ghostLayerWidth The ghost layer width in cells of the finite volumes patch
  */
@@ -57,6 +60,8 @@ void projectOnFVLimiterSpace(
  * Projects the finite volumes limiter solution onto
  * the DG space.
  *
+ * Sum-factorised like projectOnFVLimiterSpace.
+ *
  * \param[in] basisSize The size of the ADER-DG basis per coordinate axis (order+1)
  * \param[in] ghostLayerWidth The ghost layer width in cells of the finite volumes patch.
  */
@@ -199,6 +204,8 @@ void compareWithADERDGSolutionAtFVSubcellCenters(
 /**
  * Compute the minimum and maximum values of a DG solution expressed with a Gauss Legendre basis
  * at the nodes of a Lobatto quadrature using the same number of support points (basisSize).
+ *
+ * The min and max arrays are only updated, they must be initialised by the caller.
  */
 template <int numberOfData, int basisSize>
 void computeMinimumAndMaximumValueAtGaussLobattoNodes(
@@ -207,6 +214,39 @@ void computeMinimumAndMaximumValueAtGaussLobattoNodes(
     double* const       minimumAtGaussLobattoNodes, 
     double* const       maximumAtGaussLobattoNodes);
 
+/**
+ * One sum-factorisation sweep. Contracts the axis of a strided tensor
+ * in[a][b][axis][inner] with the 1D operator op[inputSize*outputSize], stored
+ * as op[i*outputSize+o] like dg2fv, fv2dg and leg2lob, and writes out[a][b][o][inner].
+ *
+ * The innermost \p innerSize values must be contiguous in \p in and \p out,
+ * all other strides are free so that ghost layer padded patches can be read and written directly.
+ */
+template <int sizeA, int sizeB, int inputSize, int outputSize, int innerSize>
+void contractAxis(
+    const double* const in,
+    const int           inStrideA,
+    const int           inStrideB,
+    const int           inStrideAxis,
+    const double* const op,
+    double* const       out,
+    const int           outStrideA,
+    const int           outStrideB,
+    const int           outStrideAxis);
+
+/**
+ * Applies the same 1D operator along every dimension of an unpadded nodal tensor with
+ * \p numberOfData values per node, e.g. Legendre -> Lobatto or DG -> FV subcell centres.
+ *
+ * \param[in]  in  basisSize^DIMENSIONS*numberOfData values
+ * \param[out] out basisSizeOut^DIMENSIONS*numberOfData values
+ */
+template <int numberOfData, int basisSize, int basisSizeOut>
+void projectTensorProduct(
+    const double* const in,
+    const double (&op) [basisSize*basisSizeOut],
+    double* const out);
+
 } // namespace c
 } // namespace generic
 } // namespace limiter
@@ -61,8 +61,11 @@ class Configuration:
                   "skx"    : 8
                 }
 
-    # choose the BLAS library for the matmul: "None" (= C++ loops), "Libxsmm" or "Eigen"
+    # choose the BLAS library for the matmul: "None" (= C++ loops), "Libxsmm", "Eigen"
+    # or "Auto" (= "Libxsmm" if the gemm generator is available, "None" otherwise)
+    # Note: "None" and the "Auto" fallback only keep the build working, they are slower than the generic kernels
     matmulLib = "Libxsmm"
+    #matmulLib = "Auto"
     #matmulLib = "Eigen"
     #matmulLib = "None"
 
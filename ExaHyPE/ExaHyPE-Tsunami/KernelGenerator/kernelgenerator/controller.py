@@ -57,6 +57,19 @@ class Controller:
         
         self.commandLine = ArgumentParser.buildCommandLineFromConfig(args)
         
+        # "Auto" falls back to plain C++ loops if the libxsmm gemm generator is not available,
+        # "Libxsmm" requires it
+        matmulLib = Configuration.matmulLib
+        hasLibxsmmGemmGenerator = os.access(Configuration.pathToLibxsmmGemmGenerator, os.X_OK)
+        if matmulLib == "Auto":
+            matmulLib = "Libxsmm" if hasLibxsmmGemmGenerator else "None"
+            if matmulLib == "None":
+                print("KernelGenerator: libxsmm_gemm_generator not found, using C++ loops for the matmuls. The generated kernels will be slower than the generic ones.")
+        elif matmulLib == "Libxsmm" and not hasLibxsmmGemmGenerator:
+            raise ValueError("Cannot generate the kernels, libxsmm_gemm_generator not found at '"+Configuration.pathToLibxsmmGemmGenerator+"'. "
+                             "Build it with 'make generator' in a LIBXSMM clone (see KernelGenerator/README.md), "
+                             "or set matmulLib = \"Auto\" in configuration.py to accept the slower C++ loop gemms")
+        
         # Generate the base config from the args input
         self.config = {
             "kernelType"            : args["kernelType"],
@@ -66,8 +79,8 @@ class Controller:
             "codeNamespace"         : args["namespace"],
             "tempVarsOnStack"       : args["tempVarsOnStack"],
             "architecture"          : args["architecture"],
-            "useLibxsmm"            : Configuration.matmulLib == "Libxsmm",
-            "useEigen"              : Configuration.matmulLib == "Eigen",
+            "useLibxsmm"            : matmulLib == "Libxsmm",
+            "useEigen"              : matmulLib == "Eigen",
             "pathToLibxsmmGemmGenerator"  : Configuration.pathToLibxsmmGemmGenerator,
             "runtimeDebug"          : Configuration.runtimeDebug, #for debug
             "prefetchInputs"        : Configuration.prefetching in ["Inputs", "All"],
@@ -247,7 +260,7 @@ class Controller:
             self.runModel("surfaceIntegral",          surfaceIntegralModel.SurfaceIntegralModel(self.baseContext))
         
         if self.config["kernelType"] == "limiter":
-            self.runModel("limiter",                  limiterModel.LimiterModel(self.baseContext, self))
+            self.runModel("limiter",                  limiterModel.LimiterModel(self.baseContext))
         
         if self.config["kernelType"] == "fv":
             self.runModel("ghostLayerFilling",        fvGhostLayerFillingModel.FVGhostLayerFillingModel(self.baseContext))
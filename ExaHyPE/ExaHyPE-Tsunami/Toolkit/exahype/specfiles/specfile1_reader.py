@@ -127,7 +127,8 @@ class SpecFile1Reader():
             "helper_layers",\
             "thread_stack_size",\
             "scale_bounding_box_multiplier",\
-            "max_mesh_setup_iterations"\
+            "max_mesh_setup_iterations",\
+            "local_time_stepping_levels"\
         ]
         numbers=[\
             "end_time",\
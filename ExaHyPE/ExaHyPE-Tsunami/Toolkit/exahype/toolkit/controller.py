@@ -304,6 +304,8 @@ class Controller:
             if "aderdg_kernel" in solver:
                 useOptKernel = useOptKernel or solver["aderdg_kernel"]["implementation"]=="optimised"
                 useFortran   = useFortran or solver["aderdg_kernel"]["language"]=="Fortran"
+            if "limiter" in solver:
+                useOptKernel = useOptKernel or solver["limiter"].get("implementation","generic")=="optimised"
             if "fv_kernel" in solver:
                 useOptKernel = useOptKernel or solver["fv_kernel"]["implementation"]=="optimised"
                 useFortran   = useFortran or solver["fv_kernel"]["language"]=="Fortran"
@@ -98,9 +98,9 @@ class SolverController:
                 context["aderdgContext"] = self.processModelOutput(model.generateCode(), [], logger) #don't register context
                 if "kernelgeneratorContext" in context["aderdgContext"]:
                     context["kernelgeneratorContext"] = context["aderdgContext"]["kernelgeneratorContext"] #move kernelgencontext one up if it exists
-                    # Add missing, TODO JMG make cleaner
-                    context["basis"] = context["aderdgContext"]["basis"] 
-                    context["tempVarsOnStack"] = context["aderdgContext"]["tempVarsOnStack"]
+                # Add missing, required by an optimised limiter even if the ADER-DG kernel is generic, TODO JMG make cleaner
+                context["basis"] = context["aderdgContext"]["basis"] 
+                context["tempVarsOnStack"] = context["aderdgContext"]["tempVarsOnStack"]
                 model = solverModel.SolverModel(context)
                 solverContext = self.processModelOutput(model.generateCode(), solverContextsList, logger)
                 
@@ -207,8 +207,11 @@ class SolverController:
         context = {}
         context["implementation"]          = kernel.get("implementation","generic")
         context["useMaxPicardIterations"]  = kernel.get("space_time_predictor",{}).get("fix_picard_iterations",False)!=False
+        context["picardTolerance"]         = kernel.get("space_time_predictor",{}).get("picard_tolerance",1e-7)
+        context["useTaylorInitialGuess"]   = kernel.get("space_time_predictor",{}).get("initial_guess","trivial")=="taylor"
         context["tempVarsOnStack"]         = kernel.get("allocate_temporary_arrays","heap")=="stack" 
         context["patchwiseAdjust"]         = kernel.get("adjust_solution","pointwise")=="patchwise" 
+        context["usePredictorTimeStepSize"] = kernel.get("time_step_size","nodal")=="space_time_predictor"
         context["transformRiemannData"]    = kernel.get("transform_riemann_data",False)==True
         context["language"]                = kernel.get("language","C").lower()
         context["basis"]                   = kernel.get("basis","Legendre").lower()
@@ -224,13 +227,14 @@ class SolverController:
         context["predictorRecompute"]      = kernel.get("space_time_predictor",{}).get("predictor_recompute",False)
         context["useVectPDE"]              = kernel.get("space_time_predictor",{}).get("vectorise_terms",False)
         context["useAoSoA2"]               = kernel.get("space_time_predictor",{}).get("AoSoA2_layout",False)
+        context["useAoSoAPredictor"]       = kernel.get("space_time_predictor",{}).get("aosoa_layout",False)
         context.update(self.buildKernelTermsContext(kernel["terms"]))
         return context
 
 
     def buildFVKernelContext(self,kernel):
         context = {}
-        ghostLayerWidth = { "godunov" : 1, "musclhancock" : 2 }
+        ghostLayerWidth = { "godunov" : 1, "musclhancock" : 2, "swe" : 1 }
         context["finiteVolumesType"]           = kernel["scheme"].replace("robust","")
         context["ghostLayerWidth"]             = ghostLayerWidth[context["finiteVolumesType"]]
         context["useRobustDiagonalLimiting"] = ("robust" in kernel["scheme"])
@@ -240,6 +244,7 @@ class SolverController:
         context["implementation"]  = kernel.get("implementation","generic")
         context["tempVarsOnStack"] = kernel.get("allocate_temporary_arrays","heap")=="stack" 
         context["patchwiseAdjust"] = kernel.get("adjust_solution","pointwise")=="patchwise" 
+        context["useVectPDE"]      = kernel.get("vectorise_terms",False)
         context.update(self.buildKernelTermsContext(kernel["terms"]))
         return context
 
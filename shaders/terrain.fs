@@ -7,6 +7,7 @@ in vec2 TexCoord;
 // Textures
 uniform sampler2D terrain;
 uniform sampler2D waterHeightMap;
+uniform sampler2D waterHeightMapNext;
 uniform sampler2D waterJetMap;
 
 // Uniforms
@@ -16,6 +17,8 @@ uniform bool gradientColor;
 uniform bool grayscale;
 
 uniform float simulationScale;
+uniform float simulationScaleNext;
+uniform float simulationBlend; // fractional time between snapshot k and k+1
 uniform float simulationOffset;
 
 uniform bool useWaterTexture;
@@ -54,7 +57,9 @@ void main() {
         baseColor = vec4(colorMap[clamp(index, 0, 7)], 1.0);
     }
 
-    float waterCanvasValue = texture(waterHeightMap, TexCoord).r * simulationScale + simulationOffset;
+    float waterK = texture(waterHeightMap, TexCoord).r * simulationScale;
+    float waterNext = texture(waterHeightMapNext, TexCoord).r * simulationScaleNext;
+    float waterCanvasValue = mix(waterK, waterNext, simulationBlend) + simulationOffset;
     float offset = (corner0 - 0.001) * float(showSimulation);
     // float offset = 0.0;
 
@@ -0,0 +1,173 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <cmath>
+
+#include <opencv2/opencv.hpp>
+
+#include "ParallelRaster.hpp"
+#include "Reconstruction.hpp"
+
+// micro-benchmarks for the raster steps on the render thread, run with --benchmark
+
+double timeMs(const std::function<void()> &fn, int iterations) {
+    fn(); // warm up caches and the worker pool
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+double maxAbsDiff(const cv::Mat &a, const cv::Mat &b) {
+    cv::Mat diff;
+    cv::absdiff(a, b, diff);
+    double maxVal;
+    cv::minMaxLoc(diff.reshape(1), nullptr, &maxVal);
+    return maxVal;
+}
+
+void reportBenchmark(const std::string &name, double referenceMs, double candidateMs, double error) {
+    std::cout << std::left << std::setw(44) << name << std::right
+              << std::fixed << std::setprecision(3)
+              << std::setw(10) << referenceMs << " ms"
+              << std::setw(10) << candidateMs << " ms"
+              << std::setw(8) << std::setprecision(2) << referenceMs / candidateMs << "x"
+              << "   max |diff| " << std::scientific << std::setprecision(2) << error
+              << std::defaultfloat << std::endl;
+}
+
+// sparse cell-centre samples as produced by Simulation::advanceFrame
+cv::Mat sparseSimulationSamples(int width, int height, int spacing = 7) {
+    cv::RNG rng(42);
+    cv::Mat samples = cv::Mat::zeros(height, width, CV_32FC1);
+    for (int y = 0; y < height; y += spacing) {
+        for (int x = 0; x < width; x += spacing) {
+            samples.ptr<float>(y)[x] = rng.uniform(0.0f, 2.5f);
+        }
+    }
+    return samples;
+}
+
+// smooth water column with a steep wave front at x = width / 2 and a hump, the shape advanceFrame has to rebuild
+cv::Mat syntheticWaterHeight(int width, int height) {
+    cv::Mat field(height, width, CV_32FC1);
+    for (int y = 0; y < height; ++y) {
+        float *row = field.ptr<float>(y);
+        for (int x = 0; x < width; ++x) {
+            float front = 0.5f * (std::tanh((x - width * 0.5f) / 6.0f) + 1.0f);
+            float dx = x - width * 0.25f, dy = y - height * 0.5f;
+            float hump = std::exp(-(dx * dx + dy * dy) / (2.0f * 60.0f * 60.0f));
+            row[x] = 1.0f + 0.8f * front + 0.5f * hump;
+        }
+    }
+    return field;
+}
+
+double rmse(const cv::Mat &a, const cv::Mat &b) {
+    cv::Mat diff = a - b;
+    return std::sqrt(cv::mean(diff.mul(diff))[0]);
+}
+
+void reportFidelity(const std::string &name, const cv::Mat &truth, const cv::Mat &reconstruction) {
+    // band of +-4 samples around the wave front
+    int band = 28;
+    cv::Range front(truth.cols / 2 - band, truth.cols / 2 + band);
+    std::cout << "  " << std::left << std::setw(42) << name << std::right
+              << std::fixed << std::setprecision(4)
+              << "rmse " << rmse(truth, reconstruction)
+              << "   front rmse " << rmse(truth.colRange(front), reconstruction.colRange(front))
+              << "   max |diff| " << maxAbsDiff(truth, reconstruction)
+              << std::defaultfloat << std::endl;
+}
+
+// Simulation::advanceFrame scattered-to-grid step: 61x61 Gaussian + NORM_MINMAX vs push-pull
+void runReconstructionBenchmark(int iterations = 50, int spacing = 7) {
+    int width = 800, height = 600;
+    cv::Mat truth = syntheticWaterHeight(width, height);
+    cv::Mat samples = cv::Mat::zeros(height, width, CV_32FC1);
+    cv::Mat weights = cv::Mat::zeros(height, width, CV_32FC1);
+    for (int y = 0; y < height; y += spacing) {
+        for (int x = 0; x < width; x += spacing) {
+            samples.ptr<float>(y)[x] = truth.ptr<float>(y)[x];
+            weights.ptr<float>(y)[x] = 1.0f;
+        }
+    }
+    double maxDepth;
+    cv::minMaxLoc(samples, nullptr, &maxDepth);
+
+    // both produce a 0..1 texture that the terrain shader scales back by maxDepth
+    cv::Mat gaussian, pushPull;
+    double ref = timeMs([&]() {
+        parallelGaussianBlur(samples, gaussian, cv::Size(61, 61), 0);
+        cv::normalize(gaussian, gaussian, 0.0f, 1.0f, cv::NORM_MINMAX);
+    }, iterations);
+    double cand = timeMs([&]() {
+        pushPullReconstruct(samples, weights, pushPull);
+        pushPull *= 1.0 / maxDepth;
+    }, iterations);
+    gaussian *= maxDepth;
+    pushPull *= maxDepth;
+
+    reportBenchmark("reconstruction 800x600 (gauss vs push-pull)", ref, cand, maxAbsDiff(gaussian, pushPull));
+    reportFidelity("Gaussian 61x61 + NORM_MINMAX", truth, gaussian);
+    reportFidelity("push-pull", truth, pushPull);
+}
+
+void runRasterBenchmarks(int iterations = 50) {
+    std::cout << "-------------------------------------------" << std::endl;
+    std::cout << "Raster benchmarks (" << iterations << " iterations, " << cv::getNumThreads() << " threads)" << std::endl;
+    std::cout << std::left << std::setw(44) << "step" << std::right
+              << std::setw(13) << "current" << std::setw(13) << "parallel" << std::endl;
+
+    // Simulation::advanceFrame
+    cv::Mat samples = sparseSimulationSamples(800, 600);
+    cv::Mat reference, candidate;
+    double ref = timeMs([&]() { cv::GaussianBlur(samples, reference, cv::Size(61, 61), 0); }, iterations);
+    double par = timeMs([&]() { parallelGaussianBlur(samples, candidate, cv::Size(61, 61), 0); }, iterations);
+    reportBenchmark("GaussianBlur 61x61 800x600 32F", ref, par, maxAbsDiff(reference, candidate));
+
+    cv::normalize(reference, reference, 0.0f, 1.0f, cv::NORM_MINMAX);
+    cv::Mat colorReference, colorCandidate;
+    ref = timeMs([&]() {
+        cv::Mat normalizedMap = reference.clone();
+        cv::normalize(normalizedMap, normalizedMap, 0, 255, cv::NORM_MINMAX);
+        normalizedMap.convertTo(normalizedMap, CV_8U);
+        cv::applyColorMap(normalizedMap, colorReference, cv::COLORMAP_JET);
+    }, iterations);
+    par = timeMs([&]() { parallelNormalizedColorMap(reference, colorCandidate, cv::COLORMAP_JET); }, iterations);
+    reportBenchmark("normalize + JET 800x600", ref, par, maxAbsDiff(colorReference, colorCandidate));
+
+    // Difference::toggle at a typical sandbox ROI
+    cv::Mat terrain(480, 640, CV_8UC1), gray(480, 640, CV_8UC1);
+    cv::randu(terrain, 0, 255);
+    cv::randu(gray, 0, 255);
+    ref = timeMs([&]() {
+        cv::Mat diff;
+        cv::subtract(terrain, gray, diff, cv::noArray(), CV_32F);
+        cv::normalize(diff, diff, 0, 255, cv::NORM_MINMAX);
+        diff.convertTo(diff, CV_8UC1);
+        cv::applyColorMap(diff, colorReference, cv::COLORMAP_VIRIDIS);
+    }, iterations);
+    par = timeMs([&]() {
+        cv::Mat diff;
+        parallelSubtract(terrain, gray, diff);
+        parallelNormalizedColorMap(diff, colorCandidate, cv::COLORMAP_VIRIDIS);
+    }, iterations);
+    reportBenchmark("subtract + VIRIDIS 640x480", ref, par, maxAbsDiff(colorReference, colorCandidate));
+
+    // calculateSSIM, one of its five 11x11 blurs
+    cv::Mat depth;
+    terrain.convertTo(depth, CV_32F);
+    ref = timeMs([&]() { cv::GaussianBlur(depth, reference, cv::Size(11, 11), 1.5); }, iterations);
+    par = timeMs([&]() { parallelGaussianBlur(depth, candidate, cv::Size(11, 11), 1.5); }, iterations);
+    reportBenchmark("GaussianBlur 11x11 640x480 32F (SSIM)", ref, par, maxAbsDiff(reference, candidate));
+
+    runReconstructionBenchmark(iterations);
+}
+
+#endif // BENCHMARK_HPP
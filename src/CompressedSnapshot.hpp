@@ -0,0 +1,56 @@
+#ifndef COMPRESSED_SNAPSHOT_HPP
+#define COMPRESSED_SNAPSHOT_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "exahype/plotters/compressed/CompressedSnapshotReader.h"
+
+// reader for the solver's compressed cell snapshots (.exz, exahype::plotters::CompressedSnapshotWriter)
+// every quantity is quantised to round(v / (2 * errorBound)), delta + zigzag + varint coded in
+// independent chunks; the decoder is shared with the solver's tests, the chunks of all quantities
+// are decoded on OpenCV's worker pool
+
+struct CompressedSnapshot : exahype::plotters::compressedsnapshot::Snapshot {
+    float value(size_t cell, int quantity) const {
+        return static_cast<float>(values[cell * quantities + quantity]);
+    }
+
+    // cell centres in the order of the values, first coordinate fastest within a patch
+    std::vector<std::array<double, 3>> cellCentres() const {
+        std::vector<std::array<double, 3>> centres;
+        centres.reserve(cells);
+        for (size_t patch = 0; patch < cellsPerAxis.size(); ++patch) {
+            const double *offset = &patchGeometry[patch * 2 * dimensions];
+            const double *size = offset + dimensions;
+            const int n = cellsPerAxis[patch];
+            int patchCells = 1;
+            for (int d = 0; d < dimensions; ++d) patchCells *= n;
+            for (int cell = 0; cell < patchCells; ++cell) {
+                std::array<double, 3> centre{0.0, 0.0, 0.0};
+                int index = cell;
+                for (int d = 0; d < dimensions && d < 3; ++d) {
+                    centre[d] = offset[d] + (index % n + 0.5) * size[d] / n;
+                    index /= n;
+                }
+                centres.push_back(centre);
+            }
+        }
+        return centres;
+    }
+};
+
+// data: the bytes of one snapshot
+bool readCompressedSnapshot(const std::string &data, CompressedSnapshot &snapshot) {
+    return exahype::plotters::compressedsnapshot::readSnapshot(data, snapshot, [](int tasks, const auto &body) {
+        cv::parallel_for_(cv::Range(0, tasks), [&](const cv::Range &range) {
+            for (int task = range.start; task < range.end; ++task) body(task);
+        });
+    });
+}
+
+#endif // COMPRESSED_SNAPSHOT_HPP
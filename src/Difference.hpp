@@ -5,6 +5,7 @@
 #include <iostream>
 
 #include "Screen.hpp"
+#include "ParallelRaster.hpp"
 #include <opencv2/opencv.hpp>
 
 
@@ -50,11 +51,9 @@ public:
             update(gray);
         } else if (counter == 2) {
             cv::Mat diff;
-            cv::subtract(terrainDepth, gray, diff, cv::noArray(), CV_32F);
-            cv::normalize(diff, diff, 0, 255, cv::NORM_MINMAX);
-            diff.convertTo(diff, CV_8UC1);
+            parallelSubtract(terrainDepth, gray, diff);
             cv::Mat diffColor;
-            cv::applyColorMap(diff, diffColor, cv::COLORMAP_VIRIDIS);
+            parallelNormalizedColorMap(diff, diffColor, cv::COLORMAP_VIRIDIS);
 
             update(diffColor);
         }
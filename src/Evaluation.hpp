@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 
+#include "ParallelRaster.hpp"
+
 double calculatePSNR(const cv::Mat& original, const cv::Mat& processed) {
     cv::Mat diff;
     cv::absdiff(original, processed, diff);
@@ -31,21 +33,21 @@ double calculateSSIM(const cv::Mat& original, const cv::Mat& processed) {
     processed.convertTo(processedFloat, CV_32F);
 
     cv::Mat mu1, mu2;
-    cv::GaussianBlur(originalFloat, mu1, cv::Size(11, 11), 1.5);
-    cv::GaussianBlur(processedFloat, mu2, cv::Size(11, 11), 1.5);
+    parallelGaussianBlur(originalFloat, mu1, cv::Size(11, 11), 1.5);
+    parallelGaussianBlur(processedFloat, mu2, cv::Size(11, 11), 1.5);
 
     cv::Mat mu1Sq = mu1.mul(mu1);
     cv::Mat mu2Sq = mu2.mul(mu2);
     cv::Mat mu1Mu2 = mu1.mul(mu2);
 
     cv::Mat sigma1Sq, sigma2Sq, sigma12;
-    cv::GaussianBlur(originalFloat.mul(originalFloat), sigma1Sq, cv::Size(11, 11), 1.5);
+    parallelGaussianBlur(originalFloat.mul(originalFloat), sigma1Sq, cv::Size(11, 11), 1.5);
     sigma1Sq -= mu1Sq;
 
-    cv::GaussianBlur(processedFloat.mul(processedFloat), sigma2Sq, cv::Size(11, 11), 1.5);
+    parallelGaussianBlur(processedFloat.mul(processedFloat), sigma2Sq, cv::Size(11, 11), 1.5);
     sigma2Sq -= mu2Sq;
 
-    cv::GaussianBlur(originalFloat.mul(processedFloat), sigma12, cv::Size(11, 11), 1.5);
+    parallelGaussianBlur(originalFloat.mul(processedFloat), sigma12, cv::Size(11, 11), 1.5);
     sigma12 -= mu1Mu2;
 
     cv::Mat t1 = 2 * mu1Mu2 + C1;
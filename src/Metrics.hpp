@@ -0,0 +1,197 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// runtime instrumentation: ScopedTimer feeds per-thread latency histograms that are
+// summed on read for the HUD and the /metrics endpoint on Remote
+// each thread owns its block, so recording is a handful of relaxed atomic adds and never locks
+
+enum class Stage {
+    Frame,
+    Capture,
+    Filter,
+    Motion,
+    AdvanceFrame,
+    Draw,
+    Http,
+    Count
+};
+
+const char *STAGE_NAMES[] = {"frame", "capture", "filter", "motion", "advance_frame", "draw", "http"};
+
+// upper bucket bounds in milliseconds, last bucket is +Inf
+const double METRICS_BUCKETS_MS[] = {0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 16.7, 25.0, 50.0, 100.0, 250.0, 1000.0};
+constexpr int METRICS_BUCKETS = sizeof(METRICS_BUCKETS_MS) / sizeof(METRICS_BUCKETS_MS[0]) + 1;
+constexpr int METRICS_STAGES = static_cast<int>(Stage::Count);
+
+struct StageHistogram {
+    std::atomic<uint64_t> buckets[METRICS_BUCKETS] = {};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sumNs{0};
+};
+
+struct ThreadHistograms {
+    StageHistogram stages[METRICS_STAGES];
+};
+
+// plain copy of a histogram summed over all threads
+struct StageSnapshot {
+    uint64_t buckets[METRICS_BUCKETS] = {};
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+
+    StageSnapshot operator-(const StageSnapshot &older) const {
+        StageSnapshot delta;
+        for (int b = 0; b < METRICS_BUCKETS; ++b) delta.buckets[b] = buckets[b] - older.buckets[b];
+        delta.count = count - older.count;
+        delta.sumNs = sumNs - older.sumNs;
+        return delta;
+    }
+
+    double meanMs() const {
+        return count ? sumNs / 1e6 / count : 0.0;
+    }
+
+    // linear interpolation inside the bucket holding quantile q
+    double quantileMs(double q) const {
+        if (count == 0) return 0.0;
+        double rank = q * count;
+        uint64_t seen = 0;
+        for (int b = 0; b < METRICS_BUCKETS; ++b) {
+            if (buckets[b] == 0) continue;
+            if (seen + buckets[b] >= rank) {
+                double lower = b == 0 ? 0.0 : METRICS_BUCKETS_MS[b - 1];
+                if (b == METRICS_BUCKETS - 1) return lower;
+                double upper = METRICS_BUCKETS_MS[b];
+                return lower + (upper - lower) * (rank - seen) / buckets[b];
+            }
+            seen += buckets[b];
+        }
+        return METRICS_BUCKETS_MS[METRICS_BUCKETS - 2];
+    }
+};
+
+class Metrics {
+private:
+    std::mutex registryMutex; // only taken the first time a thread records
+    std::vector<std::unique_ptr<ThreadHistograms>> threads;
+
+    ThreadHistograms &local() {
+        thread_local ThreadHistograms *mine = nullptr;
+        if (!mine) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            threads.push_back(std::make_unique<ThreadHistograms>());
+            mine = threads.back().get();
+        }
+        return *mine;
+    }
+
+public:
+    void record(Stage stage, std::chrono::nanoseconds elapsed) {
+        StageHistogram &histogram = local().stages[static_cast<int>(stage)];
+        double ms = elapsed.count() / 1e6;
+        int bucket = 0;
+        while (bucket < METRICS_BUCKETS - 1 && ms > METRICS_BUCKETS_MS[bucket]) ++bucket;
+        histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        histogram.sumNs.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        histogram.count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    StageSnapshot snapshot(Stage stage) {
+        StageSnapshot total;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto &thread : threads) {
+            const StageHistogram &histogram = thread->stages[static_cast<int>(stage)];
+            for (int b = 0; b < METRICS_BUCKETS; ++b) total.buckets[b] += histogram.buckets[b].load(std::memory_order_relaxed);
+            total.count += histogram.count.load(std::memory_order_relaxed);
+            total.sumNs += histogram.sumNs.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Prometheus text exposition format (version 0.0.4)
+    std::string prometheus() {
+        std::stringstream out;
+        out << "# HELP sandbox_stage_duration_seconds Latency of main loop stages and HTTP handlers.\n";
+        out << "# TYPE sandbox_stage_duration_seconds histogram\n";
+        for (int s = 0; s < METRICS_STAGES; ++s) {
+            StageSnapshot snap = snapshot(static_cast<Stage>(s));
+            uint64_t cumulative = 0;
+            for (int b = 0; b < METRICS_BUCKETS; ++b) {
+                cumulative += snap.buckets[b];
+                out << "sandbox_stage_duration_seconds_bucket{stage=\"" << STAGE_NAMES[s] << "\",le=\"";
+                if (b == METRICS_BUCKETS - 1) out << "+Inf";
+                else out << METRICS_BUCKETS_MS[b] / 1000.0;
+                out << "\"} " << cumulative << "\n";
+            }
+            out << "sandbox_stage_duration_seconds_sum{stage=\"" << STAGE_NAMES[s] << "\"} " << snap.sumNs / 1e9 << "\n";
+            out << "sandbox_stage_duration_seconds_count{stage=\"" << STAGE_NAMES[s] << "\"} " << snap.count << "\n";
+        }
+        return out.str();
+    }
+};
+
+Metrics &metrics() {
+    static Metrics instance;
+    return instance;
+}
+
+class ScopedTimer {
+private:
+    Stage stage;
+    std::chrono::steady_clock::time_point start;
+    bool running = true;
+public:
+    ScopedTimer(Stage stage) : stage(stage), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        stop();
+    }
+    // records early, for stages that end before the enclosing scope does
+    void stop() {
+        if (!running) return;
+        running = false;
+        metrics().record(stage, std::chrono::steady_clock::now() - start);
+    }
+};
+
+// on-screen summary, refreshed twice a second from the difference to the previous snapshot
+class MetricsHUD {
+private:
+    StageSnapshot previous[METRICS_STAGES];
+    double lastUpdate = -1.0;
+    std::vector<std::string> lines;
+public:
+    const std::vector<std::string> &update(double currentTime) {
+        if (lastUpdate >= 0.0 && currentTime - lastUpdate < 0.5) return lines;
+        lastUpdate = currentTime;
+        lines.clear();
+        for (int s = 0; s < METRICS_STAGES; ++s) {
+            StageSnapshot current = metrics().snapshot(static_cast<Stage>(s));
+            StageSnapshot window = current - previous[s];
+            previous[s] = current;
+
+            std::stringstream line;
+            line << std::left << std::setw(14) << STAGE_NAMES[s] << std::right << std::fixed << std::setprecision(2)
+                 << " mean " << window.meanMs() << " ms"
+                 << "  p95 " << window.quantileMs(0.95) << " ms"
+                 << "  n " << window.count;
+            if (static_cast<Stage>(s) == Stage::Frame && window.meanMs() > 0.0) {
+                line << "  (" << std::setprecision(1) << 1000.0 / window.meanMs() << " fps)";
+            }
+            lines.push_back(line.str());
+        }
+        return lines;
+    }
+};
+
+#endif // METRICS_HPP
@@ -0,0 +1,59 @@
+#ifndef PARALLEL_RASTER_HPP
+#define PARALLEL_RASTER_HPP
+
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+
+// full-frame raster steps split into row stripes on OpenCV's shared worker pool (cv::parallel_for_)
+// stripes are ROIs of the parent Mat, so filters still read real neighbours across stripe edges
+// and the results match the single-threaded calls exactly
+
+#define RASTER_MIN_STRIPE_ROWS 32
+
+int rasterStripes(int rows) {
+    int stripes = std::max(1, cv::getNumThreads()) * 4;
+    return std::max(1, std::min(stripes, rows / RASTER_MIN_STRIPE_ROWS));
+}
+
+template <typename Body>
+void parallelRows(int rows, const Body &body) {
+    cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range &range) {
+        body(range);
+    }, rasterStripes(rows));
+}
+
+void parallelGaussianBlur(const cv::Mat &src, cv::Mat &dst, cv::Size ksize, double sigma) {
+    CV_Assert(src.data != dst.data);
+    dst.create(src.size(), src.type());
+    parallelRows(src.rows, [&](const cv::Range &range) {
+        cv::Mat out = dst.rowRange(range);
+        cv::GaussianBlur(src.rowRange(range), out, ksize, sigma);
+    });
+}
+
+// cv::normalize(NORM_MINMAX) to 0..255, CV_8U and a colormap in one striped pass
+void parallelNormalizedColorMap(const cv::Mat &src, cv::Mat &dst, int colormap) {
+    double minVal, maxVal;
+    cv::minMaxLoc(src, &minVal, &maxVal);
+    double scale = (maxVal > minVal) ? 255.0 / (maxVal - minVal) : 0.0;
+
+    dst.create(src.size(), CV_8UC3);
+    parallelRows(src.rows, [&](const cv::Range &range) {
+        cv::Mat normalized;
+        src.rowRange(range).convertTo(normalized, CV_8U, scale, -minVal * scale);
+        cv::Mat out = dst.rowRange(range);
+        cv::applyColorMap(normalized, out, colormap);
+    });
+}
+
+// a - b as CV_32F
+void parallelSubtract(const cv::Mat &a, const cv::Mat &b, cv::Mat &dst) {
+    CV_Assert(a.size() == b.size());
+    dst.create(a.size(), CV_32F);
+    parallelRows(a.rows, [&](const cv::Range &range) {
+        cv::Mat out = dst.rowRange(range);
+        cv::subtract(a.rowRange(range), b.rowRange(range), out, cv::noArray(), CV_32F);
+    });
+}
+
+#endif // PARALLEL_RASTER_HPP
@@ -0,0 +1,67 @@
+#ifndef RECONSTRUCTION_HPP
+#define RECONSTRUCTION_HPP
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+// scattered-to-grid reconstruction of the sparse simulation cell samples
+// push-pull pyramid (Gortler et al. 1996, "The Lumigraph"): weights are pushed down a
+// cv::pyrDown pyramid until every pixel is covered, then coarse values are pulled back up
+// only into the holes. Each level is linear in its pixel count so the total cost is O(n),
+// and known samples are reproduced exactly instead of being smeared like a wide Gaussian
+
+// premultiplied (value * weight, weight) pairs, weights saturate at 1
+void clampWeights(cv::Mat &values, cv::Mat &weights) {
+    for (int y = 0; y < weights.rows; ++y) {
+        float *v = values.ptr<float>(y);
+        float *w = weights.ptr<float>(y);
+        for (int x = 0; x < weights.cols; ++x) {
+            if (w[x] > 1.0f) {
+                v[x] /= w[x];
+                w[x] = 1.0f;
+            }
+        }
+    }
+}
+
+// values: sum of samples per pixel, weights: number of samples per pixel (both CV_32F)
+void pushPullReconstruct(const cv::Mat &values, const cv::Mat &weights, cv::Mat &dst) {
+    CV_Assert(values.type() == CV_32F && weights.type() == CV_32F && values.size() == weights.size());
+
+    std::vector<cv::Mat> V{values.clone()};
+    std::vector<cv::Mat> W{weights.clone()};
+    clampWeights(V[0], W[0]);
+
+    // push
+    while (V.back().cols > 1 && V.back().rows > 1) {
+        cv::Mat v, w;
+        cv::pyrDown(V.back(), v);
+        cv::pyrDown(W.back(), w);
+        // pyrDown averages, scale back to a sum over the 2x2 footprint
+        v *= 4.0f;
+        w *= 4.0f;
+        clampWeights(v, w);
+        V.push_back(v);
+        W.push_back(w);
+
+        double minWeight;
+        cv::minMaxLoc(w, &minWeight, nullptr);
+        if (minWeight > 0.0) break; // no holes left at this level
+    }
+
+    // pull
+    for (int level = static_cast<int>(V.size()) - 2; level >= 0; --level) {
+        cv::Mat upV, upW;
+        cv::pyrUp(V[level + 1], upV, V[level].size());
+        cv::pyrUp(W[level + 1], upW, W[level].size());
+
+        cv::Mat hole = 1.0f - W[level];
+        V[level] += hole.mul(upV);
+        W[level] += hole.mul(upW);
+    }
+
+    // divide() writes 0 where no sample reached at all
+    cv::divide(V[0], W[0], dst);
+}
+
+#endif // RECONSTRUCTION_HPP
@@ -9,6 +9,7 @@
 #include <httplib.h>
 
 #include "Window.hpp"
+#include "Metrics.hpp"
 
 class Remote {
     private:
@@ -20,6 +21,7 @@ class Remote {
         httplib::Server svr;
 
         svr.Get("/", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received GET request on /" << std::endl;
             std::ifstream file("../remote/remote.html");
@@ -33,42 +35,49 @@ class Remote {
             }
         });
         svr.Post("/toggle-greyscale", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /toggle-greyscale" << std::endl;
             state->visualisation->toggleGrayscale();
             res.set_content("Greyscale toggled", "text/plain");
         });
         svr.Post("/toggle-gradient", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /toggle-gradient" << std::endl;
             state->visualisation->toggleGradientColor();
             res.set_content("Gradient toggled", "text/plain");
         });
         svr.Post("/toggle-pause", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /toggle-pause" << std::endl;
             state->visualisation->togglePause();
             res.set_content("Pause toggled", "text/plain");
         });
         svr.Post("/increment-contour", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /increment-contour" << std::endl;
             state->visualisation->incrementContourLineFactor();
             res.set_content("Contour incremented", "text/plain");
         });
         svr.Post("/decrement-contour", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /decrement-contour" << std::endl;
             state->visualisation->decrementContourLineFactor();
             res.set_content("Contour decremented", "text/plain");
         });
         svr.Post("/reset-contour", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /reset-contour" << std::endl;
             state->visualisation->resetContourLineFactor();
             res.set_content("Contour reset", "text/plain");
         });
         svr.Post("/zero-contour", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /zero-contour" << std::endl;
             state->visualisation->setContourLineFactor(0.0f);
@@ -76,6 +85,7 @@ class Remote {
         });
 
         svr.Post("/save-image", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /save-image" << std::endl;
             state->visualisation->saveImage("image.png");
@@ -83,12 +93,14 @@ class Remote {
         });
 
         svr.Post("/toggle-water", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /toggle-water" << std::endl;
             state->visualisation->toggleWaterTexture();
             res.set_content("Water texture toggled", "text/plain");
         });
         svr.Post("/toggle-field", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /toggle-field" << std::endl;
             state->simulation->toggleField();
@@ -96,6 +108,7 @@ class Remote {
         });
 
         svr.Post("/load-sequence", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /load-sequence" << std::endl;
             state->simulation->loadSequencePaths();
@@ -103,6 +116,7 @@ class Remote {
         });
 
         svr.Post("/increase-water-canvas", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /increase-water-canvas" << std::endl;
             state->waterCanvas->increase();
@@ -110,6 +124,7 @@ class Remote {
         });
 
         svr.Post("/decrease-water-canvas", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /decrease-water-canvas" << std::endl;
             state->waterCanvas->decrease();
@@ -117,6 +132,7 @@ class Remote {
         });
 
         svr.Post("/clear-water-canvas", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /clear-water-canvas" << std::endl;
             state->waterCanvas->clear();
@@ -124,6 +140,7 @@ class Remote {
         });
 
         svr.Post("/next-colormap", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /next-colormap" << std::endl;
             state->visualisation->colorMapIndex = (state->visualisation->colorMapIndex + 1) % COLOR_MAPS.size();
@@ -131,6 +148,7 @@ class Remote {
         });
 
         svr.Get("/terrain", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received GET request on /terrain" << std::endl;
             std::vector<uchar> buffer;
@@ -138,6 +156,7 @@ class Remote {
             res.set_content(reinterpret_cast<const char*>(buffer.data()), buffer.size(), "image/png");
         });
         svr.Get("/water", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received GET request on /water" << std::endl;
             std::vector<uchar> buffer;
@@ -149,6 +168,7 @@ class Remote {
             res.set_content(reinterpret_cast<const char*>(buffer.data()), buffer.size(), "image/png");
         });
         svr.Get("/vis-terrain", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received GET request on /vis-terrain" << std::endl;
             std::vector<uchar> buffer;
@@ -157,6 +177,7 @@ class Remote {
         });
 
         svr.Post("/reset-simulation", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "Received POST request on /reset-simulation" << std::endl;
             state->simulation->reset();
@@ -164,6 +185,7 @@ class Remote {
             res.set_content("Simulation reset", "text/plain");
         });
         svr.Post("/run-simulation", [this](const httplib::Request&, httplib::Response& res) {
+            ScopedTimer timer(Stage::Http);
             std::lock_guard<std::mutex> lock(serverMutex);
             std::cout << "--------------------------" << std::endl;
             std::cout << "Running Simulation" << std::endl;
@@ -175,6 +197,11 @@ class Remote {
             res.set_content("Simulation run", "text/plain");
         });
 
+        // no serverMutex, the histograms are read without stopping the render loop
+        svr.Get("/metrics", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content(metrics().prometheus(), "text/plain; version=0.0.4");
+        });
+
         std::cout << "-------------------------" << std::endl;
         std::cout << "Starting server on 127.0.0.1:18080" << std::endl;
         svr.listen("localhost", 18080);
@@ -7,10 +7,15 @@
 #include <filesystem>
 #include <vector>
 #include <numeric>
+#include <algorithm>
+#include <cmath>
 #include <chrono>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <sstream>
+#include <cctype>
+#include <cstdlib>
 
 #include <opencv2/opencv.hpp>
 #include <glad/glad.h>
@@ -29,11 +34,21 @@
 #include <vtkCellData.h>
 #include <vtkDataArray.h>
 
+#include "ParallelRaster.hpp"
+#include "Reconstruction.hpp"
+#include "CompressedSnapshot.hpp"
+
 #define SIMULATION_WIDTH 800
 #define SIMULATION_HEIGHT 600
 
 namespace fs = std::filesystem;
 
+struct SequenceFile {
+    fs::path path;
+    double time = 0.0;
+    std::uintmax_t bytes = 0; // size of the snapshot file, 0 -> unknown
+};
+
 class Simulation {
 private:
 fs::path inputPath;
@@ -42,15 +57,22 @@ std::string host;
 
 std::thread simulationThread;
 std::mutex sequenceMutex;
-std::vector<fs::path> sequencePaths;
+std::vector<SequenceFile> sequenceFiles;
 std::vector<cv::Mat> frames;
 std::vector<cv::Mat> textureFrames;
 std::vector<float> maxDepthValues;
 
 bool first = true;
 std::vector<std::pair<int, int>> normalizedCoordinates;
+// number of cell centres per pixel, fixed once normalizedCoordinates is known
+cv::Mat sampleWeights;
 bool field = false;
 
+// playback clock, in snapshots, decoupled from the render loop
+double playbackTime = 0.0;
+int uploadedFrame = -1;
+int uploadedNextFrame = -1;
+
 public:
     double simStartTime = 0.0;
     double pastOffset = 0.0;
@@ -58,6 +80,13 @@ public:
     GLuint texture = 0;
     std::atomic<bool> isRunning;
 
+    // snapshot k+1 and the fractional time between k and k+1 for the shader blend
+    GLuint nextTexture = 0;
+    float frameBlend = 0.0f;
+    float nextMaxValue = 0.0f;
+    float playbackRate = 12.5f; // snapshots per second
+    std::string indexName = "vtk-sandbox-rank-0.index";
+
     Simulation(std::string inPath, std::string outPath, std::string hostAddress = "http://localhost:4242") 
         : inputPath(inPath), outputPath(outPath), host(hostAddress),
         isRunning(false) {}
@@ -71,7 +100,7 @@ public:
 
     cv::Mat *getCurrentTexture() {
         std::lock_guard<std::mutex> lock(sequenceMutex);
-        if (currentFrame - 1 >= sequencePaths.size()) {
+        if (currentFrame - 1 >= textureFrames.size()) {
             return nullptr;
         }
         return &textureFrames[currentFrame - 1];
@@ -79,39 +108,85 @@ public:
 
     cv::Mat *getCurrentFrame() {
         std::lock_guard<std::mutex> lock(sequenceMutex);
-        if (currentFrame - 1 >= sequencePaths.size()) {
+        if (currentFrame - 1 >= frames.size()) {
             return nullptr;
         }
         return &frames[currentFrame - 1];
     }
 
-    std::vector<fs::path> getSequencePaths(const std::string &path) {
+    // frame number from "<prefix>-<frame>-rank-<r>" (or a trailing number), -1 if none
+    static long frameNumber(const std::string &stem) {
+        size_t end = stem.rfind("-rank-");
+        if (end == std::string::npos) end = stem.size();
+        size_t begin = end;
+        while (begin > 0 && std::isdigit(static_cast<unsigned char>(stem[begin - 1]))) --begin;
+        if (begin == end) return -1;
+        return std::strtol(stem.c_str() + begin, nullptr, 10);
+    }
+
+    // manifest written by the solver plotter: "frame time file bytes" per line
+    std::vector<SequenceFile> readSequenceIndex(const fs::path &indexPath) {
+        std::vector<SequenceFile> files;
+        std::ifstream index(indexPath);
+        std::string line;
+        while (std::getline(index, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream row(line);
+            long frame;
+            SequenceFile file;
+            std::string name;
+            if (!(row >> frame >> file.time >> name >> file.bytes)) {
+                std::cerr << "Malformed index line: " << line << std::endl;
+                continue;
+            }
+            file.path = indexPath.parent_path() / name;
+            files.push_back(file);
+        }
+        return files;
+    }
+
+    std::vector<SequenceFile> getSequenceFiles(const std::string &path) {
         fs::path dir(path);
         if (!fs::exists(dir) || !fs::is_directory(dir)) {
             std::cerr << "Invalid directory path: " << path << std::endl;
+            return {};
+        }
+
+        fs::path indexPath = dir / indexName;
+        if (fs::exists(indexPath)) {
+            return readSequenceIndex(indexPath);
         }
-    
-        std::vector<fs::path> files;
+
+        // no manifest (older solver output): list the directory, parse each frame number once
+        std::vector<std::pair<long, fs::path>> numbered;
         for (const auto &entry : fs::directory_iterator(dir)) {
-            if (entry.is_regular_file() && entry.path().extension() == ".vtk") {
-                files.push_back(entry.path());
+            const auto extension = entry.path().extension();
+            if (entry.is_regular_file() && (extension == ".vtk" || extension == ".exz")) {
+                numbered.emplace_back(frameNumber(entry.path().stem().string()), entry.path());
             }
         }
-    
-        std::sort(files.begin(), files.end(), [](const fs::path& a, const fs::path& b) {
-            std::string numA = a.stem().string().substr(12, a.stem().string().length() - 12 - 7);
-            std::string numB = b.stem().string().substr(12, b.stem().string().length() - 12 - 7);
-            return std::stoi(numA) < std::stoi(numB);
+        std::sort(numbered.begin(), numbered.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
         });
-    
+
+        std::vector<SequenceFile> files;
+        files.reserve(numbered.size());
+        for (const auto &[frame, file] : numbered) {
+            files.push_back({file, static_cast<double>(frame), 0});
+        }
         return files;
     }
 
     void reset() {
         currentFrame = 0;
+        playbackTime = 0.0;
+        uploadedFrame = -1;
+        uploadedNextFrame = -1;
+        frameBlend = 0.0f;
         frames.clear();
         normalizedCoordinates.clear();
-        sequencePaths.clear();
+        sampleWeights.release();
+        sequenceFiles.clear();
         maxDepthValues.clear();
         textureFrames.clear();
         first = true;
@@ -141,8 +216,8 @@ public:
                 std::cout << std::endl;
 
                 std::lock_guard<std::mutex> lock(sequenceMutex);
-                sequencePaths = getSequencePaths(inputPath.string());
-                std::cout << "Found " << sequencePaths.size() << " sequence files." << std::endl;
+                sequenceFiles = getSequenceFiles(inputPath.string());
+                std::cout << "Found " << sequenceFiles.size() << " sequence files." << std::endl;
             } catch (const std::exception& e) {
                 std::cerr << "An error occurred during simulation: " << e.what() << std::endl;
             }
@@ -154,56 +229,94 @@ public:
     void loadSequencePaths() {
         reset();
         std::lock_guard<std::mutex> lock(sequenceMutex);
-        sequencePaths = getSequencePaths(inputPath.string());
-        std::cout << "Found " << sequencePaths.size() << " sequence files." << std::endl;
+        sequenceFiles = getSequenceFiles(inputPath.string());
+        std::cout << "Found " << sequenceFiles.size() << " sequence files." << std::endl;
     }
 
     unsigned int frameCount() {
         std::lock_guard<std::mutex> lock(sequenceMutex);
-        return sequencePaths.size();
+        return sequenceFiles.size();
     }
 
-    void advanceFrame(float &maxValue) {
+    void advanceFrame(float &maxValue, double deltaTime = 0.0) {
         std::lock_guard<std::mutex> lock(sequenceMutex);
-        if (sequencePaths.empty()) {
+        if (sequenceFiles.empty()) {
             // std::cerr << "No sequence paths available." << std::endl;
             return;
         }
-        fs::path nextPath = sequencePaths[currentFrame++];
-        if (currentFrame >= sequencePaths.size()) {
-            currentFrame = 0;
-        }
-        // std::cout << "Loading frame: " << nextPath.stem().string() << std::endl;
 
-        if (frames.size() == sequencePaths.size()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(80));
-            maxValue = maxDepthValues[currentFrame];
-            toGL(frames[currentFrame]);
+        // all snapshots cached -> blend between k and k+1 at display rate. The
+        // last snapshot is held (not blended into the first) before playback
+        // loops back to the start of the sequence.
+        if (frames.size() == sequenceFiles.size()) {
+            const int count = static_cast<int>(frames.size());
+            playbackTime = std::fmod(playbackTime + deltaTime * playbackRate, static_cast<double>(count));
+            int k = static_cast<int>(playbackTime);
+            int next = std::min(k + 1, count - 1);
+            frameBlend = next == k ? 0.0f : static_cast<float>(playbackTime - k);
+
+            if (k != uploadedFrame) {
+                toGL(frames[k], texture);
+                uploadedFrame = k;
+            }
+            if (next != uploadedNextFrame) {
+                toGL(frames[next], nextTexture);
+                uploadedNextFrame = next;
+            }
+            currentFrame = k + 1;
+            maxValue = maxDepthValues[k];
+            nextMaxValue = maxDepthValues[next];
             return;
         }
 
+        const SequenceFile &next = sequenceFiles[frames.size()];
+        // std::cout << "Loading frame: " << next.path.stem().string() << std::endl;
 
-        vtkSmartPointer<vtkUnstructuredGridReader> reader = vtkSmartPointer<vtkUnstructuredGridReader>::New();
-        reader->ReadAllScalarsOn();
-        reader->SetFileName(nextPath.string().c_str());
-        reader->Update();
+        // compressed snapshots (.exz) carry the patch geometry instead of a VTK grid
+        const bool compressed = next.path.extension() == ".exz";
 
-        vtkSmartPointer<vtkUnstructuredGrid> ugrid = reader->GetOutput();
-        if (!ugrid) {
-            std::cerr << "Failed to read the VTK file." << std::endl;
-            return;
+        std::string snapshot;
+        if (compressed) {
+            std::ifstream file(next.path, std::ios::binary);
+            const std::uintmax_t bytes = next.bytes > 0 ? next.bytes : fs::file_size(next.path);
+            snapshot.resize(bytes);
+            file.read(snapshot.data(), static_cast<std::streamsize>(bytes));
         }
 
-        vtkDataArray* scalarQ = ugrid->GetCellData()->GetArray("Q");
-        if (!scalarQ) {
-            std::cerr << "Scalar array 'Q' not found!" << std::endl;
-            return;
-        }
+        CompressedSnapshot cells;
+        vtkSmartPointer<vtkUnstructuredGrid> ugrid;
+        vtkDataArray* scalarQ = nullptr;
+        if (compressed) {
+            if (!readCompressedSnapshot(snapshot, cells) || cells.quantities < 3) {
+                std::cerr << "Failed to read the compressed snapshot " << next.path << std::endl;
+                return;
+            }
+            if (!first && static_cast<size_t>(cells.cells) < normalizedCoordinates.size()) {
+                std::cerr << "Compressed snapshot " << next.path << " has fewer cells than the first one." << std::endl;
+                return;
+            }
+        } else {
+            vtkSmartPointer<vtkUnstructuredGridReader> reader = vtkSmartPointer<vtkUnstructuredGridReader>::New();
+            reader->ReadAllScalarsOn();
+            reader->SetFileName(next.path.string().c_str());
+            reader->Update();
+
+            ugrid = reader->GetOutput();
+            if (!ugrid) {
+                std::cerr << "Failed to read the VTK file." << std::endl;
+                return;
+            }
 
-    
-        // int numTuples = scalarQ->GetNumberOfTuples();
-        int numCells = ugrid->GetNumberOfCells();
-        // int numComponents = scalarQ->GetNumberOfComponents();
+            scalarQ = ugrid->GetCellData()->GetArray("Q");
+            if (!scalarQ) {
+                std::cerr << "Scalar array 'Q' not found!" << std::endl;
+                return;
+            }
+        }
+        // component c of the conserved variables of cell i
+        auto Q = [&](size_t i, int c) {
+            return compressed ? cells.value(i, c) : static_cast<float>(scalarQ->GetComponent(i, c));
+        };
 
         if(first) {
             double minX = std::numeric_limits<double>::max();
@@ -213,6 +326,17 @@ public:
 
             vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
 
+            if (compressed) {
+                for (const auto &centre : cells.cellCentres()) {
+                    minX = std::min(minX, centre[0]);
+                    minY = std::min(minY, centre[1]);
+                    maxX = std::max(maxX, centre[0]);
+                    maxY = std::max(maxY, centre[1]);
+                    points->InsertNextPoint(centre[0], centre[1], centre[2]);
+                }
+            }
+
+            const int numCells = ugrid ? ugrid->GetNumberOfCells() : 0;
             for (int i = 0; i < numCells; ++i) {
                 vtkCell* cell = ugrid->GetCell(i);
                 if (!cell) continue;
@@ -252,6 +376,12 @@ public:
             }
 
             // std::cout << "Bounding box: (" << minX << ", " << minY << ") to (" << maxX << ", " << maxY << ")" << std::endl;
+            sampleWeights = cv::Mat::zeros(SIMULATION_HEIGHT, SIMULATION_WIDTH, CV_32FC1);
+            for (const auto& [x, y] : normalizedCoordinates) {
+                if (x >= 0 && x < SIMULATION_WIDTH && y >= 0 && y < SIMULATION_HEIGHT) {
+                    sampleWeights.ptr<float>(y)[x] += 1.0f;
+                }
+            }
             first = false;
         }
 
@@ -262,36 +392,41 @@ public:
         // }
 
         //  .at<>() ===== error checking
+        // cells sharing a pixel are summed, sampleWeights holds how many
         cv::Mat depthMap = cv::Mat::zeros(SIMULATION_HEIGHT, SIMULATION_WIDTH, CV_32FC1);
+        double minDepth = std::numeric_limits<double>::max();
+        double maxDepth = std::numeric_limits<double>::lowest();
         for (size_t i = 0; i < normalizedCoordinates.size(); ++i) {
-            // const auto& [x, y] = normalizedCoordinates[i];
-            // depthMap.ptr<float>(y)[x] = static_cast<float>(scalarQ->GetComponent(i, 0));
             const auto& [x, y] = normalizedCoordinates[i];
             if (x >= 0 && x < SIMULATION_WIDTH && y >= 0 && y < SIMULATION_HEIGHT) {
-                depthMap.ptr<float>(y)[x] = static_cast<float>(scalarQ->GetComponent(i, 0));
+                float depth = Q(i, 0);
+                depthMap.ptr<float>(y)[x] += depth;
+                minDepth = std::min(minDepth, static_cast<double>(depth));
+                maxDepth = std::max(maxDepth, static_cast<double>(depth));
             }
         }
+        if (minDepth > maxDepth) minDepth = maxDepth = 0.0;
 
-        double minDepth, maxDepth;
-        cv::minMaxLoc(depthMap, &minDepth, &maxDepth);
         std::cout << "Depth Map - Min: " << minDepth << ", Max: " << maxDepth << std::endl;
         maxDepthValues.push_back(maxDepth);
         maxValue = maxDepth;
+        nextMaxValue = maxDepth;
+        frameBlend = 0.0f;
 
-        // heavy gaussian for complete image
+        // push-pull fill of the gaps between cell centres, stored as a fraction of maxDepth
+        // (replaces the 61x61 Gaussian + NORM_MINMAX, which was slower and smeared the wave front)
         cv::Mat interpolatedMap;
-        cv::GaussianBlur(depthMap, interpolatedMap, cv::Size(61, 61), 0);
-        cv::normalize(interpolatedMap, interpolatedMap, 0.0f, 1.0f, cv::NORM_MINMAX);
+        pushPullReconstruct(depthMap, sampleWeights, interpolatedMap);
+        if (maxDepth > 0.0) interpolatedMap *= 1.0 / maxDepth;
+        // parallelGaussianBlur(depthMap, interpolatedMap, cv::Size(61, 61), 0);
+        // cv::normalize(interpolatedMap, interpolatedMap, 0.0f, 1.0f, cv::NORM_MINMAX);
         // cv::imshow("INMAP", interpolatedMap);
         // cv::waitKey(1);
         // cv::GaussianBlur(depthMap, interpolatedMap, cv::Size(5, 5), 0);
 
         // norm
         cv::Mat colorMap;
-        cv::Mat normalizedMap = interpolatedMap.clone();
-        cv::normalize(normalizedMap, normalizedMap, 0, 255, cv::NORM_MINMAX);
-        normalizedMap.convertTo(normalizedMap, CV_8U);
-        cv::applyColorMap(normalizedMap, colorMap, cv::COLORMAP_JET);
+        parallelNormalizedColorMap(interpolatedMap, colorMap, cv::COLORMAP_JET);
 
         if (field) {
             colorMap.setTo(cv::Scalar(255, 255, 255));
@@ -299,8 +434,8 @@ public:
         
         for (size_t i = 0; i < normalizedCoordinates.size(); i += 20) {
             const auto& [x, y] = normalizedCoordinates[i];
-            float xMag = static_cast<float>(scalarQ->GetComponent(i, 1));
-            float yMag = static_cast<float>(scalarQ->GetComponent(i, 2));
+            float xMag = Q(i, 1);
+            float yMag = Q(i, 2);
 
             float direction = atan2(yMag, xMag);
             float magnitude = sqrt(xMag * xMag + yMag * yMag) * 200;
@@ -332,19 +467,21 @@ public:
         // }
 
         frames.push_back(interpolatedMap);
-        toGL(interpolatedMap);
+        toGL(interpolatedMap, texture);
+        uploadedFrame = -1;
+        currentFrame = frames.size();
 
         // frames.push_back(colorMap);
         // toGL(colorMap);
         // cv::imshow("Depth Map", colorMap);
         // cv::waitKey(1);
     }
-    void toGL(const cv::Mat& frame)
+    void toGL(const cv::Mat& frame, GLuint &target)
     {
-        if (texture == 0) {
-            glGenTextures(1, &texture);
+        if (target == 0) {
+            glGenTextures(1, &target);
         }
-        glBindTexture(GL_TEXTURE_2D, texture);
+        glBindTexture(GL_TEXTURE_2D, target);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
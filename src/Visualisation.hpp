@@ -39,11 +39,12 @@ public:
     bool paused;
 
     float simulationScale;
+    float simulationScaleNext;
     float simulationOffset;
 
     Visualisation() : terrainTexture(-1), VAO(-1), VBO(-1), shaderProgram(-1),
                       contourLineFactor(14.0f), useGradientColor(true), useGrayscale(false),
-                      simulationScale(1.0f), simulationOffset(0.0f), paused(false) {
+                      simulationScale(1.0f), simulationScaleNext(1.0f), simulationOffset(0.0f), paused(false) {
 
         // compile shaders
         unsigned int vertexShader = compileShaderFromFile(GL_VERTEX_SHADER, "../shaders/terrain.vs");
@@ -116,7 +117,8 @@ public:
         useWaterTexture = !useWaterTexture;
     }
 
-    void draw(GLuint simulationHeightMap = 0, cv::Mat *waterMap = nullptr, bool showSimulation = false) {
+    void draw(GLuint simulationHeightMap = 0, cv::Mat *waterMap = nullptr, bool showSimulation = false,
+              GLuint simulationHeightMapNext = 0, float simulationBlend = 0.0f) {
         // GLenum error = glGetError();
         // if (error != GL_NO_ERROR) {
         //     std::cerr << "OpenGL Error: " << error << std::endl;
@@ -136,6 +138,11 @@ public:
         glBindTexture(GL_TEXTURE_2D, simulationHeightMap);
         glUniform1i(glGetUniformLocation(shaderProgram, "waterHeightMap"), 1);
 
+        // snapshot k+1, falls back to k when there is nothing to blend towards
+        glActiveTexture(GL_TEXTURE3);
+        glBindTexture(GL_TEXTURE_2D, simulationHeightMapNext != 0 ? simulationHeightMapNext : simulationHeightMap);
+        glUniform1i(glGetUniformLocation(shaderProgram, "waterHeightMapNext"), 3);
+
         glActiveTexture(GL_TEXTURE2);
         glBindTexture(GL_TEXTURE_2D, waterTexture);
         glUniform1i(glGetUniformLocation(shaderProgram, "waterJetMap"), 2);
@@ -159,6 +166,8 @@ public:
         glUniform1i(glGetUniformLocation(shaderProgram, "grayscale"), useGrayscale);
 
         glUniform1f(glGetUniformLocation(shaderProgram, "simulationScale"), simulationScale);
+        glUniform1f(glGetUniformLocation(shaderProgram, "simulationScaleNext"), simulationScaleNext);
+        glUniform1f(glGetUniformLocation(shaderProgram, "simulationBlend"), simulationBlend);
         glUniform1f(glGetUniformLocation(shaderProgram, "simulationOffset"), simulationOffset);
 
         glUniform1i(glGetUniformLocation(shaderProgram, "useWaterTexture"), useWaterTexture);
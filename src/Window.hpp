@@ -28,6 +28,7 @@ struct WindowState {
     bool enableFilter = true;
     bool saveNext = false;
     bool shiftPressed = false;
+    bool showMetrics = false;
 
     std::vector<cv::Point> markers;
 
@@ -233,6 +234,10 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
         state->saveNext = true;
         std::cout << "Save next frame" << std::endl;
     }
+    if (key == GLFW_KEY_K && action == GLFW_PRESS) {
+        state->showMetrics = !state->showMetrics;
+        std::cout << "Metrics HUD: " << (state->showMetrics ? "ON" : "OFF") << std::endl;
+    }
     if (key == GLFW_KEY_Z && action == GLFW_PRESS) {
         state->differenceCanvas->toggle(state->visualisation->terrainImage);
     }
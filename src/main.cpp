@@ -47,6 +47,8 @@ Code Resources & Sources:
 #include "Camera.hpp"
 #include "Remote.hpp"
 #include "Evaluation.hpp"
+#include "Benchmark.hpp"
+#include "Metrics.hpp"
 
 
 // #define ENABLE_EVALUATION 1
@@ -81,6 +83,8 @@ int main(int argc, char **argv) try
     std::vector<cv::Point> points;
     bool fullscreen = false;
     bool shouldCalibrate = false;
+    bool benchmark = false;
+    bool hud = false;
     std::string host = "http://localhost:4242";
     // std::string simulationInputPath = "/Users/macauley/Development/T/output2";
     std::string simulationInputPath = "/Users/macauley/Development/T/out";
@@ -90,6 +94,7 @@ int main(int argc, char **argv) try
 
     float temporalAlpha = 0.1f;
     float temporalDelta = 60.0f;
+    float playbackRate = 12.5f;
 
     // parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -145,6 +150,10 @@ int main(int argc, char **argv) try
             }
         } else if (arg == "--calibrate") {
             shouldCalibrate = true;
+        } else if (arg == "--benchmark") {
+            benchmark = true;
+        } else if (arg == "--hud") {
+            hud = true;
         } else if (arg == "--diff") {
             if (i + 1 < argc) {
                 diffPath = argv[++i];
@@ -163,12 +172,23 @@ int main(int argc, char **argv) try
             } else {
             throw std::invalid_argument("No value specified after --temporalDelta");
             }
+        } else if (arg == "--playbackRate") {
+            if (i + 1 < argc) {
+                playbackRate = std::stof(argv[++i]);
+            } else {
+                throw std::invalid_argument("No value specified after --playbackRate");
+            }
         } else {
             throw std::invalid_argument("Unknown argument: " + arg);
         }
     }
     bool imageMode = !imageInputPath.empty();
 
+    if (benchmark) {
+        runRasterBenchmarks();
+        return 0;
+    }
+
     // https://github.com/UM-Bridge/umbridge/blob/main/clients/c%2B%2B/http-client.cpp
     // std::cout << "Connecting to host " << host << std::endl;
 
@@ -188,6 +208,7 @@ int main(int argc, char **argv) try
     // std::cout << std::endl;
 
     Simulation sim(simulationInputPath, simulationOutputPath, host);
+    sim.playbackRate = playbackRate;
 
     Camera camera(bagFile);
 
@@ -314,6 +335,7 @@ int main(int argc, char **argv) try
     windowState.visualisation = &vis;
     windowState.simulation = &sim;
     windowState.waterCanvas = &water;
+    windowState.showMetrics = hud;
     glfwSetWindowUserPointer(window, &windowState);
     glfwSetKeyCallback(window, key_callback);
     glfwSetMouseButtonCallback(window, mouse_button_callback);
@@ -366,6 +388,7 @@ int main(int argc, char **argv) try
 
 
     Evaluation eval;
+    MetricsHUD metricsHUD;
 
     // Main loop
     double lastTime = glfwGetTime();
@@ -389,6 +412,7 @@ int main(int argc, char **argv) try
     camera.warmUp();
     std::cout << "Before loop" << std::endl;
     while (!glfwWindowShouldClose(window)) {
+        ScopedTimer frameTimer(Stage::Frame);
         double currentTime = glfwGetTime();
         deltaTime = currentTime - lastTime;
         lastTime = currentTime;
@@ -401,11 +425,13 @@ int main(int argc, char **argv) try
         bool motionDetected = false;
         if (camera.pipe.poll_for_frames(&frames)) {
             // auto start = std::chrono::high_resolution_clock::now();
+            ScopedTimer captureTimer(Stage::Capture);
             camera.playing = true;
 
             rs2::frame colorFrame = frames.get_color_frame();
             rs2::frame depthFrame = frames.get_depth_frame();
             rs2::frame depthColorized = camera.colorMap.colorize(depthFrame);
+            captureTimer.stop();
 
             if (glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS) {
                 std::cout << "Setting ground truth..." << std::endl;
@@ -419,6 +445,7 @@ int main(int argc, char **argv) try
 
             // filters
             if(windowState.enableFilter) {
+                ScopedTimer filterTimer(Stage::Filter);
                 // depthFrame = spatial_filter.process(depthFrame);
                 depthFrame = temporal_filter.process(depthFrame);
                 depthFrame = hole_filling.process(depthFrame);
@@ -489,6 +516,7 @@ int main(int argc, char **argv) try
             }
             
             if (!prev.empty()) {
+                ScopedTimer motionTimer(Stage::Motion);
                 cv::Mat diff;
                 cv::absdiff(normalizedDepthMat, prev, diff);
                 cv::Mat threshDiff;
@@ -506,6 +534,7 @@ int main(int argc, char **argv) try
                     // std::cout << "Motion detected: " << motion << " pixels" << std::endl;
                     lastMotionTime = currentTime;
                 }
+                motionTimer.stop();
 
                 if (windowState.debugWindows) {
                     cv::Mat jet;
@@ -553,7 +582,10 @@ int main(int argc, char **argv) try
         //     lastTextureUpdateTime = currentTime;
         // }
         float simMaxValue = 0.0;
-        sim.advanceFrame(simMaxValue);
+        {
+            ScopedTimer advanceTimer(Stage::AdvanceFrame);
+            sim.advanceFrame(simMaxValue, deltaTime);
+        }
 
         // if (water.maxValue > 1.0f) {
         //     vis.simulationScale = water.maxValue / 2.55f;
@@ -565,9 +597,14 @@ int main(int argc, char **argv) try
 
         bool simOrWater = sim.frameCount() == 0;
         vis.simulationScale = simOrWater ? 2.55 : simMaxValue;
+        vis.simulationScaleNext = simOrWater ? 2.55 : sim.nextMaxValue;
+        ScopedTimer drawTimer(Stage::Draw);
         vis.draw((simOrWater) ? water.texture : sim.texture, 
                  (simOrWater) ? &water.waterTextureMat : sim.getCurrentTexture(),
-                 !simOrWater);
+                 !simOrWater,
+                 (simOrWater) ? 0 : sim.nextTexture,
+                 (simOrWater) ? 0.0f : sim.frameBlend);
+        drawTimer.stop();
 
         
         if(windowState.markers.size() == 2 && !simOrWater) {
@@ -625,6 +662,15 @@ int main(int argc, char **argv) try
 
         textRenderer.renderText(statusText.str(), 10.0f, 10.0f, 0.25f, glm::vec3(1.0f, 1.0f, 1.0f));
 
+        if (windowState.showMetrics) {
+            const std::vector<std::string> &lines = metricsHUD.update(currentTime);
+            float y = windowHeight - 20.0f;
+            for (const std::string &line : lines) {
+                textRenderer.renderText(line, 10.0f, y, 0.25f, glm::vec3(1.0f, 1.0f, 1.0f));
+                y -= 14.0f;
+            }
+        }
+
         if (sim.isRunning) {
             glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT);